@@ -1,7 +1,16 @@
 #include "Prerequisites.h"
 #include "BaseApp.h"
+// The global new/delete hook is only compiled into tracking builds (Debug):
+// it cannot free blocks allocated by another module's allocator, such as
+// the shared FBX SDK
+#if defined(EU_TRACK_GLOBAL_NEW)
+#include "EngineUtilities\Memory\MemoryTrackerNew.h"
+#endif
 
 // Global Variables
+// Constructed before app and destroyed after it, so the report written at
+// exit only lists memory nobody released
+EU::MemoryReportAtExit memoryReport("memory_report.txt");
 BaseApp app;
 
 // Called every time the application receives a message
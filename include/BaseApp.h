@@ -17,6 +17,7 @@
 #include "UserInterface.h"
 #include "ModelLoader.h"
 #include "ECS\Actor.h"
+#include "ECS\SystemScheduler.h"
 
 class
     BaseApp {
@@ -77,8 +78,18 @@ private:
     CBChangeOnResize cbChangesOnResize;
     UserInterface m_userInterface;
 
+    // Componentes de todos los actores; declarado antes que ellos para que
+    // se destruya después.
+    World m_world;
+
+    // Sistemas del World (Transform, ...), en paralelo según lo que leen y escriben.
+    SystemScheduler m_scheduler{ m_world };
+    // Cambios del World pedidos desde fuera de los sistemas (UI, importación);
+    // se aplican en update, en el mismo punto de sincronización que los del scheduler.
+    CommandBuffer m_commands;
+
     // Se eliminó el puntero específico al Actor de la pistola.
     EU::TSharedPointer<Actor> m_APlane;
-    // Este vector contendrá todos los actores, incluyendo los importados.
-    std::vector<EU::TSharedPointer<Actor>> m_actors;
+    // Todos los actores, incluyendo los importados; la UI los referencia por handle.
+    ActorMap m_actors;
 };
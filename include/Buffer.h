@@ -47,7 +47,7 @@ public:
                  D3D11_SUBRESOURCE_DATA* initData);
 
 private:
-    ID3D11Buffer* m_buffer = nullptr;
+    EU::TRefPtr<ID3D11Buffer> m_buffer;
     unsigned int m_stride = 0;
     unsigned int m_offset = 0;
     unsigned int m_bindFlag = 0;
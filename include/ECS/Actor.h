@@ -4,14 +4,17 @@
 #include "Buffer.h"
 #include "Texture.h"
 #include "Transform.h"
+#include "TransformHierarchy.h"
 #include "SamplerState.h"
 #include "Rasterizer.h"
 #include "BlendState.h"
 #include "ShaderProgram.h"
 #include "DepthStencilState.h"
+#include "EngineUtilities\Structures\TArray.h"
 
 class device;
 class MeshComponent;
+struct ModelNode;
 
 class 
 Actor : public Entity {
@@ -24,8 +27,9 @@ public:
   /**
    * @brief Constructor que inicializa el actor con un dispositivo.
    * @param device El dispositivo con el cual se inicializa el actor.
+   * @param world Mundo donde se guardan los componentes del actor.
    */
-  Actor(Device& device);
+  Actor(Device& device, World& world);
 
   /**
    * @brief Destructor virtual.
@@ -59,12 +63,50 @@ public:
 
   /**
    * @brief Establece las mallas del actor.
+   *
+   * Cada malla se dibuja con la matriz de su nodo (MeshComponent::m_nodeIndex)
+   * por encima del Transform del actor; las que no tienen nodo cuelgan del
+   * nodo raíz, o solo del Transform si el actor no tiene jerarquía. Si se usa
+   * setNodes, debe llamarse antes.
    * @param device El dispositivo con el cual se inicializan las mallas.
    * @param meshes Vector de componentes de malla que se van a establecer.
    */
   void
   setMesh(Device& device, std::vector<MeshComponent> meshes);
 
+  /**
+   * @brief Reconstruye la jerarquía del modelo: un nodo raíz (identidad) y,
+   *        bajo él, los nodos importados con su transformación local.
+   * @param nodes Nodos del modelo, con los padres antes que los hijos.
+   */
+  void
+  setNodes(const std::vector<ModelNode>& nodes);
+
+  /**
+   * @brief Jerarquía del modelo, en el espacio del actor.
+   */
+  TransformHierarchy&
+  getHierarchy() {
+    return m_hierarchy;
+  }
+
+  /**
+   * @brief Nodo raíz creado por setNodes (nulo si no hay jerarquía). Sirve
+   *        para normalizar el modelo sin tocar sus vértices.
+   */
+  TransformNodeId
+  getRootNode() const {
+    return m_rootNode;
+  }
+
+  /**
+   * @brief Nodo con el que se dibuja la malla meshIndex (nulo si ninguno).
+   */
+  TransformNodeId
+  getMeshNode(size_t meshIndex) const {
+    return m_meshNodes[meshIndex];
+  }
+
   std::string
   getName() { 
     return m_name; 
@@ -81,7 +123,11 @@ public:
    */
   void
   setTextures(std::vector<Texture> textures) {
-    m_textures = textures;
+    m_textures.Empty();
+    m_textures.Reserve(textures.size());
+    for (Texture& texture : textures) {
+      m_textures.Add(std::move(texture));
+    }
   }
 
   void 
@@ -98,24 +144,66 @@ public:
   renderShadow(DeviceContext& deviceContext);
 
 private:
-  std::vector<MeshComponent> m_meshes;  ///< Vector de componentes de malla.
-  std::vector<Texture> m_textures;      ///< Vector de texturas.
-  std::vector<Buffer> m_vertexBuffers;  ///< Buffers de vértices.
-  std::vector<Buffer> m_indexBuffers;   ///< Buffers de índices.
+  /**
+   * @brief Matriz de la malla en el espacio del actor (la de su nodo, o la
+   *        identidad si no tiene).
+   */
+  const EU::Matrix4x4&
+  getMeshMatrix(size_t meshIndex) const;
+
+  /**
+   * @brief Combina la versión del nodo de la malla con la del Transform: si
+   *        no cambió, el constant buffer de la malla sigue siendo válido.
+   */
+  uint64_t
+  getMeshVersion(size_t meshIndex, const Transform& transform) const;
+
+  /**
+   * @brief Matriz que aplasta el actor sobre el suelo desde la luz (solo con
+   *        el yaw del Transform).
+   */
+  EU::Matrix4x4
+  computeShadowMatrix(const Transform& t) const;
+
+  /**
+   * @brief Mallas que caben dentro del actor sin reservar memoria: la
+   *        mayoría de los modelos tienen pocas, y las listas por malla de
+   *        abajo solo van al heap si el modelo tiene más.
+   */
+  static constexpr size_t INLINE_MESHES = 4;
+
+  template<typename T>
+  using PerMesh = EU::TInlineArray<T, INLINE_MESHES>;
+
+  PerMesh<MeshComponent> m_meshes;      ///< Componentes de malla.
+  PerMesh<Texture> m_textures;          ///< Texturas (una por malla).
+  PerMesh<Buffer> m_vertexBuffers;      ///< Buffers de vértices.
+  PerMesh<Buffer> m_indexBuffers;       ///< Buffers de índices.
   BlendState m_blendstate;
   Rasterizer m_rasterizer;
   SamplerState m_sampler;
   CBChangesEveryFrame m_model;          ///< Constante del buffer para cambios en cada frame.
-  Buffer m_modelBuffer;                 ///< Buffer del modelo.
+  PerMesh<Buffer> m_modelBuffers;       ///< Buffer del modelo de cada malla.
+  PerMesh<uint64_t> m_modelVersions;    ///< Versiones subidas a cada m_modelBuffers.
+
+  // Jerarquía del modelo
+  TransformHierarchy m_hierarchy;
+  TransformNodeId m_rootNode;                 ///< Raíz creada por setNodes.
+  std::vector<TransformNodeId> m_nodes;       ///< Nodo de cada ModelNode.
+  PerMesh<TransformNodeId> m_meshNodes;       ///< Nodo de cada malla.
 
   // Shadows
   ShaderProgram m_shaderShadow;
-  Buffer m_shaderBuffer;
+  PerMesh<Buffer> m_shadowBuffers;      ///< Buffer de sombra de cada malla.
   BlendState m_shadowBlendState;
   DepthStencilState m_shadowDepthStencilState;
   CBChangesEveryFrame m_cbShadow;
+  PerMesh<uint64_t> m_shadowVersions;   ///< Versiones subidas a cada m_shadowBuffers.
 
   XMFLOAT4                            m_LightPos;
   std::string m_name = "Actor";         ///< Nombre del actor.
 	bool castShadow = true;              ///< Indica si el actor proyecta sombras.
-};
\ No newline at end of file
+};
+
+// Bloques de MakeShared<Actor> desde el pool de su tipo.
+EU_POOL_ALLOCATED(Actor)
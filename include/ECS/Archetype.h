@@ -0,0 +1,247 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ECS\ComponentType.h"
+
+/**
+ * @class Archetype
+ * @brief Almacena todas las entidades que tienen exactamente el mismo
+ *        conjunto de componentes.
+ *
+ * Las entidades se guardan en chunks de CHUNK_SIZE bytes. Dentro de cada
+ * chunk los componentes van por columnas (SoA): primero los EntityId y luego
+ * un arreglo contiguo por tipo de componente, así recorrer un tipo lee
+ * memoria seguida sin saltar por el heap. Las filas están siempre
+ * compactadas: al quitar una entidad la última ocupa su hueco.
+ *
+ * Una fila global se traduce a (chunk, índice) con row / capacidad del chunk.
+ * La columna de un tipo se obtiene indexando una tabla por su id, sin buscar.
+ *
+ * Cada componente guarda dos ticks del World: cuándo se añadió a la entidad y
+ * cuándo se escribió por última vez. Además cada columna de cada chunk guarda
+ * el mayor tick de escritura de sus filas, para que las consultas con filtro
+ * de cambios salten chunks enteros sin mirar fila por fila. Los ticks viajan
+ * con la fila cuando se compacta el chunk.
+ */
+class
+Archetype {
+public:
+  static const size_t CHUNK_SIZE = 16 * 1024;
+
+  /**
+   * @brief Una columna: tipo de componente y su posición dentro de cada chunk.
+   */
+  struct Column {
+    const ComponentTypeInfo* info;
+    size_t offset;
+  };
+
+  /**
+   * @brief Bloque de memoria con hasta getChunkCapacity() entidades.
+   */
+  struct Chunk {
+    unsigned char* data;
+    uint32_t count;
+  };
+
+  /**
+   * @brief Crea el arquetipo para un conjunto de tipos ordenado por id.
+   */
+  explicit Archetype(const EU::TArray<const ComponentTypeInfo*>& types);
+
+  /**
+   * @brief Destruye los componentes que queden y libera los chunks.
+   */
+  ~Archetype();
+
+  Archetype(const Archetype&) = delete;
+  Archetype& operator=(const Archetype&) = delete;
+
+  /**
+   * @brief Índice de la columna del tipo, o -1 si el arquetipo no lo tiene.
+   */
+  int
+  findColumn(ComponentTypeId id) const { return m_columnOf[id]; }
+
+  bool
+  hasType(ComponentTypeId id) const { return (m_mask >> id) & 1; }
+
+  /**
+   * @brief Tipos del arquetipo como máscara de bits.
+   */
+  ComponentMask
+  getMask() const { return m_mask; }
+
+  const EU::TArray<Column>&
+  getColumns() const { return m_columns; }
+
+  /**
+   * @brief Reserva una fila al final para entity; sus componentes quedan sin
+   *        construir y el llamador debe construirlos todos.
+   * @return La fila reservada.
+   */
+  uint32_t
+  allocateRow(EntityId entity);
+
+  /**
+   * @brief Quita una fila moviendo la última a su hueco.
+   *
+   * Los componentes de la fila deben estar ya destruidos (o movidos).
+   * @return La entidad que pasó a ocupar row, o un id nulo si era la última.
+   */
+  EntityId
+  removeRow(uint32_t row);
+
+  /**
+   * @brief Dirección del componente de la columna column en la fila row.
+   */
+  void*
+  getComponentData(uint32_t row, int column) {
+    Chunk& chunk = m_chunks[row / m_chunkCapacity];
+    return chunk.data + m_columns[column].offset +
+           size_t(row % m_chunkCapacity) * m_columns[column].info->size;
+  }
+
+  EntityId
+  getEntity(uint32_t row) const {
+    const Chunk& chunk = m_chunks[row / m_chunkCapacity];
+    return reinterpret_cast<const EntityId*>(chunk.data)[row % m_chunkCapacity];
+  }
+
+  /**
+   * @brief Arreglo contiguo de la columna column dentro del chunk.
+   */
+  template<typename T>
+  T*
+  getColumnData(size_t chunkIndex, int column) {
+    return reinterpret_cast<T*>(m_chunks[chunkIndex].data + m_columns[column].offset);
+  }
+
+  /**
+   * @brief Ids de las entidades del chunk, en el mismo orden que sus columnas.
+   */
+  const EntityId*
+  getEntities(size_t chunkIndex) const {
+    return reinterpret_cast<const EntityId*>(m_chunks[chunkIndex].data);
+  }
+
+  size_t
+  getNumChunks() const { return m_chunks.Num(); }
+
+  const Chunk&
+  getChunk(size_t chunkIndex) const { return m_chunks[chunkIndex]; }
+
+  uint32_t
+  getChunkCapacity() const { return m_chunkCapacity; }
+
+  uint32_t
+  getNumEntities() const { return m_numEntities; }
+
+  /**
+   * @brief Mayor tick de escritura de la columna en el chunk (0 si nunca se
+   *        marcó).
+   */
+  uint32_t
+  getChangeTick(size_t chunkIndex, int column) const {
+    return m_changeTicks[chunkIndex * m_columns.Num() + column];
+  }
+
+  /**
+   * @brief Ticks de la última escritura de cada fila del chunk en la columna,
+   *        en el mismo orden que getColumnData.
+   */
+  const uint32_t*
+  getRowChangeTicks(size_t chunkIndex, int column) const {
+    return &m_rowChangeTicks[getTickOffset(chunkIndex, column)];
+  }
+
+  /**
+   * @brief Ticks en que se añadió el componente a cada fila del chunk.
+   */
+  const uint32_t*
+  getRowAddedTicks(size_t chunkIndex, int column) const {
+    return &m_rowAddedTicks[getTickOffset(chunkIndex, column)];
+  }
+
+  uint32_t
+  getRowChangeTick(uint32_t row, int column) const {
+    return m_rowChangeTicks[getTickOffset(row / m_chunkCapacity, column) + row % m_chunkCapacity];
+  }
+
+  uint32_t
+  getRowAddedTick(uint32_t row, int column) const {
+    return m_rowAddedTicks[getTickOffset(row / m_chunkCapacity, column) + row % m_chunkCapacity];
+  }
+
+  /**
+   * @brief Marca la columna de todas las filas del chunk como escrita en tick.
+   */
+  void
+  markChanged(size_t chunkIndex, int column, uint32_t tick);
+
+  /**
+   * @brief Marca el componente de la columna en la fila row como escrito en
+   *        tick. Solo toca datos del chunk de la fila: dos hilos pueden
+   *        marcar chunks distintos a la vez.
+   */
+  void
+  markRowChanged(uint32_t row, int column, uint32_t tick) {
+    const size_t chunkIndex = row / m_chunkCapacity;
+    m_rowChangeTicks[getTickOffset(chunkIndex, column) + row % m_chunkCapacity] = tick;
+    uint32_t& chunkTick = m_changeTicks[chunkIndex * m_columns.Num() + column];
+    chunkTick = tick > chunkTick ? tick : chunkTick;
+  }
+
+  /**
+   * @brief Marca el componente de la fila como recién añadido (y escrito) en tick.
+   */
+  void
+  markRowAdded(uint32_t row, int column, uint32_t tick) {
+    m_rowAddedTicks[getTickOffset(row / m_chunkCapacity, column) + row % m_chunkCapacity] = tick;
+    markRowChanged(row, column, tick);
+  }
+
+  /**
+   * @brief Copia los ticks de fromRow/fromColumn de from a row/column (el
+   *        componente se movió de arquetipo sin cambiar).
+   */
+  void
+  copyRowTicks(uint32_t row, int column, const Archetype& from, uint32_t fromRow, int fromColumn) {
+    m_rowAddedTicks[getTickOffset(row / m_chunkCapacity, column) + row % m_chunkCapacity] =
+      from.getRowAddedTick(fromRow, fromColumn);
+    markRowChanged(row, column, from.getRowChangeTick(fromRow, fromColumn));
+  }
+
+  /**
+   * @brief Arquetipo vecino con un tipo más (addEdges) o uno menos
+   *        (removeEdges), indexado por id; se rellena la primera vez que se
+   *        recorre la arista.
+   */
+  Archetype* addEdges[MAX_COMPONENT_TYPES] = {};
+  Archetype* removeEdges[MAX_COMPONENT_TYPES] = {};
+
+private:
+  /**
+   * @brief Primer tick de la columna del chunk en los arreglos por fila.
+   */
+  size_t
+  getTickOffset(size_t chunkIndex, int column) const {
+    return (chunkIndex * m_columns.Num() + column) * m_chunkCapacity;
+  }
+
+  /**
+   * @brief Ajusta los arreglos de ticks al número de chunks (los nuevos en 0).
+   */
+  void
+  resizeTicks();
+
+  EU::TArray<Column> m_columns;       ///< Ordenadas por id de tipo.
+  ComponentMask m_mask = 0;
+  int8_t m_columnOf[MAX_COMPONENT_TYPES]; ///< Columna de cada id de tipo, o -1.
+  EU::TArray<Chunk> m_chunks;
+  EU::TArray<uint32_t> m_changeTicks; ///< Por chunk, el mayor tick de cada columna.
+  EU::TArray<uint32_t> m_rowChangeTicks; ///< Por chunk y columna, un tick por fila.
+  EU::TArray<uint32_t> m_rowAddedTicks;  ///< Igual que m_rowChangeTicks, de altas.
+  size_t m_chunkBytes = CHUNK_SIZE;
+  uint32_t m_chunkCapacity = 0;       ///< Entidades por chunk.
+  uint32_t m_numEntities = 0;
+};
@@ -0,0 +1,183 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ECS\ComponentType.h"
+#include <type_traits>
+
+class World;
+
+/**
+ * @brief Entidad creada con CommandBuffer::spawn. Solo existe en el World
+ *        tras la reproducción del buffer; antes sirve para encadenarle
+ *        comandos del mismo buffer.
+ */
+struct PendingEntity {
+  uint32_t index;
+};
+
+/**
+ * @class CommandBuffer
+ * @brief Graba cambios estructurales del World (crear y destruir entidades,
+ *        añadir y quitar componentes) para aplicarlos más tarde.
+ *
+ * Los cambios estructurales no se pueden hacer mientras se recorre el World
+ * ni desde varios hilos. Un sistema graba en su propio buffer (cada hilo o
+ * tarea el suyo, sin locks) y el dueño lo reproduce en un punto de
+ * sincronización con playback(), en el orden en que se grabó.
+ *
+ * Los valores de los componentes se construyen al grabar en una arena
+ * propia del buffer y se mueven al World al reproducir; reproducir o vaciar
+ * el buffer recupera la arena entera.
+ *
+ * No es seguro entre hilos: un buffer tiene un solo hilo que graba.
+ */
+class
+CommandBuffer {
+public:
+  explicit CommandBuffer(size_t initialBytes = 4 * 1024);
+
+  /**
+   * @brief Descarta (destruye) lo que quede sin reproducir.
+   */
+  ~CommandBuffer();
+
+  CommandBuffer(const CommandBuffer&) = delete;
+  CommandBuffer& operator=(const CommandBuffer&) = delete;
+
+  /**
+   * @brief Crea una entidad sin componentes al reproducir.
+   */
+  PendingEntity
+  spawn();
+
+  /**
+   * @brief Destruye la entidad al reproducir (si sigue viva).
+   */
+  void
+  destroy(EntityId entity);
+
+  /**
+   * @brief Destruye una entidad de spawn() del mismo buffer al llegar su
+   *        turno; getSpawned() conserva su id, ya no vivo.
+   */
+  void
+  destroy(PendingEntity entity);
+
+  /**
+   * @brief Añade (o reemplaza) el componente T construido ahora con args.
+   */
+  template<typename T, typename... Args>
+  void
+  add(EntityId entity, Args&&... args) {
+    record(Op::Add, entity, NONE, construct<T>(std::forward<Args>(args)...), &getComponentTypeInfo<T>());
+  }
+
+  template<typename T, typename... Args>
+  void
+  add(PendingEntity entity, Args&&... args) {
+    record(Op::Add, EntityId(), entity.index, construct<T>(std::forward<Args>(args)...), &getComponentTypeInfo<T>());
+  }
+
+  /**
+   * @brief Quita el componente T al reproducir (si la entidad lo tiene).
+   */
+  template<typename T>
+  void
+  remove(EntityId entity) {
+    Command& command = record(Op::Remove, entity, NONE, nullptr, nullptr);
+    command.type = componentTypeId<T>();
+  }
+
+  template<typename T>
+  void
+  remove(PendingEntity entity) {
+    Command& command = record(Op::Remove, EntityId(), entity.index, nullptr, nullptr);
+    command.type = componentTypeId<T>();
+  }
+
+  /**
+   * @brief Ejecuta fn(World&) al reproducir, en su turno. Para trabajo que
+   *        además de entidades crea otros recursos (p. ej. un Actor).
+   */
+  template<typename Fn>
+  void
+  call(Fn&& fn) {
+    using Callable = std::decay_t<Fn>;
+    Command& command = record(Op::Call, EntityId(), NONE, construct<Callable>(std::forward<Fn>(fn)), nullptr);
+    command.invoke = [](World& world, void* payload) { (*static_cast<Callable*>(payload))(world); };
+    command.destroyPayload = [](void* payload) { static_cast<Callable*>(payload)->~Callable(); };
+  }
+
+  /**
+   * @brief Aplica los comandos en orden de grabación y deja el buffer vacío.
+   *        Los comandos sobre entidades que ya no existen se ignoran.
+   *
+   * Si un comando lanza una excepción, la deja pasar con el buffer vacío:
+   * lo ya aplicado se queda en el World y el resto se descarta.
+   */
+  void
+  playback(World& world);
+
+  /**
+   * @brief Descarta los comandos sin aplicarlos.
+   */
+  void
+  clear();
+
+  bool
+  isEmpty() const { return m_commands.IsEmpty(); }
+
+  size_t
+  getNumCommands() const { return m_commands.Num(); }
+
+  /**
+   * @brief Entidades creadas por la última reproducción, indexadas por
+   *        PendingEntity::index.
+   */
+  const EU::TArray<EntityId>&
+  getSpawned() const { return m_spawned; }
+
+private:
+  static constexpr uint32_t NONE = ~uint32_t(0);
+
+  enum class Op : uint8_t {
+    Spawn,
+    Destroy,
+    Add,
+    Remove,
+    Call
+  };
+
+  struct Command {
+    Op op;
+    uint32_t pending;                ///< Índice de PendingEntity, o NONE si se usa entity.
+    EntityId entity;
+    ComponentTypeId type;            ///< Remove: tipo a quitar.
+    const ComponentTypeInfo* info;   ///< Add: tipo del valor.
+    void* payload;                   ///< Add: valor en la arena. Call: el invocable.
+    void (*invoke)(World&, void*);   ///< Call.
+    void (*destroyPayload)(void*);   ///< Call.
+  };
+
+  template<typename T, typename... Args>
+  T*
+  construct(Args&&... args) {
+    void* memory = m_arena.Allocate(sizeof(T), alignof(T));
+    return ::new (memory) T(std::forward<Args>(args)...);
+  }
+
+  Command&
+  record(Op op, EntityId entity, uint32_t pending, void* payload, const ComponentTypeInfo* info);
+
+  /**
+   * @brief Destruye el valor guardado del comando y lo deja en nullptr (una
+   *        segunda llamada no hace nada).
+   */
+  static void
+  releasePayload(Command& command);
+
+  EU::TArray<Command> m_commands;
+  EU::LinearArena m_arena;         ///< Valores de Add y Call.
+  uint32_t m_numPending = 0;       ///< spawn() grabados desde la última reproducción.
+  EU::TArray<EntityId> m_spawned;
+  bool m_playing = false;
+};
@@ -0,0 +1,125 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include <cassert>
+#include <cstdint>
+#include <new>
+#include <typeinfo>
+#include <utility>
+
+struct EntityRecord;
+
+/**
+ * @brief Identificador de una entidad del World: índice de ranura + generación.
+ *
+ * Sigue siendo válido mientras la entidad viva, aunque sus componentes
+ * cambien de arquetipo; tras destroyEntity deja de resolver.
+ */
+using EntityId = EU::TSlotHandle<EntityRecord>;
+
+/**
+ * @brief Identificador numérico de un tipo de componente.
+ */
+using ComponentTypeId = uint32_t;
+
+/**
+ * @brief Conjunto de tipos de componente: el bit i indica el tipo con id i.
+ */
+using ComponentMask = uint64_t;
+
+/**
+ * @brief Número máximo de tipos de componente (un bit de ComponentMask por tipo).
+ */
+static const uint32_t MAX_COMPONENT_TYPES = 64;
+
+/**
+ * @brief Id de tipo de T, conocido en compilación.
+ *
+ * Cada componente lo declara con un valor del enum ComponentType:
+ * @code
+ * static constexpr ComponentType TYPE_ID = TRANSFORM;
+ * @endcode
+ */
+template<typename T>
+constexpr ComponentTypeId
+componentTypeId() {
+  static_assert(static_cast<ComponentTypeId>(T::TYPE_ID) < MAX_COMPONENT_TYPES,
+                "Component TYPE_ID must be lower than MAX_COMPONENT_TYPES");
+  return static_cast<ComponentTypeId>(T::TYPE_ID);
+}
+
+/**
+ * @brief Máscara con los bits de los tipos Ts (componentMask<T>() tiene solo
+ *        el bit de T).
+ */
+template<typename... Ts>
+constexpr ComponentMask
+componentMask() {
+  return (ComponentMask(0) | ... | (ComponentMask(1) << componentTypeId<Ts>()));
+}
+
+/**
+ * @brief Etiqueta (componente sin datos) de las entidades desactivadas: las
+ *        consultas del World no las visitan salvo con includeDisabled().
+ */
+struct Disabled {
+  static constexpr ComponentType TYPE_ID = DISABLED;
+};
+
+/**
+ * @brief Descripción de un tipo de componente para el almacenamiento por
+ *        arquetipos: tamaño, alineación y cómo mover/destruir un valor sin
+ *        conocer el tipo (sin despacho virtual).
+ */
+struct ComponentTypeInfo {
+  ComponentTypeId id;
+  uint32_t size;
+  uint32_t alignment;
+  const char* name;
+  void (*moveConstruct)(void* dst, void* src);  ///< Construye en dst moviendo desde src.
+  void (*destroy)(void* object);
+};
+
+namespace detail {
+  /**
+   * Comprueba que dos tipos distintos no declaren el mismo TYPE_ID.
+   */
+  inline bool
+  registerComponentType(const ComponentTypeInfo& info) {
+    static const ComponentTypeInfo* registered[MAX_COMPONENT_TYPES] = {};
+    assert((!registered[info.id] || registered[info.id] == &info) &&
+           "Two component types share the same TYPE_ID");
+    registered[info.id] = &info;
+    return true;
+  }
+
+  template<typename T>
+  void
+  moveConstructComponent(void* dst, void* src) {
+    ::new (dst) T(std::move(*static_cast<T*>(src)));
+  }
+
+  template<typename T>
+  void
+  destroyComponent(void* object) {
+    static_cast<T*>(object)->~T();
+  }
+}
+
+/**
+ * @brief Devuelve la descripción única del tipo de componente T.
+ */
+template<typename T>
+const ComponentTypeInfo&
+getComponentTypeInfo() {
+  static const ComponentTypeInfo info = {
+    componentTypeId<T>(),
+    static_cast<uint32_t>(sizeof(T)),
+    static_cast<uint32_t>(alignof(T)),
+    typeid(T).name(),
+    &detail::moveConstructComponent<T>,
+    &detail::destroyComponent<T>
+  };
+  static const bool registered = detail::registerComponentType(info);
+  (void)registered;
+  return info;
+}
@@ -1,6 +1,7 @@
 ﻿#pragma once
 #include "Prerequisites.h"
 #include "Component.h"
+#include "World.h"
 
 class DeviceContext;
 
@@ -8,12 +9,26 @@ class
 Entity {
 public:
 	Entity() = default;
+
+  /**
+   * @brief Crea la entidad en el mundo; sus componentes viven en él.
+   * @param world Mundo que guarda los componentes de esta entidad.
+   */
+  explicit
+  Entity(World& world) : m_world(&world), m_entity(world.createEntity()) {}
 	
 	/**
-   * @brief Destructor virtual.
+   * @brief Destructor virtual. Destruye la entidad y sus componentes en el mundo.
    */
   virtual
-  ~Entity() = default;
+  ~Entity() {
+    if (m_world) {
+      m_world->destroyEntity(m_entity);
+    }
+  }
+
+  Entity(const Entity&) = delete;
+  Entity& operator=(const Entity&) = delete;
 
   /**
    * @brief Initialize the entity with a device context.
@@ -46,34 +61,73 @@ public:
 
   /**
    * @brief Agrega un componente a la entidad.
+   *
+   * Se mantiene por compatibilidad: el mundo guarda una copia del valor
+   * apuntado, no el puntero compartido.
    * @tparam T Tipo del componente, debe derivar de Component.
    * @param component Puntero compartido al componente que se va a agregar.
    */
   template <typename T> void 
   addComponent(EU::TSharedPointer<T> component) {
     static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
-    m_components.push_back(component.template dynamic_pointer_cast<Component>());
+    if (component) {
+      emplaceComponent<T>(*component);
+    }
+  }
+
+  /**
+   * @brief Construye un componente T en el mundo a partir de args.
+   * @return Referencia al componente, válida hasta el siguiente cambio
+   *         estructural del mundo.
+   */
+  template <typename T, typename... Args>
+  T&
+  emplaceComponent(Args&&... args) {
+    static_assert(std::is_base_of<Component, T>::value, "T must be derived from Component");
+    assert(m_world && "Entity: component added to an entity without a World");
+    return m_world->addComponent<T>(m_entity, std::forward<Args>(args)...);
   }
 
   /**
-   * @brief Obtiene un componente de la entidad por su tipo.
+   * @brief Obtiene un componente que la entidad tiene seguro (assert si no).
+   *
+   * Acceso directo por id de tipo en compilación, sin RTTI ni contadores de
+   * referencias.
    * @tparam T Tipo del componente a obtener.
-   * @return Puntero compartido al componente si se encuentra, nullptr en caso contrario.
+   * @return Referencia no propietaria, válida hasta el siguiente cambio
+   *         estructural del mundo.
 	 */
   template<typename T>
-  EU::TSharedPointer<T>
+  T&
   getComponent() {
-    for (auto& component : m_components) {
-      EU::TSharedPointer<T> specificComponent = component.template dynamic_pointer_cast<T>();
-      if (specificComponent) {
-        return specificComponent;
-      }
-    }
-    return EU::TSharedPointer<T>();
+    assert(m_world && "Entity: getComponent on an entity without a World");
+    return m_world->getComponent<T>(m_entity);
+  }
+
+  /**
+   * @brief Como getComponent, pero devuelve nullptr si la entidad no tiene T.
+   */
+  template<typename T>
+  T*
+  tryGetComponent() {
+    return m_world ? m_world->tryGetComponent<T>(m_entity) : nullptr;
   }
+
+  template<typename T>
+  bool
+  hasComponent() const {
+    return m_world && m_world->hasComponent<T>(m_entity);
+  }
+
+  EntityId
+  getEntityId() const { return m_entity; }
+
+  World*
+  getWorld() const { return m_world; }
+
 private:
 protected:
   bool m_isActive;
-  int m_id;
-  std::vector<EU::TSharedPointer<Component>> m_components;
+  World* m_world = nullptr;  ///< Mundo dueño de los componentes.
+  EntityId m_entity;         ///< Id de la entidad dentro de m_world.
 };
\ No newline at end of file
@@ -0,0 +1,318 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ECS\World.h"
+#include <tuple>
+#include <type_traits>
+
+/**
+ * @brief Vista de un arreglo contiguo de componentes dentro de un chunk.
+ *
+ * data apunta a count elementos seguidos del mismo tipo (alineados a su
+ * tipo), así que un bucle sobre ella se puede vectorizar o pasar tal cual a
+ * los kernels de EU::Batch.
+ */
+template<typename T>
+struct ComponentSpan {
+  T* data;
+  uint32_t count;
+
+  ComponentSpan(T* data, uint32_t count) : data(data), count(count) {}
+
+  T&
+  operator[](uint32_t index) const { return data[index]; }
+
+  uint32_t
+  size() const { return count; }
+
+  T*
+  begin() const { return data; }
+
+  T*
+  end() const { return data + count; }
+};
+
+/**
+ * @class Query
+ * @brief Recorre las entidades que tienen todos los tipos Ts, chunk a chunk.
+ *
+ * Los arquetipos que cumplen la consulta se calculan una vez y se guardan en
+ * el World; cada recorrido solo revisa los arquetipos creados desde el
+ * anterior. Dentro de cada chunk se entregan arreglos contiguos de cada tipo,
+ * sin buscar componentes por entidad.
+ *
+ * Filtros opcionales:
+ * - with<Us...>() / without<Us...>(): tipos que deben estar o no (sin leerlos).
+ * - changed<Us...>(tick): solo entidades en las que alguno de Us se añadió o
+ *   se escribió después de tick (World::getChangeTick() de la última
+ *   ejecución del sistema).
+ * - added<Us...>(tick): solo entidades a las que se añadió alguno de Us
+ *   después de tick.
+ * - includeDisabled(): incluye las entidades con la etiqueta Disabled, que
+ *   por defecto se saltan.
+ * - writes<Us...>(): marca los tipos Us como escritos (ver abajo).
+ *
+ * changed y added se pueden combinar (tienen que cumplirse los dos). Los
+ * chunks sin cambios se saltan enteros; each filtra además entidad por
+ * entidad, eachChunk entrega el chunk completo.
+ *
+ * Recorrer no marca nada como cambiado, aunque el tipo no sea const: un
+ * sistema que solo lee por una referencia no const no dispara changed ni
+ * onChanged. Para que cuente como escritura hay que pedirlo con writes<Us>():
+ * each marca con el tick actual cada entidad que visita y eachChunk el chunk
+ * entero. Si solo se escriben algunas entidades, mejor no usar writes y
+ * marcarlas a mano con World::markChanged o Archetype::markRowChanged.
+ *
+ * El objeto se puede guardar y reutilizar entre frames. No admite cambios
+ * estructurales del World mientras recorre.
+ *
+ * @code
+ * world.each<Transform, const MeshComponent>([](Transform& t, const MeshComponent& m) { ... });
+ *
+ * Query<Transform> moved = world.query<Transform>();
+ * moved.changed<Transform>(lastTick).writes<Transform>().eachChunk(
+ *   [](ComponentSpan<const EntityId> entities, ComponentSpan<Transform> transforms) { ... });
+ * @endcode
+ */
+template<typename... Ts>
+class
+Query {
+  static_assert(sizeof...(Ts) > 0, "Query needs at least one component type");
+
+  static constexpr uint32_t NONE = ~uint32_t(0);
+
+public:
+  explicit Query(World& world)
+    : m_world(world),
+      m_required(componentMask<std::remove_const_t<Ts>...>()),
+      m_excluded(componentMask<Disabled>()) {
+    m_cacheIndex = m_world.findOrCreateQueryCache(m_required, m_excluded);
+  }
+
+  /**
+   * @brief Exige además los tipos Us (sin recibirlos en la función).
+   */
+  template<typename... Us>
+  Query&
+  with() {
+    m_required |= componentMask<Us...>();
+    m_cacheIndex = m_world.findOrCreateQueryCache(m_required, m_excluded);
+    return *this;
+  }
+
+  /**
+   * @brief Salta las entidades que tengan alguno de los tipos Us.
+   */
+  template<typename... Us>
+  Query&
+  without() {
+    m_excluded |= componentMask<Us...>();
+    m_cacheIndex = m_world.findOrCreateQueryCache(m_required, m_excluded);
+    return *this;
+  }
+
+  /**
+   * @brief Incluye también las entidades desactivadas.
+   */
+  Query&
+  includeDisabled() {
+    m_excluded &= ~componentMask<Disabled>();
+    m_cacheIndex = m_world.findOrCreateQueryCache(m_required, m_excluded);
+    return *this;
+  }
+
+  /**
+   * @brief Solo entidades en las que alguno de los tipos Us se añadió o se
+   *        escribió después de sinceTick.
+   */
+  template<typename... Us>
+  Query&
+  changed(uint32_t sinceTick) {
+    m_changedMask |= componentMask<Us...>();
+    m_changedSince = sinceTick;
+    return *this;
+  }
+
+  /**
+   * @brief Solo entidades a las que se añadió alguno de los tipos Us
+   *        después de sinceTick.
+   */
+  template<typename... Us>
+  Query&
+  added(uint32_t sinceTick) {
+    m_addedMask |= componentMask<Us...>();
+    m_addedSince = sinceTick;
+    return *this;
+  }
+
+  /**
+   * @brief Marca los tipos Us como escritos en lo que se recorra: cada
+   *        entidad visitada por each o cada chunk de eachChunk.
+   *
+   * Us tienen que estar en Ts sin const.
+   */
+  template<typename... Us>
+  Query&
+  writes() {
+    static_assert((isWritable<Us>() && ...), "Query::writes: each type must be a non-const type of the query");
+    m_writtenMask |= componentMask<Us...>();
+    return *this;
+  }
+
+  /**
+   * @brief Llama a fn(ComponentSpan<const EntityId>, ComponentSpan<Ts>...)
+   *        por cada chunk no vacío que cumpla los filtros.
+   */
+  template<typename Fn>
+  void
+  eachChunk(Fn&& fn) {
+    const uint32_t tick = m_world.getChangeTick();
+    for (Archetype* archetype : m_world.getMatchingArchetypes(m_cacheIndex)) {
+      const int columns[] = { archetype->findColumn(componentTypeId<std::remove_const_t<Ts>>())... };
+      for (size_t c = 0; c < archetype->getNumChunks(); ++c) {
+        const uint32_t count = archetype->getChunk(c).count;
+        if (count == 0 || !chunkMatches(*archetype, c)) {
+          continue;
+        }
+        visitChunk(fn, *archetype, c, count, columns, tick, std::index_sequence_for<Ts...>());
+      }
+    }
+  }
+
+  /**
+   * @brief Llama a fn(Ts&...) o fn(EntityId, Ts&...) por cada entidad.
+   */
+  template<typename Fn>
+  void
+  each(Fn&& fn) {
+    const uint32_t tick = m_world.getChangeTick();
+    for (Archetype* archetype : m_world.getMatchingArchetypes(m_cacheIndex)) {
+      const int columns[] = { archetype->findColumn(componentTypeId<std::remove_const_t<Ts>>())... };
+      for (size_t c = 0; c < archetype->getNumChunks(); ++c) {
+        const uint32_t count = archetype->getChunk(c).count;
+        if (count == 0 || !chunkMatches(*archetype, c)) {
+          continue;
+        }
+        visitEntities(fn, *archetype, c, count, columns, tick, std::index_sequence_for<Ts...>());
+      }
+    }
+  }
+
+  /**
+   * @brief Número de entidades que cumplen la consulta (sin el filtro de cambios).
+   */
+  uint32_t
+  count() {
+    uint32_t total = 0;
+    for (Archetype* archetype : m_world.getMatchingArchetypes(m_cacheIndex)) {
+      total += archetype->getNumEntities();
+    }
+    return total;
+  }
+
+private:
+  template<typename U>
+  static constexpr bool
+  isWritable() {
+    return (std::is_same<U, Ts>::value || ...);
+  }
+
+  /**
+   * @brief Si alguno de los tipos de mask tiene un tick posterior a sinceTick
+   *        en el chunk (row == NONE) o en la fila row del chunk.
+   */
+  bool
+  anyNewer(const Archetype& archetype, size_t chunkIndex, uint32_t row, ComponentMask mask,
+           uint32_t sinceTick, bool added) const {
+    for (ComponentTypeId id = 0; id < MAX_COMPONENT_TYPES && (mask >> id); ++id) {
+      const int column = ((mask >> id) & 1) ? archetype.findColumn(id) : -1;
+      if (column < 0) {
+        continue;
+      }
+      // El tick del chunk es el mayor de escritura, y un alta también escribe
+      uint32_t tick = archetype.getChangeTick(chunkIndex, column);
+      if (row != NONE) {
+        tick = added ? archetype.getRowAddedTicks(chunkIndex, column)[row]
+                     : archetype.getRowChangeTicks(chunkIndex, column)[row];
+      }
+      if (tick > sinceTick) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool
+  chunkMatches(const Archetype& archetype, size_t chunkIndex) const {
+    return (m_changedMask == 0 || anyNewer(archetype, chunkIndex, NONE, m_changedMask, m_changedSince, false)) &&
+           (m_addedMask == 0 || anyNewer(archetype, chunkIndex, NONE, m_addedMask, m_addedSince, true));
+  }
+
+  bool
+  rowMatches(const Archetype& archetype, size_t chunkIndex, uint32_t row) const {
+    return (m_changedMask == 0 || anyNewer(archetype, chunkIndex, row, m_changedMask, m_changedSince, false)) &&
+           (m_addedMask == 0 || anyNewer(archetype, chunkIndex, row, m_addedMask, m_addedSince, true));
+  }
+
+  /**
+   * @brief Si T se pidió con writes (nunca para tipos const).
+   */
+  template<typename T>
+  bool
+  isWritten() const {
+    return !std::is_const<T>::value && (m_writtenMask & componentMask<std::remove_const_t<T>>()) != 0;
+  }
+
+  template<typename Fn, size_t... Is>
+  void
+  visitEntities(Fn& fn, Archetype& archetype, size_t chunkIndex, uint32_t count,
+                const int* columns, uint32_t tick, std::index_sequence<Is...>) {
+    const EntityId* entities = archetype.getEntities(chunkIndex);
+    std::tuple<Ts*...> data(archetype.getColumnData<std::remove_const_t<Ts>>(chunkIndex, columns[Is])...);
+    const bool filtered = (m_changedMask | m_addedMask) != 0;
+    const bool written[] = { isWritten<Ts>()... };
+    const uint32_t firstRow = uint32_t(chunkIndex) * archetype.getChunkCapacity();
+    for (uint32_t i = 0; i < count; ++i) {
+      if (filtered && !rowMatches(archetype, chunkIndex, i)) {
+        continue;
+      }
+      ((written[Is] ? archetype.markRowChanged(firstRow + i, columns[Is], tick) : void()), ...);
+      if constexpr (std::is_invocable<Fn&, EntityId, Ts&...>::value) {
+        fn(entities[i], std::get<Is>(data)[i]...);
+      }
+      else {
+        fn(std::get<Is>(data)[i]...);
+      }
+    }
+  }
+
+  template<typename Fn, size_t... Is>
+  void
+  visitChunk(Fn& fn, Archetype& archetype, size_t chunkIndex, uint32_t count,
+             const int* columns, uint32_t tick, std::index_sequence<Is...>) {
+    ((isWritten<Ts>() ? archetype.markChanged(chunkIndex, columns[Is], tick) : void()), ...);
+    fn(ComponentSpan<const EntityId>(archetype.getEntities(chunkIndex), count),
+       ComponentSpan<Ts>(archetype.getColumnData<std::remove_const_t<Ts>>(chunkIndex, columns[Is]), count)...);
+  }
+
+  World& m_world;
+  ComponentMask m_required;
+  ComponentMask m_excluded;
+  ComponentMask m_changedMask = 0;
+  ComponentMask m_addedMask = 0;
+  ComponentMask m_writtenMask = 0;
+  uint32_t m_changedSince = 0;
+  uint32_t m_addedSince = 0;
+  uint32_t m_cacheIndex;
+};
+
+template<typename... Ts>
+Query<Ts...>
+World::query() {
+  return Query<Ts...>(*this);
+}
+
+template<typename... Ts, typename Fn>
+void
+World::each(Fn&& fn) {
+  Query<Ts...>(*this).each(std::forward<Fn>(fn));
+}
@@ -0,0 +1,191 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ECS\World.h"
+#include "ECS\CommandBuffer.h"
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+/**
+ * @class SystemScheduler
+ * @brief Ejecuta los sistemas del World en paralelo según los componentes
+ *        que cada uno declara leer y escribir.
+ *
+ * Dos sistemas entran en conflicto si uno escribe un tipo que el otro lee o
+ * escribe; en ese caso el que se registró después espera al primero. Los que
+ * no tienen conflictos forman ramas independientes del grafo y se ejecutan a
+ * la vez en el pool de hilos. Un sistema por chunks además reparte los chunks
+ * de los arquetipos que le interesan entre varias tareas.
+ *
+ * El hilo que llama a run() también ejecuta tareas y no vuelve hasta que
+ * terminan todos los sistemas. Durante run() no se pueden hacer cambios
+ * estructurales en el World (crear o destruir entidades, añadir o quitar
+ * componentes), y un sistema solo debe tocar los tipos que declaró.
+ *
+ * Los cambios estructurales se graban en el CommandBuffer que recibe cada
+ * tarea (uno por tarea, sin locks). Al final de run(), con todos los
+ * sistemas terminados, se reproducen en orden de registro de los sistemas y,
+ * dentro de cada uno, en orden de tarea: el resultado no depende de qué hilo
+ * ejecutó qué.
+ */
+class
+SystemScheduler {
+public:
+  /**
+   * @brief Sistema que se ejecuta entero en una sola tarea.
+   */
+  using SystemFn = std::function<void(float deltaTime, CommandBuffer& commands)>;
+
+  /**
+   * @brief Sistema que se ejecuta por chunk: recibe el arquetipo, el índice
+   *        del chunk, el deltaTime y el buffer de comandos de su tarea.
+   */
+  using ChunkFn = std::function<void(Archetype& archetype, size_t chunkIndex, float deltaTime,
+                                     CommandBuffer& commands)>;
+
+  /**
+   * @param world Mundo cuyos arquetipos recorren los sistemas por chunks.
+   * @param numWorkers Hilos del pool, sin contar el que llama a run();
+   *        con ~0u se usa uno menos que los núcleos de la máquina.
+   */
+  explicit SystemScheduler(World& world, uint32_t numWorkers = ~0u);
+
+  /**
+   * @brief Detiene y espera a los hilos del pool.
+   */
+  ~SystemScheduler();
+
+  SystemScheduler(const SystemScheduler&) = delete;
+  SystemScheduler& operator=(const SystemScheduler&) = delete;
+
+  /**
+   * @brief Registra un sistema que se ejecuta en una sola tarea.
+   * @param reads Componentes que lee (p. ej. componentMask<Transform>()).
+   * @param writes Componentes que escribe.
+   * @return Índice del sistema.
+   */
+  uint32_t
+  addSystem(const std::string& name, ComponentMask reads, ComponentMask writes, SystemFn fn);
+
+  /**
+   * @brief Registra un sistema que se ejecuta sobre cada chunk de los
+   *        arquetipos que tienen todos los tipos de reads y writes (sin las
+   *        entidades desactivadas). El sistema marca las filas que cambia
+   *        (Archetype::markRowChanged con World::getChangeTick()), o el chunk
+   *        entero con markChanged: así las consultas changed y los
+   *        observadores onChanged solo ven lo que cambió de verdad.
+   * @return Índice del sistema.
+   */
+  uint32_t
+  addChunkSystem(const std::string& name, ComponentMask reads, ComponentMask writes, ChunkFn fn);
+
+  /**
+   * @brief Ejecuta todos los sistemas una vez respetando sus dependencias y
+   *        reproduce sus comandos. Los hilos del pool se crean la primera vez.
+   */
+  void
+  run(float deltaTime);
+
+  /**
+   * @brief Detiene los hilos del pool (run() los vuelve a crear).
+   */
+  void
+  shutdown();
+
+  size_t
+  getNumSystems() const { return m_systems.size(); }
+
+  const std::string&
+  getSystemName(uint32_t system) const { return m_systems[system].name; }
+
+  /**
+   * @brief Sistemas que deben terminar antes de que empiece system.
+   */
+  const std::vector<uint32_t>&
+  getDependencies(uint32_t system);
+
+private:
+  struct ChunkRef {
+    Archetype* archetype;
+    size_t chunkIndex;
+  };
+
+  struct System {
+    std::string name;
+    ComponentMask reads;
+    ComponentMask writes;
+    SystemFn fn;
+    ChunkFn chunkFn;
+    std::vector<uint32_t> dependencies;  ///< Sistemas anteriores en conflicto.
+    std::vector<uint32_t> dependents;    ///< Sistemas que esperan a este.
+
+    // Estado del frame (protegido por m_mutex)
+    uint32_t dependenciesLeft;
+    uint32_t tasksLeft;
+    uint32_t numTasks;                   ///< Tareas despachadas (y buffers usados).
+    std::vector<ChunkRef> chunks;
+    std::vector<EU::TUniquePtr<CommandBuffer>> commands; ///< Uno por tarea; se reutilizan.
+  };
+
+  /**
+   * @brief Una tarea: el sistema entero o un rango de sus chunks.
+   */
+  struct Task {
+    uint32_t system;
+    uint32_t index;   ///< Orden de la tarea dentro del sistema (su CommandBuffer).
+    uint32_t begin;
+    uint32_t end;
+  };
+
+  uint32_t
+  registerSystem(System system);
+
+  /**
+   * @brief Reconstruye las aristas del grafo de dependencias.
+   */
+  void
+  buildGraph();
+
+  void
+  startWorkers();
+
+  void
+  workerLoop();
+
+  void
+  execute(const Task& task);
+
+  /**
+   * @brief Encola una tarea del sistema con su propio CommandBuffer.
+   */
+  void
+  pushTaskLocked(uint32_t system, uint32_t begin, uint32_t end);
+
+  // Las funciones *Locked se llaman con m_mutex tomado
+
+  /**
+   * @brief Encola las tareas del sistema (ya no tiene dependencias pendientes).
+   */
+  void
+  dispatchLocked(uint32_t system);
+
+  /**
+   * @brief Marca el sistema como terminado y despacha los que esperaban solo a él.
+   */
+  void
+  completeLocked(uint32_t system);
+
+  World& m_world;
+  uint32_t m_numWorkers;
+  std::vector<System> m_systems;
+  bool m_graphDirty = false;
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_signal;  ///< Hay tareas nuevas, un sistema terminó o hay que parar.
+  std::deque<Task> m_tasks;
+  uint32_t m_systemsLeft = 0;
+  float m_deltaTime = 0.0f;
+  bool m_stopping = false;
+};
@@ -1,16 +1,23 @@
 ﻿#pragma once
 #include "Prerequisites.h"
 #include "EngineUtilities\Vectors\Vector3.h"
+#include "EngineUtilities\Vectors\Quaternion.h"
 #include "Component.h"
 
 class 
-Transform : public Component{
+Transform final : public Component{
 public:
+  // Id de tipo en compilación para el World
+  static constexpr ComponentType TYPE_ID = TRANSFORM;
+
   // Constructor que inicializa posición, rotación y escala por defecto
   Transform() : position(), 
                 rotation(), 
+                orientation(), 
                 scale(), 
                 matrix(), 
+                dirty(true),
+                version(0),
                 Component(ComponentType::TRANSFORM) {}
 
   // Métodos para inicialización, actualización, renderizado y destrucción
@@ -18,7 +25,7 @@ public:
   void 
   init();
 
-  // Actualiza el estado del objeto Transform basado en el tiempo transcurrido
+  // Reconstruye la matriz solo si algún setter la marcó como sucia
   // @param deltaTime: Tiempo transcurrido desde la última actualización
   void 
   update(float deltaTime) override;
@@ -39,16 +46,35 @@ public:
 
   // Establece una nueva posición
   void 
-  setPosition(const EU::Vector3& newPos) { position = newPos; }
+  setPosition(const EU::Vector3& newPos) { 
+    position = newPos; 
+    dirty = true;
+  }
 
   // Métodos de acceso a los datos de rotación
   // Retorna la rotación actual
   const EU::Vector3&
   getRotation() const { return rotation; }
 
-  // Establece una nueva rotación
+  // Establece una nueva rotación (ángulos de Euler en radianes: pitch, yaw, roll)
   void 
-  setRotation(const EU::Vector3& newRot) { rotation = newRot; }
+  setRotation(const EU::Vector3& newRot) { 
+    rotation = newRot; 
+    orientation = EU::Quaternion::fromEuler(newRot);
+    dirty = true;
+  }
+
+  // Retorna la rotación como cuaternión (la que se usa para construir la matriz)
+  const EU::Quaternion&
+  getOrientation() const { return orientation; }
+
+  // Establece la rotación a partir de un cuaternión; los ángulos de Euler se derivan de él
+  void 
+  setOrientation(const EU::Quaternion& newOrientation) { 
+    orientation = newOrientation.normalize();
+    rotation = orientation.toEuler();
+    dirty = true;
+  }
 
   // Métodos de acceso a los datos de escala
   // Retorna la escala actual
@@ -57,7 +83,10 @@ public:
 
   // Establece una nueva escala
   void 
-  setScale(const EU::Vector3& newScale) { scale = newScale; }
+  setScale(const EU::Vector3& newScale) { 
+    scale = newScale; 
+    dirty = true;
+  }
 
   void
   setTransform(const EU::Vector3& newPos, 
@@ -69,11 +98,25 @@ public:
   void 
   translate(const EU::Vector3& translation);
 
+  // Matriz de transformación cacheada (la del último update)
+  const XMMATRIX&
+  getMatrix() const { return matrix; }
+
+  // Indica si hay cambios que el próximo update debe aplicar a la matriz
+  bool
+  isDirty() const { return dirty; }
+
+  // Se incrementa cada vez que la matriz cambia; quien guarde el valor de la
+  // última vez (p. ej. el constant buffer del actor) sabe si debe actualizarse
+  uint32_t
+  getVersion() const { return version; }
+
 private:
   EU::Vector3 position;  // Posición del objeto
-  EU::Vector3 rotation;  // Rotación del objeto
+  EU::Vector3 rotation;  // Rotación del objeto (Euler, para el editor)
+  EU::Quaternion orientation; // Rotación del objeto (cuaternión)
   EU::Vector3 scale;     // Escala del objeto
-
-public:
-  XMMATRIX matrix;    // Matriz de transformación
-};
\ No newline at end of file
+  XMMATRIX matrix;       // Matriz de transformación
+  bool dirty;            // Algún setter cambió datos desde el último update
+  uint32_t version;      // Número de veces que se ha reconstruido la matriz
+};
@@ -0,0 +1,174 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "EngineUtilities\Vectors\Vector3.h"
+#include "EngineUtilities\Vectors\Quaternion.h"
+#include "EngineUtilities\Matrix\Matrix4x4.h"
+
+/**
+ * @brief Posición de un nodo dentro de los arreglos de TransformHierarchy.
+ *        Solo se usa como tipo del TSlotMap (y para que sus handles no se
+ *        mezclen con los de otros mapas).
+ */
+struct TransformNodeSlot {
+  uint32_t index;
+};
+
+using TransformNodeId = EU::TSlotHandle<TransformNodeSlot>;
+
+/**
+ * @class TransformHierarchy
+ * @brief Jerarquía padre/hijo de transformaciones guardada en SoA.
+ *
+ * Los nodos se guardan en orden de profundidad (cada padre antes que su
+ * subárbol, y el subárbol contiguo), así que el update recorre los arreglos
+ * una sola vez y de forma lineal: cuando llega a un nodo, la matriz mundial
+ * de su padre ya está calculada. Cada campo vive en su propio arreglo
+ * (posición, cuaternión, escala, matriz local, matriz mundial...).
+ *
+ * Los setters solo marcan el nodo como sucio; update() recompone la matriz
+ * local de los nodos sucios y la mundial de ellos y de sus descendientes, y
+ * no toca los subárboles que no cambiaron. El recorrido empieza en el primer
+ * nodo sucio. Cada vez que cambia la matriz mundial de un nodo se incrementa
+ * su versión, para que quien la copia (p. ej. un constant buffer) sepa si
+ * debe volver a subirla.
+ *
+ * Las matrices mundiales son relativas al dueño de la jerarquía (para un
+ * actor, el espacio del modelo); su Transform se aplica encima.
+ *
+ * Los nodos se identifican con handles estables: los índices cambian al
+ * reordenar, los handles no. Crear nodos en orden de profundidad (como hace
+ * el cargador) no reordena nada; reparentar o crear un hijo de un nodo que
+ * no es el último subárbol reordena los arreglos en el siguiente update.
+ */
+class
+TransformHierarchy {
+public:
+  TransformHierarchy() = default;
+
+  /**
+   * @brief Crea un nodo como último hijo de parent (o como raíz si parent
+   *        es nulo) con la transformación local dada.
+   */
+  TransformNodeId
+  createNode(TransformNodeId parent = TransformNodeId(),
+             const EU::Vector3& position = EU::Vector3(0.0f, 0.0f, 0.0f),
+             const EU::Quaternion& orientation = EU::Quaternion(),
+             const EU::Vector3& scale = EU::Vector3(1.0f, 1.0f, 1.0f));
+
+  /**
+   * @brief Destruye el nodo y todo su subárbol. Ignora handles ya destruidos.
+   */
+  void
+  destroyNode(TransformNodeId node);
+
+  /**
+   * @brief Mueve el nodo (con su subárbol) bajo parent, o a la raíz si parent
+   *        es nulo. La transformación local se conserva.
+   */
+  void
+  setParent(TransformNodeId node, TransformNodeId parent);
+
+  /**
+   * @brief Padre del nodo (nulo si es raíz).
+   */
+  TransformNodeId
+  getParent(TransformNodeId node) const;
+
+  bool
+  isValid(TransformNodeId node) const { return m_indexOf.Contains(node); }
+
+  size_t
+  getNumNodes() const { return m_id.Num(); }
+
+  /**
+   * @brief Elimina todos los nodos.
+   */
+  void
+  clear();
+
+  void
+  setLocalTransform(TransformNodeId node,
+                    const EU::Vector3& position,
+                    const EU::Quaternion& orientation,
+                    const EU::Vector3& scale);
+
+  void
+  setLocalPosition(TransformNodeId node, const EU::Vector3& position);
+
+  void
+  setLocalOrientation(TransformNodeId node, const EU::Quaternion& orientation);
+
+  void
+  setLocalScale(TransformNodeId node, const EU::Vector3& scale);
+
+  const EU::Vector3&
+  getLocalPosition(TransformNodeId node) const { return m_position[indexOf(node)]; }
+
+  const EU::Quaternion&
+  getLocalOrientation(TransformNodeId node) const { return m_orientation[indexOf(node)]; }
+
+  const EU::Vector3&
+  getLocalScale(TransformNodeId node) const { return m_scale[indexOf(node)]; }
+
+  /**
+   * @brief Matriz local del último update.
+   */
+  const EU::Matrix4x4&
+  getLocalMatrix(TransformNodeId node) const { return m_local[indexOf(node)]; }
+
+  /**
+   * @brief Matriz mundial (local * mundial del padre) del último update.
+   */
+  const EU::Matrix4x4&
+  getWorldMatrix(TransformNodeId node) const { return m_world[indexOf(node)]; }
+
+  /**
+   * @brief Se incrementa cada vez que update() cambia la matriz mundial del nodo.
+   */
+  uint32_t
+  getWorldVersion(TransformNodeId node) const { return m_worldVersion[indexOf(node)]; }
+
+  /**
+   * @brief Recalcula las matrices de los nodos sucios y de sus subárboles.
+   *        No hace nada si ningún nodo cambió.
+   */
+  void
+  update();
+
+private:
+  static constexpr uint32_t NONE = ~uint32_t(0);
+
+  uint32_t
+  indexOf(TransformNodeId node) const { return m_indexOf.GetUnchecked(node).index; }
+
+  /**
+   * @brief Marca el nodo del índice dado para recomponer su matriz local.
+   */
+  void
+  markDirty(uint32_t index);
+
+  /**
+   * @brief Reordena los arreglos en orden de profundidad si algún cambio
+   *        estructural lo rompió, y recalcula padres, tamaños de subárbol e
+   *        índices de los handles.
+   */
+  void
+  ensureOrder();
+
+  // Todos los arreglos tienen un elemento por nodo, en orden de profundidad
+  EU::TArray<TransformNodeId> m_id;      ///< Handle de cada índice.
+  EU::TArray<uint32_t> m_parent;         ///< Índice del padre (NONE si es raíz).
+  EU::TArray<uint32_t> m_subtreeSize;    ///< Nodos del subárbol, contando el propio.
+  EU::TArray<EU::Vector3> m_position;    ///< Posición local.
+  EU::TArray<EU::Quaternion> m_orientation; ///< Rotación local.
+  EU::TArray<EU::Vector3> m_scale;       ///< Escala local.
+  EU::TArray<EU::Matrix4x4> m_local;     ///< Matriz local cacheada.
+  EU::TArray<EU::Matrix4x4> m_world;     ///< Matriz mundial cacheada.
+  EU::TArray<uint32_t> m_worldVersion;   ///< Versión de la matriz mundial.
+  EU::TArray<uint8_t> m_localDirty;      ///< La matriz local debe recomponerse.
+  EU::TArray<uint8_t> m_worldChanged;    ///< Temporal del update: la mundial cambió.
+
+  EU::TSlotMap<TransformNodeSlot> m_indexOf; ///< Handle -> índice actual.
+  uint32_t m_firstDirty = NONE;          ///< Menor índice sucio (NONE si ninguno).
+  bool m_orderDirty = false;             ///< Un cambio estructural rompió el orden.
+};
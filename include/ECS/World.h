@@ -0,0 +1,430 @@
+﻿#pragma once
+#include "Prerequisites.h"
+#include "ECS\Archetype.h"
+#include <functional>
+
+/**
+ * @brief Dónde vive una entidad: su arquetipo, su fila dentro de él y qué
+ *        componentes tiene (copia de la máscara del arquetipo, para
+ *        consultarla sin seguir el puntero).
+ */
+struct EntityRecord {
+  Archetype* archetype;
+  uint32_t row;
+  ComponentMask mask;
+};
+
+template<typename... Ts>
+class Query;
+
+/**
+ * @class World
+ * @brief Contenedor de entidades y componentes organizado por arquetipos.
+ *
+ * Cada entidad pertenece al arquetipo de su conjunto exacto de componentes;
+ * añadir o quitar un componente la mueve al arquetipo vecino (las aristas
+ * entre arquetipos se cachean, así que el cambio no busca en toda la lista).
+ * Los componentes se guardan por valor y contiguos por tipo, y se recorren
+ * con consultas (query/each) sin llamadas virtuales ni búsquedas por entidad.
+ *
+ * Cada componente guarda el tick en que se añadió y el de su última
+ * escritura, así que un sistema puede pedir solo las entidades que cambiaron
+ * (Query::changed/added) y los observadores (onAdded/onChanged/onRemoved)
+ * reaccionan a los cambios sin recorrer todo el mundo cada frame.
+ *
+ * No es seguro entre hilos: los cambios estructurales (crear, destruir,
+ * añadir o quitar componentes) deben hacerse desde un solo hilo y nunca
+ * dentro de un recorrido.
+ */
+class
+World {
+public:
+  /**
+   * @brief Momento de la vida de un componente del que avisan los observadores.
+   */
+  enum class ComponentEvent : uint8_t {
+    Added,    ///< Al añadirse a una entidad (en el momento).
+    Changed,  ///< Añadido o escrito desde el tick anterior (en advanceTick).
+    Removed   ///< Antes de quitarse o de destruir la entidad (en el momento).
+  };
+
+  /**
+   * @brief Función de un observador: la entidad y su componente del tipo observado.
+   */
+  using ObserverFn = std::function<void(EntityId entity, void* component)>;
+
+  /**
+   * @brief Identificador de un observador para quitarlo; 0 no es válido.
+   */
+  using ObserverId = uint32_t;
+
+  World();
+
+  /**
+   * @brief Destruye todas las entidades y sus componentes.
+   */
+  ~World();
+
+  World(const World&) = delete;
+  World& operator=(const World&) = delete;
+
+  /**
+   * @brief Crea una entidad sin componentes.
+   */
+  EntityId
+  createEntity();
+
+  /**
+   * @brief Destruye la entidad y sus componentes. Ignora ids ya destruidos.
+   */
+  void
+  destroyEntity(EntityId entity);
+
+  bool
+  isAlive(EntityId entity) const { return m_entities.Contains(entity); }
+
+  size_t
+  getNumEntities() const { return m_entities.Num(); }
+
+  /**
+   * @brief Añade un componente T construido con args (o lo reemplaza si ya
+   *        lo tenía) y devuelve una referencia a él.
+   *
+   * La referencia deja de ser válida con el siguiente cambio estructural.
+   */
+  template<typename T, typename... Args>
+  T&
+  addComponent(EntityId entity, Args&&... args) {
+    EntityRecord* record = m_entities.Get(entity);
+    assert(record && "World::addComponent: entity is not alive");
+
+    const ComponentTypeInfo& info = getComponentTypeInfo<T>();
+    if (record->mask & componentMask<T>()) {
+      Archetype& archetype = *record->archetype;
+      const int column = archetype.findColumn(info.id);
+      T* component = static_cast<T*>(archetype.getComponentData(record->row, column));
+      *component = T(std::forward<Args>(args)...);
+      archetype.markRowChanged(record->row, column, m_changeTick);
+      return *component;
+    }
+
+    // Se construye antes de mover la entidad: si el constructor lanza, no
+    // queda una fila con el componente sin construir
+    T value(std::forward<Args>(args)...);
+    Archetype* target = getArchetypeWith(record->archetype, info);
+    moveEntity(*record, target);
+    const int column = target->findColumn(info.id);
+    T* component = ::new (target->getComponentData(record->row, column)) T(std::move(value));
+    target->markRowAdded(record->row, column, m_changeTick);
+    notify(ComponentEvent::Added, info.id, entity, component);
+    return *component;
+  }
+
+  /**
+   * @brief Versión sin tipo de addComponent: mueve *value (un componente del
+   *        tipo de info) a la entidad. El llamador sigue siendo dueño de
+   *        value y debe destruirlo.
+   * @return false si la entidad ya no existe.
+   */
+  bool
+  addComponentMoved(EntityId entity, const ComponentTypeInfo& info, void* value);
+
+  /**
+   * @brief Quita el componente T de la entidad.
+   * @return false si la entidad no existe o no lo tenía.
+   */
+  template<typename T>
+  bool
+  removeComponent(EntityId entity) {
+    return removeComponent(entity, componentTypeId<T>());
+  }
+
+  bool
+  removeComponent(EntityId entity, ComponentTypeId type);
+
+  /**
+   * @brief Componente T de una entidad viva que lo tiene (se comprueba con
+   *        assert). Sin búsquedas ni saltos: ranura -> registro -> columna
+   *        por id de compilación -> dirección.
+   *
+   * La referencia no es propietaria y deja de ser válida con el siguiente
+   * cambio estructural.
+   */
+  template<typename T>
+  T&
+  getComponent(EntityId entity) {
+    EntityRecord& record = m_entities.GetUnchecked(entity);
+    assert((record.mask & componentMask<T>()) && "World::getComponent: entity does not have this component");
+    Archetype& archetype = *record.archetype;
+    return *static_cast<T*>(archetype.getComponentData(record.row, archetype.findColumn(componentTypeId<T>())));
+  }
+
+  /**
+   * @brief Componente T de la entidad, o nullptr si no lo tiene o no existe.
+   */
+  template<typename T>
+  T*
+  tryGetComponent(EntityId entity) {
+    EntityRecord* record = m_entities.Get(entity);
+    if (!record || !(record->mask & componentMask<T>())) {
+      return nullptr;
+    }
+    return static_cast<T*>(record->archetype->getComponentData(
+      record->row, record->archetype->findColumn(componentTypeId<T>())));
+  }
+
+  template<typename T>
+  bool
+  hasComponent(EntityId entity) const {
+    const EntityRecord* record = m_entities.Get(entity);
+    return record && (record->mask & componentMask<T>());
+  }
+
+  /**
+   * @brief Marca el componente T de la entidad como escrito en el tick
+   *        actual. Hace falta cuando se modifica por una referencia de
+   *        getComponent o de una consulta sin writes<T>(); addComponent ya
+   *        lo marca.
+   */
+  template<typename T>
+  void
+  markChanged(EntityId entity) {
+    EntityRecord& record = m_entities.GetUnchecked(entity);
+    assert((record.mask & componentMask<T>()) && "World::markChanged: entity does not have this component");
+    record.archetype->markRowChanged(record.row, record.archetype->findColumn(componentTypeId<T>()), m_changeTick);
+  }
+
+  /**
+   * @brief Tick de la última escritura del componente T de la entidad.
+   */
+  template<typename T>
+  uint32_t
+  getChangedTick(EntityId entity) const {
+    const EntityRecord& record = m_entities.GetUnchecked(entity);
+    assert((record.mask & componentMask<T>()) && "World::getChangedTick: entity does not have this component");
+    return record.archetype->getRowChangeTick(record.row, record.archetype->findColumn(componentTypeId<T>()));
+  }
+
+  /**
+   * @brief Tick en que se añadió el componente T a la entidad.
+   */
+  template<typename T>
+  uint32_t
+  getAddedTick(EntityId entity) const {
+    const EntityRecord& record = m_entities.GetUnchecked(entity);
+    assert((record.mask & componentMask<T>()) && "World::getAddedTick: entity does not have this component");
+    return record.archetype->getRowAddedTick(record.row, record.archetype->findColumn(componentTypeId<T>()));
+  }
+
+  /**
+   * @brief Registra fn(EntityId, T&) para cuando se añade un T a una entidad.
+   *
+   * Los observadores no deben hacer cambios estructurales ni quitar
+   * observadores: lo que necesiten cambiar se graba en un CommandBuffer.
+   */
+  template<typename T, typename Fn>
+  ObserverId
+  onAdded(Fn fn) {
+    return addObserver(ComponentEvent::Added, componentTypeId<T>(), makeObserver<T>(std::move(fn)));
+  }
+
+  /**
+   * @brief Registra fn(EntityId, T&) para cada T añadido o escrito desde el
+   *        tick anterior. Se llama en advanceTick, una vez por entidad
+   *        aunque se escribiera varias veces.
+   */
+  template<typename T, typename Fn>
+  ObserverId
+  onChanged(Fn fn) {
+    return addObserver(ComponentEvent::Changed, componentTypeId<T>(), makeObserver<T>(std::move(fn)));
+  }
+
+  /**
+   * @brief Registra fn(EntityId, T&) para justo antes de quitar un T
+   *        (removeComponent o destroyEntity); el componente sigue siendo válido.
+   */
+  template<typename T, typename Fn>
+  ObserverId
+  onRemoved(Fn fn) {
+    return addObserver(ComponentEvent::Removed, componentTypeId<T>(), makeObserver<T>(std::move(fn)));
+  }
+
+  /**
+   * @brief Versión sin tipo de onAdded/onChanged/onRemoved.
+   */
+  ObserverId
+  addObserver(ComponentEvent event, ComponentTypeId type, ObserverFn fn);
+
+  /**
+   * @brief Quita un observador. Ignora ids que ya no existen.
+   */
+  void
+  removeObserver(ObserverId id);
+
+  /**
+   * @brief Activa o desactiva la entidad (quita o añade la etiqueta Disabled).
+   */
+  void
+  setEnabled(EntityId entity, bool enabled) {
+    if (enabled) {
+      removeComponent<Disabled>(entity);
+    }
+    else if (!hasComponent<Disabled>(entity)) {
+      addComponent<Disabled>(entity);
+    }
+  }
+
+  bool
+  isEnabled(EntityId entity) const { return !hasComponent<Disabled>(entity); }
+
+  /**
+   * @brief Consulta de las entidades con todos los tipos Ts (ver Query). El
+   *        emparejamiento con arquetipos se cachea en el mundo.
+   */
+  template<typename... Ts>
+  Query<Ts...>
+  query();
+
+  /**
+   * @brief Atajo de query<Ts...>().each(fn): fn(Ts&...) o fn(EntityId, Ts&...)
+   *        para cada entidad activa con todos los tipos Ts.
+   */
+  template<typename... Ts, typename Fn>
+  void
+  each(Fn&& fn);
+
+  /**
+   * @brief Llama a fn(T&) para cada componente T de las entidades activas.
+   *
+   * Recorre arreglos contiguos de T; si T es final, las llamadas a sus
+   * métodos virtuales dentro de fn se resuelven en compilación.
+   */
+  template<typename T, typename Fn>
+  void
+  forEach(Fn&& fn) {
+    each<T>(std::forward<Fn>(fn));
+  }
+
+  /**
+   * @brief Tick actual: lo que se escribe ahora queda marcado con él.
+   */
+  uint32_t
+  getChangeTick() const { return m_changeTick; }
+
+  /**
+   * @brief Cierra el tick actual y empieza otro (una vez por frame).
+   *
+   * Antes avisa a los observadores onChanged de los componentes añadidos o
+   * escritos durante el tick; solo revisa los chunks cuyo tick cambió. Un
+   * sistema que guarda el tick de su última ejecución puede pedir solo lo que
+   * cambió desde él.
+   */
+  void
+  advanceTick();
+
+  const EU::TArray<Archetype*>&
+  getArchetypes() const { return m_archetypes; }
+
+private:
+  template<typename... Ts>
+  friend class Query;
+
+  /**
+   * @brief Arquetipos que tienen todos los tipos de required y ninguno de
+   *        excluded, ya calculados.
+   */
+  struct QueryCache {
+    ComponentMask required;
+    ComponentMask excluded;
+    EU::TArray<Archetype*> archetypes;
+    size_t numChecked;                  ///< Arquetipos de m_archetypes ya revisados.
+  };
+
+  struct Observer {
+    ObserverId id;
+    ComponentEvent event;
+    ComponentTypeId type;
+    ObserverFn fn;
+  };
+
+  template<typename T, typename Fn>
+  static ObserverFn
+  makeObserver(Fn fn) {
+    return [fn = std::move(fn)](EntityId entity, void* component) mutable {
+      fn(entity, *static_cast<T*>(component));
+    };
+  }
+
+  /**
+   * @brief Llama a los observadores de event para el tipo type, si hay alguno.
+   */
+  void
+  notify(ComponentEvent event, ComponentTypeId type, EntityId entity, void* component) {
+    if ((m_observedTypes[int(event)] >> type) & 1) {
+      notifyObservers(event, type, entity, component);
+    }
+  }
+
+  void
+  notifyObservers(ComponentEvent event, ComponentTypeId type, EntityId entity, void* component);
+
+  /**
+   * @brief Avisa a los observadores onChanged de lo escrito después de
+   *        m_notifiedTick.
+   */
+  void
+  notifyChanged();
+
+  /**
+   * @brief Índice de la caché de (required, excluded), creándola si no existe.
+   */
+  uint32_t
+  findOrCreateQueryCache(ComponentMask required, ComponentMask excluded);
+
+  /**
+   * @brief Arquetipos de la caché, revisando solo los creados desde la
+   *        última llamada (los arquetipos nunca se borran).
+   */
+  const EU::TArray<Archetype*>&
+  getMatchingArchetypes(uint32_t cacheIndex);
+
+  /**
+   * @brief Arquetipo con los tipos de from más info (sigue o crea la arista).
+   */
+  Archetype*
+  getArchetypeWith(Archetype* from, const ComponentTypeInfo& info);
+
+  /**
+   * @brief Arquetipo con los tipos de from menos id (sigue o crea la arista).
+   */
+  Archetype*
+  getArchetypeWithout(Archetype* from, ComponentTypeId id);
+
+  /**
+   * @brief Devuelve el arquetipo de exactamente esos tipos (ordenados por id),
+   *        creándolo si no existe.
+   */
+  Archetype*
+  findOrCreateArchetype(const EU::TArray<const ComponentTypeInfo*>& types);
+
+  /**
+   * @brief Mueve la entidad de record a target: los componentes comunes se
+   *        mueven con sus ticks, los que target no tiene se destruyen y los
+   *        nuevos quedan sin construir ni marcar. Actualiza record y la
+   *        entidad que ocupe su hueco.
+   */
+  void
+  moveEntity(EntityRecord& record, Archetype* target);
+
+  EU::TSlotMap<EntityRecord> m_entities;
+  EU::TArray<Archetype*> m_archetypes;  ///< Propiedad del mundo; el primero es el vacío.
+  EU::TMap<ComponentMask, Archetype*> m_archetypeByMask;
+  EU::TArray<QueryCache> m_queryCaches;  ///< Pocas: se buscan en orden.
+  uint32_t m_changeTick = 1;             ///< 0 queda para "nunca".
+  uint32_t m_notifiedTick = 0;           ///< Último tick avisado a onChanged.
+  EU::TArray<Observer> m_observers;
+  ComponentMask m_observedTypes[3] = {}; ///< Por evento, tipos con algún observador.
+  ObserverId m_nextObserverId = 1;
+};
+
+#include "ECS\Query.h"
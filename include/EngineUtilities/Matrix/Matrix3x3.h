@@ -43,11 +43,10 @@ namespace EU {
      *
      * Initializes the matrix to the identity matrix.
      */
-    Matrix3x3() {
-      m[0][0] = 1; m[0][1] = 0; m[0][2] = 0;
-      m[1][0] = 0; m[1][1] = 1; m[1][2] = 0;
-      m[2][0] = 0; m[2][1] = 0; m[2][2] = 1;
-    }
+    constexpr Matrix3x3()
+      : m{ { 1, 0, 0 },
+           { 0, 1, 0 },
+           { 0, 0, 1 } } {}
 
     /**
      * @brief Parameterized constructor.
@@ -64,11 +63,10 @@ namespace EU {
      * @param a32 Element at row 3, column 2.
      * @param a33 Element at row 3, column 3.
      */
-    Matrix3x3(float a11, float a12, float a13, float a21, float a22, float a23, float a31, float a32, float a33) {
-      m[0][0] = a11; m[0][1] = a12; m[0][2] = a13;
-      m[1][0] = a21; m[1][1] = a22; m[1][2] = a23;
-      m[2][0] = a31; m[2][1] = a32; m[2][2] = a33;
-    }
+    constexpr Matrix3x3(float a11, float a12, float a13, float a21, float a22, float a23, float a31, float a32, float a33)
+      : m{ { a11, a12, a13 },
+           { a21, a22, a23 },
+           { a31, a32, a33 } } {}
 
     /**
      * @brief Adds another matrix to this matrix.
@@ -76,7 +74,7 @@ namespace EU {
      * @param other The matrix to add.
      * @return The result of the addition.
      */
-    Matrix3x3 operator+(const Matrix3x3& other) const {
+    constexpr Matrix3x3 operator+(const Matrix3x3& other) const {
       return Matrix3x3(
         m[0][0] + other.m[0][0], m[0][1] + other.m[0][1], m[0][2] + other.m[0][2],
         m[1][0] + other.m[1][0], m[1][1] + other.m[1][1], m[1][2] + other.m[1][2],
@@ -90,7 +88,7 @@ namespace EU {
      * @param other The matrix to subtract.
      * @return The result of the subtraction.
      */
-    Matrix3x3 operator-(const Matrix3x3& other) const {
+    constexpr Matrix3x3 operator-(const Matrix3x3& other) const {
       return Matrix3x3(
         m[0][0] - other.m[0][0], m[0][1] - other.m[0][1], m[0][2] - other.m[0][2],
         m[1][0] - other.m[1][0], m[1][1] - other.m[1][1], m[1][2] - other.m[1][2],
@@ -104,7 +102,7 @@ namespace EU {
      * @param other The matrix to multiply by.
      * @return The result of the multiplication.
      */
-    Matrix3x3 operator*(const Matrix3x3& other) const {
+    constexpr Matrix3x3 operator*(const Matrix3x3& other) const {
       return Matrix3x3(
         m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0] + m[0][2] * other.m[2][0], m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1] + m[0][2] * other.m[2][1], m[0][0] * other.m[0][2] + m[0][1] * other.m[1][2] + m[0][2] * other.m[2][2],
         m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0] + m[1][2] * other.m[2][0], m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1] + m[1][2] * other.m[2][1], m[1][0] * other.m[0][2] + m[1][1] * other.m[1][2] + m[1][2] * other.m[2][2],
@@ -118,7 +116,7 @@ namespace EU {
      * @param scalar The scalar to multiply by.
      * @return The result of the multiplication.
      */
-    Matrix3x3 operator*(float scalar) const {
+    constexpr Matrix3x3 operator*(float scalar) const {
       return Matrix3x3(
         m[0][0] * scalar, m[0][1] * scalar, m[0][2] * scalar,
         m[1][0] * scalar, m[1][1] * scalar, m[1][2] * scalar,
@@ -131,7 +129,7 @@ namespace EU {
      *
      * @return The determinant of the matrix.
      */
-    float determinant() const {
+    constexpr float determinant() const {
       return m[0][0] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])
         - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
         + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
@@ -142,7 +140,7 @@ namespace EU {
      *
      * @return The inverse of the matrix.
      */
-    Matrix3x3 inverse() const {
+    constexpr Matrix3x3 inverse() const {
       float det = determinant();
       if (det == 0) {
         // Handle non-invertible matrix gracefully.
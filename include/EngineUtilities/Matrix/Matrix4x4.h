@@ -27,37 +27,39 @@
  * SOFTWARE.
 */
 #pragma once
+
+#include "EngineUtilities/Utilities/SIMD.h"
+#include "EngineUtilities/Vectors/Vector3.h"
+#include "EngineUtilities/Vectors/Vector4.h"
+#include "EngineUtilities/Vectors/Quaternion.h"
 namespace EU {
   /**
  * @brief A 4x4 matrix class.
  *
  * This class represents a 4x4 matrix and provides basic matrix operations such as
  * addition, subtraction, multiplication, determinant calculation, and inversion.
+ *
+ * The layout is row-major with row vectors (v' = v * M), the same convention
+ * as XMMATRIX, so a Matrix4x4 can be copied into a constant buffer as is.
+ * Each row is 16-byte aligned and processed as one SIMD::Float4.
+ *
+ * Everything except the inverses and decompose() is constexpr: during constant
+ * evaluation the operators take a scalar path instead of the intrinsics.
  */
-  class Matrix4x4 {
+  class EU_ALIGN16 Matrix4x4 {
   public:
     float m[4][4]; /**< The elements of the matrix. */
 
-    // Default constructor initializes to identity matrix
-    Matrix4x4() {
-      for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-          m[i][j] = (i == j) ? 1.0f : 0.0f;
-        }
-      }
-    }
-
     /**
      * @brief Default constructor.
      *
      * Initializes the matrix to the identity matrix.
      */
-    Matrix4x4() {
-      m[0][0] = 1; m[0][1] = 0; m[0][2] = 0; m[0][3] = 0;
-      m[1][0] = 0; m[1][1] = 1; m[1][2] = 0; m[1][3] = 0;
-      m[2][0] = 0; m[2][1] = 0; m[2][2] = 1; m[2][3] = 0;
-      m[3][0] = 0; m[3][1] = 0; m[3][2] = 0; m[3][3] = 1;
-    }
+    constexpr Matrix4x4()
+      : m{ { 1, 0, 0, 0 },
+           { 0, 1, 0, 0 },
+           { 0, 0, 1, 0 },
+           { 0, 0, 0, 1 } } {}
 
 
     /**
@@ -82,23 +84,37 @@ namespace EU {
      * @param a43 Element at row 4, column 3.
      * @param a44 Element at row 4, column 4.
      */
-    Matrix4x4(float a11, float a12, float a13, float a14,
+    constexpr Matrix4x4(float a11, float a12, float a13, float a14,
       float a21, float a22, float a23, float a24,
       float a31, float a32, float a33, float a34,
-      float a41, float a42, float a43, float a44) {
-      m[0][0] = a11; m[0][1] = a12; m[0][2] = a13; m[0][3] = a14;
-      m[1][0] = a21; m[1][1] = a22; m[1][2] = a23; m[1][3] = a24;
-      m[2][0] = a31; m[2][1] = a32; m[2][2] = a33; m[2][3] = a34;
-      m[3][0] = a41; m[3][1] = a42; m[3][2] = a43; m[3][3] = a44;
+      float a41, float a42, float a43, float a44)
+      : m{ { a11, a12, a13, a14 },
+           { a21, a22, a23, a24 },
+           { a31, a32, a33, a34 },
+           { a41, a42, a43, a44 } } {}
+
+    /**
+     * @brief Builds a matrix from four SIMD rows.
+     */
+    Matrix4x4(SIMD::Float4 r0, SIMD::Float4 r1, SIMD::Float4 r2, SIMD::Float4 r3) {
+      SIMD::storeAligned(m[0], r0);
+      SIMD::storeAligned(m[1], r1);
+      SIMD::storeAligned(m[2], r2);
+      SIMD::storeAligned(m[3], r3);
     }
 
     // Copy constructor
-    Matrix4x4(const Matrix4x4& other) {
-      for (int i = 0; i < 4; ++i) {
-        for (int j = 0; j < 4; ++j) {
-          m[i][j] = other.m[i][j];
-        }
-      }
+    constexpr Matrix4x4(const Matrix4x4& other) = default;
+
+    constexpr Matrix4x4& operator=(const Matrix4x4& other) = default;
+
+    /**
+     * @brief Loads one row into a SIMD register.
+     *
+     * @param i Row index (0-3).
+     */
+    SIMD::Float4 row(int i) const {
+      return SIMD::loadAligned4(m[i]);
     }
 
     /**
@@ -107,13 +123,18 @@ namespace EU {
      * @param other The matrix to add.
      * @return The result of the addition.
      */
-    Matrix4x4 operator+(const Matrix4x4& other) const {
-      return Matrix4x4(
-        m[0][0] + other.m[0][0], m[0][1] + other.m[0][1], m[0][2] + other.m[0][2], m[0][3] + other.m[0][3],
-        m[1][0] + other.m[1][0], m[1][1] + other.m[1][1], m[1][2] + other.m[1][2], m[1][3] + other.m[1][3],
-        m[2][0] + other.m[2][0], m[2][1] + other.m[2][1], m[2][2] + other.m[2][2], m[2][3] + other.m[2][3],
-        m[3][0] + other.m[3][0], m[3][1] + other.m[3][1], m[3][2] + other.m[3][2], m[3][3] + other.m[3][3]
-      );
+    constexpr Matrix4x4 operator+(const Matrix4x4& other) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        Matrix4x4 result(*this);
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            result.m[i][j] += other.m[i][j];
+          }
+        }
+        return result;
+      }
+      return Matrix4x4(SIMD::add(row(0), other.row(0)), SIMD::add(row(1), other.row(1)),
+                       SIMD::add(row(2), other.row(2)), SIMD::add(row(3), other.row(3)));
     }
 
     /**
@@ -122,13 +143,18 @@ namespace EU {
      * @param other The matrix to subtract.
      * @return The result of the subtraction.
      */
-    Matrix4x4 operator-(const Matrix4x4& other) const {
-      return Matrix4x4(
-        m[0][0] - other.m[0][0], m[0][1] - other.m[0][1], m[0][2] - other.m[0][2], m[0][3] - other.m[0][3],
-        m[1][0] - other.m[1][0], m[1][1] - other.m[1][1], m[1][2] - other.m[1][2], m[1][3] - other.m[1][3],
-        m[2][0] - other.m[2][0], m[2][1] - other.m[2][1], m[2][2] - other.m[2][2], m[2][3] - other.m[2][3],
-        m[3][0] - other.m[3][0], m[3][1] - other.m[3][1], m[3][2] - other.m[3][2], m[3][3] - other.m[3][3]
-      );
+    constexpr Matrix4x4 operator-(const Matrix4x4& other) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        Matrix4x4 result(*this);
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            result.m[i][j] -= other.m[i][j];
+          }
+        }
+        return result;
+      }
+      return Matrix4x4(SIMD::sub(row(0), other.row(0)), SIMD::sub(row(1), other.row(1)),
+                       SIMD::sub(row(2), other.row(2)), SIMD::sub(row(3), other.row(3)));
     }
 
     /**
@@ -137,36 +163,137 @@ namespace EU {
      * @param other The matrix to multiply by.
      * @return The result of the multiplication.
      */
-    Matrix4x4 operator*(const Matrix4x4& other) const {
-      return Matrix4x4(
-        m[0][0] * other.m[0][0] + m[0][1] * other.m[1][0] + m[0][2] * other.m[2][0] + m[0][3] * other.m[3][0],
-        m[0][0] * other.m[0][1] + m[0][1] * other.m[1][1] + m[0][2] * other.m[2][1] + m[0][3] * other.m[3][1],
-        m[0][0] * other.m[0][2] + m[0][1] * other.m[1][2] + m[0][2] * other.m[2][2] + m[0][3] * other.m[3][2],
-        m[0][0] * other.m[0][3] + m[0][1] * other.m[1][3] + m[0][2] * other.m[2][3] + m[0][3] * other.m[3][3],
+    constexpr Matrix4x4 operator*(const Matrix4x4& other) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        Matrix4x4 result(*this);
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = m[i][0] * other.m[0][j] + m[i][1] * other.m[1][j] +
+                             m[i][2] * other.m[2][j] + m[i][3] * other.m[3][j];
+          }
+        }
+        return result;
+      }
+
+      // Each result row is a linear combination of the rows of other,
+      // weighted by the corresponding row of this matrix: 16 madds total.
+      const SIMD::Float4 b0 = other.row(0);
+      const SIMD::Float4 b1 = other.row(1);
+      const SIMD::Float4 b2 = other.row(2);
+      const SIMD::Float4 b3 = other.row(3);
+
+      return Matrix4x4(combineRows(m[0], b0, b1, b2, b3), combineRows(m[1], b0, b1, b2, b3),
+                       combineRows(m[2], b0, b1, b2, b3), combineRows(m[3], b0, b1, b2, b3));
+    }
+
+    /**
+     * @brief Multiplies this matrix by a scalar.
+     *
+     * @param scalar The scalar to multiply by.
+     * @return The result of the multiplication.
+     */
+    constexpr Matrix4x4 operator*(float scalar) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        Matrix4x4 result(*this);
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            result.m[i][j] *= scalar;
+          }
+        }
+        return result;
+      }
+      const SIMD::Float4 s = SIMD::splat4(scalar);
+      return Matrix4x4(SIMD::mul(row(0), s), SIMD::mul(row(1), s),
+                       SIMD::mul(row(2), s), SIMD::mul(row(3), s));
+    }
 
-        m[1][0] * other.m[0][0] + m[1][1] * other.m[1][0] + m[1][2] * other.m[2][0] + m[1][3] * other.m[3][0],
-        m[1][0] * other.m[0][1] + m[1][1] * other.m[1][1] + m[1][2] * other.m[2][1] + m[1][3] * other.m[3][1],
-        m[1][0] * other.m[0][2] + m[1][1] * other.m[1][2] + m[1][2] * other.m[2][2] + m[1][3] * other.m[3][2],
-        m[1][0] * other.m[0][3] + m[1][1] * other.m[1][3] + m[1][2] * other.m[2][3] + m[1][3] * other.m[3][3],
+    /**
+     * @brief Transforms a 4D row vector (v * M).
+     *
+     * @param v The vector to transform.
+     * @return The transformed vector.
+     */
+    constexpr Vector4 transform(const Vector4& v) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return Vector4(v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + v.w * m[3][0],
+                       v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + v.w * m[3][1],
+                       v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + v.w * m[3][2],
+                       v.x * m[0][3] + v.y * m[1][3] + v.z * m[2][3] + v.w * m[3][3]);
+      }
+      SIMD::Float4 acc = SIMD::mul(SIMD::splat4(v.x), row(0));
+      acc = SIMD::madd(SIMD::splat4(v.y), row(1), acc);
+      acc = SIMD::madd(SIMD::splat4(v.z), row(2), acc);
+      return Vector4(SIMD::madd(SIMD::splat4(v.w), row(3), acc));
+    }
 
-        m[2][0] * other.m[0][0] + m[2][1] * other.m[1][0] + m[2][2] * other.m[2][0] + m[2][3] * other.m[3][0],
-        m[2][0] * other.m[0][1] + m[2][1] * other.m[1][1] + m[2][2] * other.m[2][1] + m[2][3] * other.m[3][1],
-        m[2][0] * other.m[0][2] + m[2][1] * other.m[1][2] + m[2][2] * other.m[2][2] + m[2][3] * other.m[3][2],
-        m[2][0] * other.m[0][3] + m[2][1] * other.m[1][3] + m[2][2] * other.m[2][3] + m[2][3] * other.m[3][3],
+    /**
+     * @brief Transforms a point (w = 1), ignoring the projective row.
+     *
+     * @param p The point to transform.
+     * @return The transformed point.
+     */
+    constexpr Vector3 transformPoint(const Vector3& p) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return Vector3(p.x * m[0][0] + p.y * m[1][0] + p.z * m[2][0] + m[3][0],
+                       p.x * m[0][1] + p.y * m[1][1] + p.z * m[2][1] + m[3][1],
+                       p.x * m[0][2] + p.y * m[1][2] + p.z * m[2][2] + m[3][2]);
+      }
+      SIMD::Float4 acc = SIMD::madd(SIMD::splat4(p.x), row(0), row(3));
+      acc = SIMD::madd(SIMD::splat4(p.y), row(1), acc);
+      Vector4 r(SIMD::madd(SIMD::splat4(p.z), row(2), acc));
+      return Vector3(r.x, r.y, r.z);
+    }
+
+    /**
+     * @brief Transforms a direction (w = 0), ignoring the translation.
+     *
+     * @param v The direction to transform.
+     * @return The transformed direction.
+     */
+    constexpr Vector3 transformVector(const Vector3& v) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return Vector3(v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0],
+                       v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1],
+                       v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2]);
+      }
+      SIMD::Float4 acc = SIMD::mul(SIMD::splat4(v.x), row(0));
+      acc = SIMD::madd(SIMD::splat4(v.y), row(1), acc);
+      Vector4 r(SIMD::madd(SIMD::splat4(v.z), row(2), acc));
+      return Vector3(r.x, r.y, r.z);
+    }
 
-        m[3][0] * other.m[0][0] + m[3][1] * other.m[1][0] + m[3][2] * other.m[2][0] + m[3][3] * other.m[3][0],
-        m[3][0] * other.m[0][1] + m[3][1] * other.m[1][1] + m[3][2] * other.m[2][1] + m[3][3] * other.m[3][1],
-        m[3][0] * other.m[0][2] + m[3][1] * other.m[1][2] + m[3][2] * other.m[2][2] + m[3][3] * other.m[3][2],
-        m[3][0] * other.m[0][3] + m[3][1] * other.m[1][3] + m[3][2] * other.m[2][3] + m[3][3] * other.m[3][3]
-      );
+    /**
+     * @brief Returns the transpose of the matrix.
+     *
+     * @return The transposed matrix.
+     */
+    constexpr Matrix4x4 transpose() const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        Matrix4x4 result(*this);
+        for (int i = 0; i < 4; ++i) {
+          for (int j = 0; j < 4; ++j) {
+            result.m[i][j] = m[j][i];
+          }
+        }
+        return result;
+      }
+      SIMD::Float4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+      SIMD::transpose4(r0, r1, r2, r3);
+      return Matrix4x4(r0, r1, r2, r3);
     }
 
+    /**
+     * @brief Returns a pointer to the matrix's data (16 row-major floats).
+     */
+    float* data() { return &m[0][0]; }
+    const float* data() const { return &m[0][0]; }
+
     /**
      * @brief Computes the determinant of the matrix.
      *
      * @return The determinant of the matrix.
      */
-    float determinant() const {
+    constexpr float determinant() const {
       return
         m[0][0] * (
           m[1][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
@@ -193,60 +320,247 @@ namespace EU {
     /**
      * @brief Computes the inverse of the matrix.
      *
-     * @return The inverse of the matrix.
-     */
-    
-    //Matrix4x4 inverse() const {
-    //  float det = determinant();
-    //  if (det == 0) {
-    //    // Return identity matrix for simplicity when the matrix is singular.
-    //    return Matrix4x4();
-    //  }
-
-    //  float invDet = 1.0f / det;
-
-    //  return Matrix4x4(
-    //    (m[1][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[1][2] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) +
-    //      m[1][3] * (m[2][1] * m[3][2] - m[2][2] * m[3][1])) * invDet,
-    //    -(m[0][1] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[0][2] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) +
-    //      m[0][3] * (m[2][1] * m[3][2] - m[2][2] * m[3][1])) * invDet,
-    //    (m[0][1] * (m[1][2] * m[3][3] - m[1][3] * m[3][2]) -
-    //      m[0][2] * (m[1][1] * m[3][3] - m[1][3] * m[3][1]) +
-    //      m[0][3] * (m[1][1] * m[3][2] - m[1][2] * m[3][1])) * invDet,
-    //    -(m[0][1] * (m[1][2] * m[2][3] - m[1][3] * m[2][2]) -
-    //      m[0][2] * (m[1][1] * m[2][3] - m[1][3] * m[2][1]) +
-    //      m[0][3] * (m[1][1] * m[2][2] - m[1][2] * m[2][1])) * invDet,
-
-    //    -(m[1][0] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[1][2] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[1][3] * (m[2][0] * m[3][2] - m[2][2] * m[3][0])) * invDet,
-    //    (m[0][0] * (m[2][2] * m[3][3] - m[2][3] * m[3][2]) -
-    //      m[0][2] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[0][3] * (m[2][0] * m[3][2] - m[2][2] * m[3][0])) * invDet,
-    //    -(m[0][0] * (m[1][2] * m[3][3] - m[1][3] * m[3][2]) -
-    //      m[0][2] * (m[1][0] * m[3][3] - m[1][3] * m[3][0]) +
-    //      m[0][3] * (m[1][0] * m[3][2] - m[1][2] * m[3][0])) * invDet,
-    //    (m[0][0] * (m[1][2] * m[2][3] - m[1][3] * m[2][2]) -
-    //      m[0][2] * (m[1][0] * m[2][3] - m[1][3] * m[2][0]) +
-    //      m[0][3] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])) * invDet,
-
-    //    (m[1][0] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) -
-    //      m[1][1] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[1][3] * (m[2][0] * m[3][1] - m[2][1] * m[3][0])) * invDet,
-    //    -(m[0][0] * (m[2][1] * m[3][3] - m[2][3] * m[3][1]) -
-    //      m[0][1] * (m[2][0] * m[3][3] - m[2][3] * m[3][0]) +
-    //      m[0][3] * (m[2][0] * m[3][1] - m[2][1] * m[3][0])) * invDet,
-    //    (m[0][0] * (m[1][1] * m[3][3] - m[1][3] * m[3][1]) -
-    //      m[0][1] * (m[1][0] * m[3][3] - m[1][3] * m[3][0]) +
-    //      m[0][3] * (m[1][0] * m[3][1] - m[1][1] * m[3][0])) * invDet,
-    //    -(m[0][0] * (m[1][1] * m[2][3] - m[1][3] * m[2][1]) -
-    //      m[0][1] * (m[1][0] * m[2][3] - m[1][3] * m[2][0]) +
-    //      m[0][3] * (m[1][0] * m[2][1] - m[1][1] * m[2][0])) * invDet
-    //  );
-    //}
+     * General 4x4 inverse using the 2x2 block cofactor method: the matrix is
+     * split into four 2x2 blocks A, B, C, D and the adjugate is assembled
+     * from their determinants and adjugate products, all in SIMD registers.
+     *
+     * @return The inverse of the matrix, or the identity if it is singular.
+     */
+    Matrix4x4 inverse() const {
+      const SIMD::Float4 r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+
+      // 2x2 sub-matrices stored row-major in one register each.
+      const SIMD::Float4 A = SIMD::shuffle<0, 1, 0, 1>(r0, r1);
+      const SIMD::Float4 B = SIMD::shuffle<2, 3, 2, 3>(r0, r1);
+      const SIMD::Float4 C = SIMD::shuffle<0, 1, 0, 1>(r2, r3);
+      const SIMD::Float4 D = SIMD::shuffle<2, 3, 2, 3>(r2, r3);
+
+      // (|A|, |B|, |C|, |D|)
+      const SIMD::Float4 detSub = SIMD::sub(
+        SIMD::mul(SIMD::shuffle<0, 2, 0, 2>(r0, r2), SIMD::shuffle<1, 3, 1, 3>(r1, r3)),
+        SIMD::mul(SIMD::shuffle<1, 3, 1, 3>(r0, r2), SIMD::shuffle<0, 2, 0, 2>(r1, r3)));
+      const SIMD::Float4 detA = SIMD::splatLane<0>(detSub);
+      const SIMD::Float4 detB = SIMD::splatLane<1>(detSub);
+      const SIMD::Float4 detC = SIMD::splatLane<2>(detSub);
+      const SIMD::Float4 detD = SIMD::splatLane<3>(detSub);
+
+      const SIMD::Float4 D_C = mat2AdjMul(D, C);
+      const SIMD::Float4 A_B = mat2AdjMul(A, B);
+      SIMD::Float4 X_ = SIMD::sub(SIMD::mul(detD, A), mat2Mul(B, D_C));
+      SIMD::Float4 W_ = SIMD::sub(SIMD::mul(detA, D), mat2Mul(C, A_B));
+      SIMD::Float4 Y_ = SIMD::sub(SIMD::mul(detB, C), mat2MulAdj(D, A_B));
+      SIMD::Float4 Z_ = SIMD::sub(SIMD::mul(detC, B), mat2MulAdj(A, D_C));
+
+      // |M| = |A||D| + |B||C| - tr((A#B)(D#C))
+      const float tr = SIMD::dot4(A_B, SIMD::shuffle<0, 2, 1, 3>(D_C, D_C));
+      const float detM = SIMD::getX(detA) * SIMD::getX(detD) +
+                         SIMD::getX(detB) * SIMD::getX(detC) - tr;
+      if (detM == 0.0f) {
+        // Return identity matrix for simplicity when the matrix is singular.
+        return Matrix4x4();
+      }
+
+      const float invDet = 1.0f / detM;
+      const SIMD::Float4 rDetM = SIMD::set4(invDet, -invDet, -invDet, invDet);
+      X_ = SIMD::mul(X_, rDetM);
+      Y_ = SIMD::mul(Y_, rDetM);
+      Z_ = SIMD::mul(Z_, rDetM);
+      W_ = SIMD::mul(W_, rDetM);
+
+      // Apply the final adjugate swizzle while scattering the blocks back to rows.
+      return Matrix4x4(SIMD::shuffle<3, 1, 3, 1>(X_, Y_),
+                       SIMD::shuffle<2, 0, 2, 0>(X_, Y_),
+                       SIMD::shuffle<3, 1, 3, 1>(Z_, W_),
+                       SIMD::shuffle<2, 0, 2, 0>(Z_, W_));
+    }
+
+    /**
+     * @brief Inverse of an affine transform without shear (scale * rotation * translation).
+     *
+     * Transposes the 3x3 part, divides by the squared row lengths to undo the
+     * scale and rotates the negated translation. Much cheaper than inverse().
+     *
+     * @return The inverse transform.
+     */
+    Matrix4x4 inverseAffine() const {
+      SIMD::Float4 c0 = row(0), c1 = row(1), c2 = row(2), c3 = SIMD::set4(0.0f, 0.0f, 0.0f, 1.0f);
+      SIMD::transpose4(c0, c1, c2, c3);
+
+      // Lane i holds the squared length of row i (the squared scale on that axis).
+      SIMD::Float4 sizeSqr = SIMD::mul(c0, c0);
+      sizeSqr = SIMD::madd(c1, c1, sizeSqr);
+      sizeSqr = SIMD::madd(c2, c2, sizeSqr);
+      const SIMD::Float4 one = SIMD::splat4(1.0f);
+      sizeSqr = SIMD::select(SIMD::cmpLt(sizeSqr, SIMD::splat4(1.0e-12f)), one, sizeSqr);
+      const SIMD::Float4 rSizeSqr = SIMD::div(one, sizeSqr);
+      c0 = SIMD::mul(c0, rSizeSqr);
+      c1 = SIMD::mul(c1, rSizeSqr);
+      c2 = SIMD::mul(c2, rSizeSqr);
+
+      return Matrix4x4(c0, c1, c2, inverseTranslation(c0, c1, c2));
+    }
+
+    /**
+     * @brief Inverse of a rigid transform (rotation * translation, unit scale).
+     *
+     * The rotation block is orthonormal, so its inverse is its transpose.
+     *
+     * @return The inverse transform.
+     */
+    Matrix4x4 inverseOrthonormal() const {
+      SIMD::Float4 c0 = row(0), c1 = row(1), c2 = row(2), c3 = SIMD::set4(0.0f, 0.0f, 0.0f, 1.0f);
+      SIMD::transpose4(c0, c1, c2, c3);
+      return Matrix4x4(c0, c1, c2, inverseTranslation(c0, c1, c2));
+    }
+
+    /**
+     * @brief Returns the identity matrix.
+     */
+    static constexpr Matrix4x4 identity() {
+      return Matrix4x4();
+    }
+
+    /**
+     * @brief Builds a translation matrix.
+     *
+     * @param t The translation.
+     */
+    static constexpr Matrix4x4 translation(const Vector3& t) {
+      Matrix4x4 result;
+      result.m[3][0] = t.x; result.m[3][1] = t.y; result.m[3][2] = t.z;
+      return result;
+    }
+
+    /**
+     * @brief Builds a scaling matrix.
+     *
+     * @param s The scale on each axis.
+     */
+    static constexpr Matrix4x4 scaling(const Vector3& s) {
+      Matrix4x4 result;
+      result.m[0][0] = s.x; result.m[1][1] = s.y; result.m[2][2] = s.z;
+      return result;
+    }
+
+    /**
+     * @brief Builds a rotation matrix from a unit quaternion.
+     *
+     * Same orientation as XMMatrixRotationQuaternion (row vectors).
+     *
+     * @param q The rotation (must be normalized).
+     */
+    static constexpr Matrix4x4 rotation(const Quaternion& q) {
+      return compose(Vector3(0, 0, 0), q, Vector3(1, 1, 1));
+    }
+
+    /**
+     * @brief Builds scale * rotation * translation in one pass.
+     *
+     * @param t The translation.
+     * @param q The rotation (must be normalized).
+     * @param s The scale.
+     * @return The composed transform.
+     */
+    static constexpr Matrix4x4 compose(const Vector3& t, const Quaternion& q, const Vector3& s) {
+      const float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+      const float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+      const float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+      return Matrix4x4(
+        s.x * (1.0f - 2.0f * (yy + zz)), s.x * 2.0f * (xy + wz), s.x * 2.0f * (xz - wy), 0.0f,
+        s.y * 2.0f * (xy - wz), s.y * (1.0f - 2.0f * (xx + zz)), s.y * 2.0f * (yz + wx), 0.0f,
+        s.z * 2.0f * (xz + wy), s.z * 2.0f * (yz - wx), s.z * (1.0f - 2.0f * (xx + yy)), 0.0f,
+        t.x, t.y, t.z, 1.0f);
+    }
+
+    /**
+     * @brief Splits an affine transform into translation, rotation and scale.
+     *
+     * Inverse of compose(). A negative determinant is folded into scale.x.
+     *
+     * @param t Receives the translation.
+     * @param q Receives the rotation as a unit quaternion.
+     * @param s Receives the scale.
+     * @return False if one of the axes has (near) zero scale; t and s are
+     *         still written and q is set to identity.
+     */
+    bool decompose(Vector3& t, Quaternion& q, Vector3& s) const {
+      t = Vector3(m[3][0], m[3][1], m[3][2]);
+
+      Vector3 r0(m[0][0], m[0][1], m[0][2]);
+      Vector3 r1(m[1][0], m[1][1], m[1][2]);
+      Vector3 r2(m[2][0], m[2][1], m[2][2]);
+      s = Vector3(r0.magnitude(), r1.magnitude(), r2.magnitude());
+      if (r0.cross(r1).dot(r2) < 0.0f) {
+        s.x = -s.x;
+      }
 
+      const float epsilon = 1.0e-6f;
+      if (EU::abs(s.x) < epsilon || EU::abs(s.y) < epsilon || EU::abs(s.z) < epsilon) {
+        q = Quaternion();
+        return false;
+      }
+
+      r0 = r0 * (1.0f / s.x);
+      r1 = r1 * (1.0f / s.y);
+      r2 = r2 * (1.0f / s.z);
 
+      // Shepperd's method: pick the largest diagonal term for stability.
+      const float trace = r0.x + r1.y + r2.z;
+      if (trace > 0.0f) {
+        const float k = 0.5f / EU::sqrt(trace + 1.0f);
+        q = Quaternion(0.25f / k, (r1.z - r2.y) * k, (r2.x - r0.z) * k, (r0.y - r1.x) * k);
+      }
+      else if (r0.x > r1.y && r0.x > r2.z) {
+        const float k = 0.5f / EU::sqrt(1.0f + r0.x - r1.y - r2.z);
+        q = Quaternion((r1.z - r2.y) * k, 0.25f / k, (r0.y + r1.x) * k, (r2.x + r0.z) * k);
+      }
+      else if (r1.y > r2.z) {
+        const float k = 0.5f / EU::sqrt(1.0f + r1.y - r0.x - r2.z);
+        q = Quaternion((r2.x - r0.z) * k, (r0.y + r1.x) * k, 0.25f / k, (r1.z + r2.y) * k);
+      }
+      else {
+        const float k = 0.5f / EU::sqrt(1.0f + r2.z - r0.x - r1.y);
+        q = Quaternion((r0.y - r1.x) * k, (r2.x + r0.z) * k, (r1.z + r2.y) * k, 0.25f / k);
+      }
+      q = q.normalize();
+      return true;
+    }
+
+  private:
+    // w[0] * b0 + w[1] * b1 + w[2] * b2 + w[3] * b3
+    static SIMD::Float4 combineRows(const float* w, SIMD::Float4 b0, SIMD::Float4 b1,
+                                    SIMD::Float4 b2, SIMD::Float4 b3) {
+      SIMD::Float4 acc = SIMD::mul(SIMD::splat4(w[0]), b0);
+      acc = SIMD::madd(SIMD::splat4(w[1]), b1, acc);
+      acc = SIMD::madd(SIMD::splat4(w[2]), b2, acc);
+      return SIMD::madd(SIMD::splat4(w[3]), b3, acc);
+    }
+
+    // 2x2 row-major helpers for inverse(); A# is the adjugate of A.
+    // A * B
+    static SIMD::Float4 mat2Mul(SIMD::Float4 a, SIMD::Float4 b) {
+      return SIMD::madd(a, SIMD::shuffle<0, 3, 0, 3>(b, b),
+                        SIMD::mul(SIMD::shuffle<1, 0, 3, 2>(a, a), SIMD::shuffle<2, 1, 2, 1>(b, b)));
+    }
+
+    // A# * B
+    static SIMD::Float4 mat2AdjMul(SIMD::Float4 a, SIMD::Float4 b) {
+      return SIMD::sub(SIMD::mul(SIMD::shuffle<3, 3, 0, 0>(a, a), b),
+                       SIMD::mul(SIMD::shuffle<1, 1, 2, 2>(a, a), SIMD::shuffle<2, 3, 0, 1>(b, b)));
+    }
+
+    // A * B#
+    static SIMD::Float4 mat2MulAdj(SIMD::Float4 a, SIMD::Float4 b) {
+      return SIMD::sub(SIMD::mul(a, SIMD::shuffle<3, 0, 3, 0>(b, b)),
+                       SIMD::mul(SIMD::shuffle<1, 0, 3, 2>(a, a), SIMD::shuffle<2, 1, 2, 1>(b, b)));
+    }
+
+    // -(t * L^-1) with w = 1, given the rows of the already inverted 3x3 block.
+    SIMD::Float4 inverseTranslation(SIMD::Float4 c0, SIMD::Float4 c1, SIMD::Float4 c2) const {
+      SIMD::Float4 t = SIMD::mul(SIMD::splat4(m[3][0]), c0);
+      t = SIMD::madd(SIMD::splat4(m[3][1]), c1, t);
+      t = SIMD::madd(SIMD::splat4(m[3][2]), c2, t);
+      return SIMD::sub(SIMD::set4(0.0f, 0.0f, 0.0f, 1.0f), t);
+    }
   };
 }
\ No newline at end of file
@@ -0,0 +1,335 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cassert>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "EngineUtilities/Structures/TArray.h"
+
+namespace EU {
+	/**
+	 * @brief Asignador lineal (bump allocator) para memoria temporal.
+	 *
+	 * Allocate solo alinea y avanza un cursor; Deallocate no hace nada y toda
+	 * la memoria se recupera de golpe con Reset() (normalmente al final de
+	 * cada frame). Si un bloque se llena se encadena otro del doble de
+	 * tamaño; en el siguiente Reset los bloques se fusionan en uno que cubre
+	 * todo lo usado, así tras unos frames la arena deja de pedir memoria.
+	 *
+	 * Los destructores de lo que se construye aquí no se ejecutan al hacer
+	 * Reset: usarla para datos triviales o para contenedores que se destruyan
+	 * antes del Reset.
+	 *
+	 * No es segura entre hilos; cada hilo usa la suya (ver GetFrameArena).
+	 */
+	class LinearArena
+	{
+	public:
+		static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+		explicit LinearArena(size_t InitialSize = DEFAULT_BLOCK_SIZE)
+			: Current(nullptr), Cursor(nullptr), End(nullptr), Used(0),
+			  LastFrameHighWater(0), PeakHighWater(0)
+		{
+			AddBlock(InitialSize);
+		}
+
+		~LinearArena()
+		{
+			FreeBlocks(Current);
+		}
+
+		LinearArena(const LinearArena&) = delete;
+		LinearArena& operator=(const LinearArena&) = delete;
+
+		/**
+		 * @brief Reserva Size bytes alineados a Alignment (potencia de dos).
+		 */
+		void* Allocate(size_t Size, size_t Alignment = alignof(std::max_align_t))
+		{
+			assert((Alignment & (Alignment - 1)) == 0 && "LinearArena: alignment must be a power of two");
+			const uintptr_t Aligned = (reinterpret_cast<uintptr_t>(Cursor) + Alignment - 1) & ~(uintptr_t)(Alignment - 1);
+			if (Aligned + Size <= reinterpret_cast<uintptr_t>(End))
+			{
+				char* Result = reinterpret_cast<char*>(Aligned);
+				Used += (Result + Size) - Cursor;
+				Cursor = Result + Size;
+				return Result;
+			}
+			return AllocateSlow(Size, Alignment);
+		}
+
+		/**
+		 * @brief No hace nada: la memoria vuelve a la arena en Reset().
+		 *        Existe para cumplir la interfaz de asignador (AllocateShared...).
+		 */
+		void Deallocate(void*, size_t) {}
+
+		/**
+		 * @brief Reserva un arreglo sin inicializar de Count elementos de tipo T.
+		 */
+		template<typename T>
+		T* AllocateArray(size_t Count)
+		{
+			return static_cast<T*>(Allocate(Count * sizeof(T), alignof(T)));
+		}
+
+		/**
+		 * @brief Libera todo lo reservado desde el último Reset y registra la
+		 *        marca de agua del frame.
+		 */
+		void Reset()
+		{
+			LastFrameHighWater = Used;
+			PeakHighWater = Used > PeakHighWater ? Used : PeakHighWater;
+
+			if (Current->Prev)
+			{
+				// El frame no cupo en un bloque: fusionar en uno que cubra todo.
+				size_t Total = 0;
+				for (Block* B = Current; B; B = B->Prev)
+				{
+					Total += B->Size;
+				}
+				FreeBlocks(Current);
+				Current = nullptr;
+				AddBlock(Total);
+			}
+			else
+			{
+				Cursor = Data(Current);
+			}
+			Used = 0;
+		}
+
+		/**
+		 * @brief Bytes usados en el frame actual (incluye relleno de alineación).
+		 */
+		size_t GetUsed() const { return Used; }
+
+		/**
+		 * @brief Bytes usados por el frame anterior al último Reset.
+		 */
+		size_t GetLastFrameHighWaterMark() const { return LastFrameHighWater; }
+
+		/**
+		 * @brief Máximo de bytes usados en un frame desde la creación.
+		 */
+		size_t GetPeakHighWaterMark() const { return PeakHighWater; }
+
+		/**
+		 * @brief Bytes reservados del sistema por la arena.
+		 */
+		size_t GetCapacity() const
+		{
+			size_t Total = 0;
+			for (Block* B = Current; B; B = B->Prev)
+			{
+				Total += B->Size;
+			}
+			return Total;
+		}
+
+	private:
+		struct alignas(std::max_align_t) Block
+		{
+			Block* Prev;
+			size_t Size;  ///< Bytes de datos que siguen a la cabecera.
+		};
+
+		Block* Current;             ///< Bloque activo (los anteriores por Prev).
+		char* Cursor;               ///< Siguiente byte libre del bloque activo.
+		char* End;                  ///< Fin del bloque activo.
+		size_t Used;                ///< Bytes consumidos en el frame.
+		size_t LastFrameHighWater;  ///< Used al hacer el último Reset.
+		size_t PeakHighWater;       ///< Máximo histórico de Used.
+
+		static char* Data(Block* B)
+		{
+			return reinterpret_cast<char*>(B + 1);
+		}
+
+		void AddBlock(size_t Size)
+		{
+			Block* NewBlock = static_cast<Block*>(TrackedAllocate(sizeof(Block) + Size, alignof(Block)));
+			NewBlock->Prev = Current;
+			NewBlock->Size = Size;
+			Current = NewBlock;
+			Cursor = Data(NewBlock);
+			End = Cursor + Size;
+		}
+
+		void* AllocateSlow(size_t Size, size_t Alignment)
+		{
+			// Lo que quedaba libre en el bloque cuenta como usado este frame.
+			Used += End - Cursor;
+			const size_t Needed = Size + Alignment;
+			AddBlock(Current->Size * 2 > Needed ? Current->Size * 2 : Needed);
+			return Allocate(Size, Alignment);
+		}
+
+		static void FreeBlocks(Block* B)
+		{
+			while (B)
+			{
+				Block* Prev = B->Prev;
+				TrackedFree(B);
+				B = Prev;
+			}
+		}
+	};
+
+	/**
+	 * @brief Arena de frame del hilo actual.
+	 *
+	 * Cada hilo tiene la suya, así reservar no necesita sincronización. El
+	 * dueño del hilo llama a Reset() al final de su frame (el hilo principal
+	 * lo hace en BaseApp::render).
+	 */
+	inline LinearArena& GetFrameArena()
+	{
+		thread_local LinearArena Arena;
+		return Arena;
+	}
+
+	/**
+	 * @brief Adaptador de LinearArena para contenedores STL.
+	 *
+	 * Construido por defecto usa la arena de frame del hilo actual. deallocate
+	 * no libera nada: el contenedor debe destruirse antes del Reset.
+	 */
+	template<typename T>
+	class TArenaAllocator
+	{
+	public:
+		typedef T value_type;
+
+		TArenaAllocator() noexcept : Arena(&GetFrameArena()) {}
+		explicit TArenaAllocator(LinearArena& InArena) noexcept : Arena(&InArena) {}
+
+		template<typename U>
+		TArenaAllocator(const TArenaAllocator<U>& Other) noexcept : Arena(Other.GetArena()) {}
+
+		T* allocate(size_t Count)
+		{
+			return Arena->AllocateArray<T>(Count);
+		}
+
+		void deallocate(T*, size_t) noexcept {}
+
+		LinearArena* GetArena() const { return Arena; }
+
+		template<typename U>
+		bool operator==(const TArenaAllocator<U>& Other) const { return Arena == Other.GetArena(); }
+
+		template<typename U>
+		bool operator!=(const TArenaAllocator<U>& Other) const { return Arena != Other.GetArena(); }
+
+	private:
+		LinearArena* Arena;
+	};
+
+	/**
+	 * @brief Asignador de TArray sobre la arena de frame del hilo actual.
+	 */
+	template<typename T>
+	class TFrameArrayAllocator
+	{
+	public:
+		TFrameArrayAllocator() : Arena(&GetFrameArena()) {}
+
+		T* Allocate(size_t Count) { return Arena->AllocateArray<T>(Count); }
+		void Deallocate(T*, size_t) {}
+
+		T* InlineData() { return nullptr; }
+		static constexpr size_t InlineCapacity() { return 0; }
+
+	private:
+		LinearArena* Arena;
+	};
+
+	template<typename T>
+	using TFrameVector = std::vector<T, TArenaAllocator<T>>;
+
+	template<typename T>
+	using TFrameArray = TArray<T, TFrameArrayAllocator<T>>;
+
+	typedef std::basic_string<char, std::char_traits<char>, TArenaAllocator<char>> FrameString;
+
+	/**
+	 * @brief printf sobre la arena de frame: la cadena vive hasta el Reset.
+	 *        Útil para etiquetas de ImGui que se construyen cada frame.
+	 */
+	inline const char* FrameFormat(const char* Format, ...)
+	{
+		va_list Args;
+		va_start(Args, Format);
+		const int Length = std::vsnprintf(nullptr, 0, Format, Args);
+		va_end(Args);
+		if (Length < 0)
+		{
+			return "";
+		}
+
+		char* Buffer = GetFrameArena().AllocateArray<char>(Length + 1);
+		va_start(Args, Format);
+		std::vsnprintf(Buffer, Length + 1, Format, Args);
+		va_end(Args);
+		return Buffer;
+	}
+
+	// EXAMPLE
+
+	/*
+	int main()
+	{
+		for (int Frame = 0; Frame < 3; ++Frame)
+		{
+			EU::TFrameVector<int> Visible;   ///< Crece con saltos de puntero, sin malloc.
+			for (int i = 0; i < 1000; ++i)
+			{
+				Visible.push_back(i);
+			}
+			const char* Label = EU::FrameFormat("Actor %d", Frame);
+			std::cout << Label << " " << Visible.size() << std::endl;
+
+			Visible = EU::TFrameVector<int>();  ///< Los contenedores se destruyen antes del Reset.
+			EU::GetFrameArena().Reset();
+			std::cout << "High water: " << EU::GetFrameArena().GetLastFrameHighWaterMark() << " bytes" << std::endl;
+		}
+		return 0;
+	}
+	*/
+}
@@ -0,0 +1,489 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace EU {
+	/**
+	 * @brief Categorías a las que se atribuye la memoria.
+	 */
+	enum class EMemoryTag : uint8_t
+	{
+		Untagged,  ///< Todo lo que se reserva fuera de un MemoryTagScope.
+		Mesh,
+		Texture,
+		ECS,
+		Loader,
+		UI,
+		Count
+	};
+
+	/**
+	 * @brief Nombre de la categoría tal como aparece en el informe.
+	 */
+	inline const char* GetMemoryTagName(EMemoryTag Tag)
+	{
+		static const char* const Names[] = { "Untagged", "Mesh", "Texture", "ECS", "Loader", "UI" };
+		static_assert(sizeof(Names) / sizeof(Names[0]) == static_cast<size_t>(EMemoryTag::Count),
+			"GetMemoryTagName: falta el nombre de alguna categoría");
+		return Tag < EMemoryTag::Count ? Names[static_cast<size_t>(Tag)] : "Invalid";
+	}
+
+	/**
+	 * @brief Copia de los contadores de una categoría.
+	 */
+	struct MemoryTagStats
+	{
+		int64_t LiveBytes = 0;         ///< Bytes reservados y aún no liberados.
+		int64_t PeakBytes = 0;         ///< Máximo de LiveBytes desde el arranque (o desde ResetPeaks).
+		int64_t LiveAllocations = 0;   ///< Bloques aún no liberados.
+		int64_t TotalAllocations = 0;  ///< Reservas hechas desde el arranque.
+		int64_t Budget = 0;            ///< Límite de LiveBytes; 0 si no tiene.
+	};
+
+	/**
+	 * @brief Contabilidad de memoria por categoría, con presupuestos e informe.
+	 *
+	 * Las reservas se atribuyen a la categoría activa del hilo (ver
+	 * MemoryTagScope) y llegan aquí de tres formas:
+	 * - Los asignadores del motor, que piden su memoria con TrackedAllocate
+	 *   y guardan la categoría junto al bloque para descontarla bien al
+	 *   liberarlo. Funciona en cualquier build.
+	 * - El hook de operator new global (MemoryTrackerNew.h, solo con
+	 *   EU_TRACK_GLOBAL_NEW), que hace lo mismo con el resto del programa.
+	 * - Los asignadores envueltos con TTaggedAllocator (TAllocator.h) o
+	 *   TTrackedAllocator, que registran su propia categoría y desactivan lo
+	 *   anterior mientras reservan para no contar dos veces.
+	 *
+	 * Los contadores son atómicos y no reservan memoria, así que se puede
+	 * llamar desde cualquier hilo y desde el propio operator new.
+	 */
+	class MemoryTracker
+	{
+	public:
+		/**
+		 * @brief Se llama cuando una reserva hace que una categoría supere su
+		 *        presupuesto (una vez por cruce, no en cada reserva).
+		 */
+		typedef void (*BudgetHandler)(EMemoryTag Tag, int64_t LiveBytes, int64_t Budget);
+
+		static MemoryTracker& Get()
+		{
+			static MemoryTracker Instance;
+			return Instance;
+		}
+
+		/**
+		 * @brief Anota una reserva de Bytes en la categoría Tag.
+		 */
+		void RecordAllocation(EMemoryTag Tag, size_t Bytes)
+		{
+			Counters& C = Tags[static_cast<size_t>(Tag)];
+			const int64_t Live = C.LiveBytes.fetch_add(static_cast<int64_t>(Bytes), std::memory_order_relaxed) +
+				static_cast<int64_t>(Bytes);
+			C.LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+			C.TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+
+			int64_t Peak = C.PeakBytes.load(std::memory_order_relaxed);
+			while (Live > Peak && !C.PeakBytes.compare_exchange_weak(Peak, Live, std::memory_order_relaxed))
+			{
+			}
+
+			const int64_t Budget = C.Budget.load(std::memory_order_relaxed);
+			if (Budget > 0 && Live > Budget && Live - static_cast<int64_t>(Bytes) <= Budget)
+			{
+				Handler.load(std::memory_order_relaxed)(Tag, Live, Budget);
+			}
+		}
+
+		/**
+		 * @brief Anota la liberación de Bytes reservados antes en Tag.
+		 */
+		void RecordFree(EMemoryTag Tag, size_t Bytes)
+		{
+			Counters& C = Tags[static_cast<size_t>(Tag)];
+			C.LiveBytes.fetch_sub(static_cast<int64_t>(Bytes), std::memory_order_relaxed);
+			C.LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Fija el presupuesto de una categoría en bytes (0 lo quita).
+		 */
+		void SetBudget(EMemoryTag Tag, int64_t Bytes)
+		{
+			Tags[static_cast<size_t>(Tag)].Budget.store(Bytes, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Cambia la acción al superar un presupuesto (por defecto un
+		 *        aviso por stderr). Un handler puede abortar para hacerlo estricto.
+		 */
+		void SetBudgetHandler(BudgetHandler NewHandler)
+		{
+			Handler.store(NewHandler ? NewHandler : &DefaultBudgetHandler, std::memory_order_relaxed);
+		}
+
+		bool IsOverBudget(EMemoryTag Tag) const
+		{
+			const Counters& C = Tags[static_cast<size_t>(Tag)];
+			const int64_t Budget = C.Budget.load(std::memory_order_relaxed);
+			return Budget > 0 && C.LiveBytes.load(std::memory_order_relaxed) > Budget;
+		}
+
+		MemoryTagStats GetStats(EMemoryTag Tag) const
+		{
+			const Counters& C = Tags[static_cast<size_t>(Tag)];
+			MemoryTagStats Stats;
+			Stats.LiveBytes = C.LiveBytes.load(std::memory_order_relaxed);
+			Stats.PeakBytes = C.PeakBytes.load(std::memory_order_relaxed);
+			Stats.LiveAllocations = C.LiveAllocations.load(std::memory_order_relaxed);
+			Stats.TotalAllocations = C.TotalAllocations.load(std::memory_order_relaxed);
+			Stats.Budget = C.Budget.load(std::memory_order_relaxed);
+			return Stats;
+		}
+
+		/**
+		 * @brief Iguala el pico de cada categoría a su uso actual (p. ej. antes
+		 *        de cargar un modelo, para medir solo esa carga).
+		 */
+		void ResetPeaks()
+		{
+			for (Counters& C : Tags)
+			{
+				C.PeakBytes.store(C.LiveBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			}
+		}
+
+		/**
+		 * @brief Escribe una tabla con los contadores de cada categoría.
+		 *
+		 * Una línea por categoría con columnas separadas por espacios, fácil
+		 * de comparar o procesar fuera del motor. Las categorías con bloques
+		 * vivos se marcan como posibles fugas cuando el informe se hace al
+		 * salir.
+		 */
+		void WriteReport(FILE* Out) const
+		{
+			std::fprintf(Out, "%-10s %14s %14s %12s %14s %14s\n",
+				"tag", "live_bytes", "peak_bytes", "live_allocs", "total_allocs", "budget");
+
+			MemoryTagStats Total;
+			for (size_t i = 0; i < static_cast<size_t>(EMemoryTag::Count); ++i)
+			{
+				const MemoryTagStats Stats = GetStats(static_cast<EMemoryTag>(i));
+				std::fprintf(Out, "%-10s %14lld %14lld %12lld %14lld %14lld%s\n",
+					GetMemoryTagName(static_cast<EMemoryTag>(i)),
+					static_cast<long long>(Stats.LiveBytes), static_cast<long long>(Stats.PeakBytes),
+					static_cast<long long>(Stats.LiveAllocations), static_cast<long long>(Stats.TotalAllocations),
+					static_cast<long long>(Stats.Budget),
+					Stats.Budget > 0 && Stats.PeakBytes > Stats.Budget ? "  OVER BUDGET" : "");
+
+				Total.LiveBytes += Stats.LiveBytes;
+				Total.PeakBytes += Stats.PeakBytes;
+				Total.LiveAllocations += Stats.LiveAllocations;
+				Total.TotalAllocations += Stats.TotalAllocations;
+			}
+			std::fprintf(Out, "%-10s %14lld %14lld %12lld %14lld\n", "total",
+				static_cast<long long>(Total.LiveBytes), static_cast<long long>(Total.PeakBytes),
+				static_cast<long long>(Total.LiveAllocations), static_cast<long long>(Total.TotalAllocations));
+		}
+
+		/**
+		 * @brief Escribe el informe en un fichero. Devuelve false si no se pudo abrir.
+		 */
+		bool WriteReport(const char* Path) const
+		{
+			FILE* Out = std::fopen(Path, "w");
+			if (!Out)
+			{
+				return false;
+			}
+			WriteReport(Out);
+			std::fclose(Out);
+			return true;
+		}
+
+		/**
+		 * @brief Categoría activa del hilo y si el hook global debe ignorar
+		 *        sus reservas (porque ya las cuenta un asignador envuelto).
+		 */
+		struct ThreadState
+		{
+			EMemoryTag Tag;
+			int SuppressDepth;
+		};
+
+		static ThreadState& GetThreadState()
+		{
+			static thread_local ThreadState State = { EMemoryTag::Untagged, 0 };
+			return State;
+		}
+
+	private:
+		struct Counters
+		{
+			std::atomic<int64_t> LiveBytes{ 0 };
+			std::atomic<int64_t> PeakBytes{ 0 };
+			std::atomic<int64_t> LiveAllocations{ 0 };
+			std::atomic<int64_t> TotalAllocations{ 0 };
+			std::atomic<int64_t> Budget{ 0 };
+		};
+
+		constexpr MemoryTracker() : Handler(&DefaultBudgetHandler) {}
+
+		static void DefaultBudgetHandler(EMemoryTag Tag, int64_t LiveBytes, int64_t Budget)
+		{
+			std::fprintf(stderr, "[MemoryTracker] %s over budget: %lld of %lld bytes\n",
+				GetMemoryTagName(Tag), static_cast<long long>(LiveBytes), static_cast<long long>(Budget));
+		}
+
+		Counters Tags[static_cast<size_t>(EMemoryTag::Count)];
+		std::atomic<BudgetHandler> Handler;
+	};
+
+	/**
+	 * @brief Atribuye a Tag todo lo que reserve el hilo mientras dure el ámbito.
+	 *
+	 * Los ámbitos se pueden anidar; al salir se restaura la categoría anterior.
+	 */
+	class MemoryTagScope
+	{
+	public:
+		explicit MemoryTagScope(EMemoryTag Tag)
+			: Previous(MemoryTracker::GetThreadState().Tag)
+		{
+			MemoryTracker::GetThreadState().Tag = Tag;
+		}
+
+		~MemoryTagScope()
+		{
+			MemoryTracker::GetThreadState().Tag = Previous;
+		}
+
+		MemoryTagScope(const MemoryTagScope&) = delete;
+		MemoryTagScope& operator=(const MemoryTagScope&) = delete;
+
+	private:
+		EMemoryTag Previous;
+	};
+
+	/**
+	 * @brief Hace que el hook global ignore las reservas del hilo mientras
+	 *        dure el ámbito (las anota quien lo abre).
+	 */
+	class MemoryUntrackedScope
+	{
+	public:
+		MemoryUntrackedScope() { ++MemoryTracker::GetThreadState().SuppressDepth; }
+		~MemoryUntrackedScope() { --MemoryTracker::GetThreadState().SuppressDepth; }
+
+		MemoryUntrackedScope(const MemoryUntrackedScope&) = delete;
+		MemoryUntrackedScope& operator=(const MemoryUntrackedScope&) = delete;
+	};
+
+	namespace detail {
+		/**
+		 * @brief Cabecera que precede a cada bloque de TrackedAllocate: guarda
+		 *        la categoría con la que se anotó para descontarla igual al
+		 *        liberar, aunque otro hilo u otro MemoryTagScope esté activo.
+		 */
+		struct TrackedBlockHeader
+		{
+			void* Raw;      ///< Lo que devolvió malloc.
+			size_t Size;    ///< Bytes pedidos por el usuario.
+			uint32_t Tag;   ///< Categoría anotada, o UNTRACKED_TAG.
+			uint32_t Magic;
+		};
+
+		static const uint32_t UNTRACKED_TAG = 0xFFu;
+		static const uint32_t TRACKED_BLOCK_MAGIC = 0xE0A110C8u;
+
+		inline TrackedBlockHeader* GetTrackedBlockHeader(void* Ptr)
+		{
+			return static_cast<TrackedBlockHeader*>(Ptr) - 1;
+		}
+	}
+
+	/**
+	 * @brief Reserva memoria del sistema y la anota en la categoría activa
+	 *        del hilo (salvo dentro de un MemoryUntrackedScope).
+	 *
+	 * Es lo que usan los asignadores del motor (TDefaultAllocator,
+	 * TPoolAllocator, LinearArena, los chunks de los arquetipos) para pedir
+	 * memoria, así el informe tiene datos en cualquier build y no solo con el
+	 * hook de operator new. Va directo a malloc, por lo que el hook no vuelve
+	 * a contar el bloque.
+	 *
+	 * @return nullptr si no hay memoria.
+	 */
+	inline void* TrackedAllocateNoThrow(size_t Size, size_t Alignment) noexcept
+	{
+		if (Alignment < __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+		{
+			Alignment = __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+		}
+		void* Raw = std::malloc(Size + sizeof(detail::TrackedBlockHeader) + Alignment);
+		if (!Raw)
+		{
+			return nullptr;
+		}
+
+		const uintptr_t First = reinterpret_cast<uintptr_t>(Raw) + sizeof(detail::TrackedBlockHeader);
+		const uintptr_t User = (First + Alignment - 1) & ~(static_cast<uintptr_t>(Alignment) - 1);
+		detail::TrackedBlockHeader* Header = detail::GetTrackedBlockHeader(reinterpret_cast<void*>(User));
+		Header->Raw = Raw;
+		Header->Size = Size;
+		Header->Magic = detail::TRACKED_BLOCK_MAGIC;
+
+		const MemoryTracker::ThreadState& State = MemoryTracker::GetThreadState();
+		if (State.SuppressDepth > 0)
+		{
+			Header->Tag = detail::UNTRACKED_TAG;
+		}
+		else
+		{
+			Header->Tag = static_cast<uint32_t>(State.Tag);
+			MemoryTracker::Get().RecordAllocation(State.Tag, Size);
+		}
+		return reinterpret_cast<void*>(User);
+	}
+
+	/**
+	 * @brief Como TrackedAllocateNoThrow, pero llama al new_handler y lanza
+	 *        std::bad_alloc si no hay memoria (igual que operator new).
+	 */
+	inline void* TrackedAllocate(size_t Size, size_t Alignment)
+	{
+		for (;;)
+		{
+			if (void* Ptr = TrackedAllocateNoThrow(Size ? Size : 1, Alignment))
+			{
+				return Ptr;
+			}
+			std::new_handler Handler = std::get_new_handler();
+			if (!Handler)
+			{
+				throw std::bad_alloc();
+			}
+			Handler();
+		}
+	}
+
+	/**
+	 * @brief Libera un bloque de TrackedAllocate y lo descuenta de la
+	 *        categoría en la que se anotó.
+	 */
+	inline void TrackedFree(void* Ptr) noexcept
+	{
+		if (!Ptr)
+		{
+			return;
+		}
+		detail::TrackedBlockHeader* Header = detail::GetTrackedBlockHeader(Ptr);
+		assert(Header->Magic == detail::TRACKED_BLOCK_MAGIC && "TrackedFree: el bloque no salió de TrackedAllocate");
+		if (Header->Tag != detail::UNTRACKED_TAG)
+		{
+			MemoryTracker::Get().RecordFree(static_cast<EMemoryTag>(Header->Tag), Header->Size);
+		}
+		Header->Magic = 0;
+		std::free(Header->Raw);
+	}
+
+	/**
+	 * @brief Envuelve un asignador de bytes (Allocate(Size, Alignment) /
+	 *        Deallocate(Ptr, Size), p. ej. TPoolAllocator o LinearArena) y
+	 *        anota lo que reserva en Tag. Sirve también para AllocateShared.
+	 *
+	 * Con LinearArena el Deallocate no libera nada, pero se descuenta igual:
+	 * la categoría mide lo que está en uso, no lo que la arena retiene.
+	 */
+	template<typename Allocator>
+	class TTrackedAllocator
+	{
+	public:
+		TTrackedAllocator(Allocator& InInner, EMemoryTag InTag) : Inner(&InInner), Tag(InTag) {}
+
+		void* Allocate(size_t Size, size_t Alignment)
+		{
+			void* Ptr;
+			{
+				MemoryUntrackedScope Untracked;
+				Ptr = Inner->Allocate(Size, Alignment);
+			}
+			MemoryTracker::Get().RecordAllocation(Tag, Size);
+			return Ptr;
+		}
+
+		void Deallocate(void* Ptr, size_t Size)
+		{
+			if (Ptr)
+			{
+				MemoryTracker::Get().RecordFree(Tag, Size);
+				Inner->Deallocate(Ptr, Size);
+			}
+		}
+
+	private:
+		Allocator* Inner;
+		EMemoryTag Tag;
+	};
+
+	/**
+	 * @brief Escribe el informe de memoria al destruirse.
+	 *
+	 * Pensado como objeto global definido antes que la aplicación en la
+	 * misma unidad de traducción: se construye antes y se destruye después,
+	 * así el informe solo muestra lo que nadie liberó (posibles fugas).
+	 */
+	class MemoryReportAtExit
+	{
+	public:
+		explicit MemoryReportAtExit(const char* InPath) : Path(InPath)
+		{
+			MemoryTracker::Get();  // Garantiza que el tracker sobreviva a este objeto.
+		}
+
+		~MemoryReportAtExit()
+		{
+			MemoryTracker::Get().WriteReport(Path);
+		}
+
+		MemoryReportAtExit(const MemoryReportAtExit&) = delete;
+		MemoryReportAtExit& operator=(const MemoryReportAtExit&) = delete;
+
+	private:
+		const char* Path;
+	};
+}
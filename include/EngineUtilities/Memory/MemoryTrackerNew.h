@@ -0,0 +1,87 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "EngineUtilities/Memory/MemoryTracker.h"
+
+/**
+ * @file MemoryTrackerNew.h
+ * @brief Sustituye el operator new/delete global para que todas las reservas
+ *        del programa pasen por MemoryTracker.
+ *
+ * Incluir en UNA sola unidad de traducción del ejecutable (define los
+ * operadores, no solo los declara) y solo en builds de seguimiento
+ * (EU_TRACK_GLOBAL_NEW, activo en Debug). Un bloque reservado por el
+ * asignador de otro módulo (p. ej. una DLL) y liberado aquí no tiene la
+ * cabecera: se devuelve tal cual a free() sin descontarlo de ninguna
+ * categoría. Los bloques se piden con TrackedAllocate (MemoryTracker.h),
+ * igual que los asignadores del motor.
+ */
+
+namespace EU {
+	namespace detail {
+		inline void FreeFromGlobalDelete(void* Ptr) noexcept
+		{
+			if (Ptr && GetTrackedBlockHeader(Ptr)->Magic != TRACKED_BLOCK_MAGIC)
+			{
+				// Bloque que no salió de este hook (otro módulo con la misma CRT):
+				// no se anotó, así que no hay nada que descontar.
+				std::free(Ptr);
+				return;
+			}
+			TrackedFree(Ptr);
+		}
+	}
+}
+
+void* operator new(size_t Size) { return EU::TrackedAllocate(Size, 0); }
+void* operator new[](size_t Size) { return EU::TrackedAllocate(Size, 0); }
+void* operator new(size_t Size, std::align_val_t Alignment) { return EU::TrackedAllocate(Size, static_cast<size_t>(Alignment)); }
+void* operator new[](size_t Size, std::align_val_t Alignment) { return EU::TrackedAllocate(Size, static_cast<size_t>(Alignment)); }
+void* operator new(size_t Size, const std::nothrow_t&) noexcept { return EU::TrackedAllocateNoThrow(Size ? Size : 1, 0); }
+void* operator new[](size_t Size, const std::nothrow_t&) noexcept { return EU::TrackedAllocateNoThrow(Size ? Size : 1, 0); }
+void* operator new(size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return EU::TrackedAllocateNoThrow(Size ? Size : 1, static_cast<size_t>(Alignment)); }
+void* operator new[](size_t Size, std::align_val_t Alignment, const std::nothrow_t&) noexcept { return EU::TrackedAllocateNoThrow(Size ? Size : 1, static_cast<size_t>(Alignment)); }
+
+void operator delete(void* Ptr) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete[](void* Ptr) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete(void* Ptr, size_t) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete[](void* Ptr, size_t) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete(void* Ptr, std::align_val_t) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete[](void* Ptr, std::align_val_t) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete(void* Ptr, size_t, std::align_val_t) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete[](void* Ptr, size_t, std::align_val_t) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete(void* Ptr, const std::nothrow_t&) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete[](void* Ptr, const std::nothrow_t&) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete(void* Ptr, std::align_val_t, const std::nothrow_t&) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
+void operator delete[](void* Ptr, std::align_val_t, const std::nothrow_t&) noexcept { EU::detail::FreeFromGlobalDelete(Ptr); }
@@ -0,0 +1,153 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <new>
+
+#include "EngineUtilities/Memory/MemoryTracker.h"
+
+namespace EU {
+	/**
+	 * @brief Asignador por defecto de los contenedores EU: memoria del heap sin
+	 *        inicializar (los contenedores construyen los elementos en sitio).
+	 *
+	 * Reserva con TrackedAllocate, así que lo que guardan los contenedores
+	 * cuenta en la categoría del MemoryTagScope activo al crecer.
+	 *
+	 * Un asignador de contenedor expone:
+	 * - T* Allocate(size_t Count) / void Deallocate(T* Ptr, size_t Count)
+	 * - T* InlineData() y size_t InlineCapacity(): almacenamiento interno que el
+	 *   contenedor usa antes de pedir memoria (nullptr y 0 si no tiene).
+	 *
+	 * @tparam T Tipo de los elementos.
+	 */
+	template<typename T>
+	class TDefaultAllocator
+	{
+	public:
+		T* Allocate(size_t Count)
+		{
+			if (Count > static_cast<size_t>(-1) / sizeof(T))
+			{
+				throw std::bad_array_new_length();
+			}
+			return static_cast<T*>(TrackedAllocate(Count * sizeof(T), alignof(T)));
+		}
+
+		void Deallocate(T* Ptr, size_t)
+		{
+			TrackedFree(Ptr);
+		}
+
+		T* InlineData() { return nullptr; }
+		static constexpr size_t InlineCapacity() { return 0; }
+	};
+
+	/**
+	 * @brief Asignador con espacio interno para N elementos: mientras el
+	 *        contenedor no supere N, no se toca el heap. Al superarlo se usa
+	 *        FallbackAllocator.
+	 *
+	 * El buffer vive dentro del propio asignador, por lo que copiarlo o
+	 * moverlo no copia el buffer: el contenedor se encarga de mover los
+	 * elementos.
+	 *
+	 * @tparam T Tipo de los elementos.
+	 * @tparam N Número de elementos que caben sin reservar memoria.
+	 * @tparam FallbackAllocator Asignador usado al superar N elementos.
+	 */
+	template<typename T, size_t N, typename FallbackAllocator = TDefaultAllocator<T>>
+	class TInlineAllocator
+	{
+	public:
+		static_assert(N > 0, "TInlineAllocator: N must be greater than zero");
+
+		TInlineAllocator() {}
+		TInlineAllocator(const TInlineAllocator&) {}
+		TInlineAllocator& operator=(const TInlineAllocator&) { return *this; }
+
+		T* Allocate(size_t Count)
+		{
+			return Count <= N ? InlineData() : Fallback.Allocate(Count);
+		}
+
+		void Deallocate(T* Ptr, size_t Count)
+		{
+			if (Ptr != InlineData())
+			{
+				Fallback.Deallocate(Ptr, Count);
+			}
+		}
+
+		T* InlineData() { return reinterpret_cast<T*>(Storage); }
+		static constexpr size_t InlineCapacity() { return N; }
+
+	private:
+		alignas(T) unsigned char Storage[sizeof(T) * N];  ///< Espacio para N elementos sin construir.
+		FallbackAllocator Fallback;
+	};
+
+	/**
+	 * @brief Asignador de contenedor (TArray) que anota sus bloques en Tag.
+	 *
+	 * @tparam T Tipo de los elementos.
+	 * @tparam Tag Categoría a la que se atribuye la memoria.
+	 * @tparam BaseAllocator Asignador de contenedor que reserva de verdad.
+	 */
+	template<typename T, EMemoryTag Tag, typename BaseAllocator = TDefaultAllocator<T>>
+	class TTaggedAllocator : private BaseAllocator
+	{
+	public:
+		T* Allocate(size_t Count)
+		{
+			T* Ptr;
+			{
+				MemoryUntrackedScope Untracked;
+				Ptr = BaseAllocator::Allocate(Count);
+			}
+			if (Ptr != InlineData())
+			{
+				MemoryTracker::Get().RecordAllocation(Tag, Count * sizeof(T));
+			}
+			return Ptr;
+		}
+
+		void Deallocate(T* Ptr, size_t Count)
+		{
+			if (Ptr && Ptr != InlineData())
+			{
+				MemoryTracker::Get().RecordFree(Tag, Count * sizeof(T));
+			}
+			BaseAllocator::Deallocate(Ptr, Count);
+		}
+
+		T* InlineData() { return BaseAllocator::InlineData(); }
+		static constexpr size_t InlineCapacity() { return BaseAllocator::InlineCapacity(); }
+	};
+}
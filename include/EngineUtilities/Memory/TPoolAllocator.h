@@ -0,0 +1,416 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "EngineUtilities/Memory/MemoryTracker.h"
+#include "EngineUtilities/Memory/TRefCount.h"
+
+namespace EU {
+	/**
+	 * @brief Indica si MakeShared<T> debe sacar sus bloques de un pool por tipo.
+	 *
+	 * Por defecto no; un tipo lo activa con EU_POOL_ALLOCATED(Tipo) justo
+	 * después de su definición (en el ámbito global), de forma que todas las
+	 * unidades de traducción que lo crean vean la especialización.
+	 */
+	template<typename T>
+	struct TUsePoolAllocator : std::false_type
+	{
+	};
+
+	/**
+	 * @brief Asignador de bloques de tamaño fijo (sizeof(T)) con lista libre.
+	 *
+	 * La memoria se pide por trozos (chunks) de varios bloques, cada uno del
+	 * doble que el anterior hasta MAX_CHUNK_SLOTS; los bloques liberados
+	 * vuelven a una lista libre intrusiva y se reutilizan en orden LIFO, así
+	 * que crear y destruir muchos objetos no fragmenta el heap y los objetos
+	 * vivos quedan juntos en memoria. Los trozos solo se devuelven al
+	 * destruir el pool.
+	 *
+	 * Con ESPMode::ThreadSafe la lista compartida se protege con un mutex y,
+	 * en el pool global del tipo (Get()) cada hilo guarda además una pequeña
+	 * caché de bloques para no tomar el mutex en cada reserva. La caché es
+	 * una por hilo y por T, así que solo puede pertenecer a un pool: los
+	 * pools creados a mano no la usan. El global nunca se destruye, así que
+	 * los objetos que mueran durante la destrucción de estáticos (p. ej. los
+	 * de una aplicación global) siguen teniendo a dónde volver.
+	 *
+	 * Ofrece Allocate(Size, Alignment)/Deallocate(Ptr, Size), por lo que sirve
+	 * directamente como asignador de AllocateShared.
+	 *
+	 * @tparam T Tipo (o bloque) cuyo tamaño y alineación definen cada bloque.
+	 * @tparam Mode NotThreadSafe para un pool de un solo hilo, sin mutex.
+	 */
+	template<typename T, ESPMode Mode = ESPMode::ThreadSafe>
+	class TPoolAllocator
+	{
+		struct FreeNode
+		{
+			FreeNode* Next;
+		};
+
+	public:
+		static const size_t SLOT_ALIGNMENT = alignof(T) > alignof(FreeNode) ? alignof(T) : alignof(FreeNode);
+		static const size_t SLOT_SIZE =
+			((sizeof(T) > sizeof(FreeNode) ? sizeof(T) : sizeof(FreeNode)) + SLOT_ALIGNMENT - 1) & ~(SLOT_ALIGNMENT - 1);
+		static const size_t MAX_CHUNK_SLOTS = 4096;
+		static const size_t CACHE_BATCH = 32;  ///< Bloques que la caché de un hilo pide o devuelve de una vez.
+
+		/**
+		 * @param FirstChunkSlots Bloques del primer trozo.
+		 */
+		explicit TPoolAllocator(size_t FirstChunkSlots = 64)
+			: TPoolAllocator(FirstChunkSlots, false)
+		{
+		}
+
+		/**
+		 * @brief Libera todos los trozos; no debe quedar ningún objeto vivo.
+		 */
+		~TPoolAllocator()
+		{
+			assert(NumOut == 0 && "TPoolAllocator destruido con bloques en uso");
+			for (void* Chunk : Chunks)
+			{
+				TrackedFree(Chunk);
+			}
+		}
+
+		TPoolAllocator(const TPoolAllocator&) = delete;
+		TPoolAllocator& operator=(const TPoolAllocator&) = delete;
+
+		/**
+		 * @brief Pool global del tipo, con caché por hilo en modo ThreadSafe.
+		 *
+		 * Se crea en el primer uso y no se destruye nunca (el sistema
+		 * operativo recupera la memoria al salir).
+		 */
+		static TPoolAllocator& Get()
+		{
+			static TPoolAllocator* Global = new TPoolAllocator(64, Mode == ESPMode::ThreadSafe);
+			return *Global;
+		}
+
+		/**
+		 * @brief Reserva un bloque. Size y Alignment no pueden superar los del pool.
+		 */
+		void* Allocate(size_t Size = sizeof(T), size_t Alignment = alignof(T))
+		{
+			assert(Size <= SLOT_SIZE && Alignment <= SLOT_ALIGNMENT);
+			(void)Size;
+			(void)Alignment;
+
+			if constexpr (Mode == ESPMode::ThreadSafe)
+			{
+				ThreadCache* Cache = bThreadCache ? GetThreadCache() : nullptr;
+				if (Cache)
+				{
+					if (!Cache->Head)
+					{
+						std::lock_guard<std::mutex> Lock(Mutex);
+						Cache->Head = PopBatch(CACHE_BATCH, Cache->Count);
+					}
+					FreeNode* Node = Cache->Head;
+					Cache->Head = Node->Next;
+					--Cache->Count;
+					return Node;
+				}
+				std::lock_guard<std::mutex> Lock(Mutex);
+				return PopOne();
+			}
+			else
+			{
+				return PopOne();
+			}
+		}
+
+		/**
+		 * @brief Devuelve al pool un bloque obtenido con Allocate.
+		 */
+		void Deallocate(void* Ptr, size_t Size = sizeof(T))
+		{
+			assert(Size <= SLOT_SIZE);
+			(void)Size;
+			if (!Ptr)
+			{
+				return;
+			}
+
+			FreeNode* Node = static_cast<FreeNode*>(Ptr);
+			if constexpr (Mode == ESPMode::ThreadSafe)
+			{
+				ThreadCache* Cache = bThreadCache ? GetThreadCache() : nullptr;
+				if (Cache)
+				{
+					Node->Next = Cache->Head;
+					Cache->Head = Node;
+					if (++Cache->Count >= 2 * CACHE_BATCH)
+					{
+						ReturnFromCache(*Cache, CACHE_BATCH);
+					}
+					return;
+				}
+				std::lock_guard<std::mutex> Lock(Mutex);
+				PushOne(Node);
+			}
+			else
+			{
+				PushOne(Node);
+			}
+		}
+
+		/**
+		 * @brief Reserva un bloque y construye en él un T.
+		 */
+		template<typename... Args>
+		T* New(Args&&... args)
+		{
+			void* Memory = Allocate();
+			try
+			{
+				return ::new (Memory) T(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				Deallocate(Memory);
+				throw;
+			}
+		}
+
+		/**
+		 * @brief Destruye un T creado con New y devuelve su bloque.
+		 */
+		void Delete(T* Object)
+		{
+			if (Object)
+			{
+				Object->~T();
+				Deallocate(Object);
+			}
+		}
+
+		/**
+		 * @brief Bloques fuera de la lista compartida: los entregados y, en el
+		 *        pool global, también los que guardan las cachés de los hilos.
+		 */
+		size_t GetNumInUse() const
+		{
+			if constexpr (Mode == ESPMode::ThreadSafe)
+			{
+				std::lock_guard<std::mutex> Lock(Mutex);
+				return NumOut;
+			}
+			else
+			{
+				return NumOut;
+			}
+		}
+
+		/**
+		 * @brief Bloques reservados en total entre todos los trozos.
+		 */
+		size_t GetCapacity() const { return Capacity; }
+
+		/**
+		 * @brief Número de trozos pedidos al sistema.
+		 */
+		size_t GetNumChunks() const { return Chunks.size(); }
+
+	private:
+		/**
+		 * @param bUseThreadCache Solo para Get(): la caché por hilo de T es
+		 *        única y devuelve sus bloques al pool global.
+		 */
+		TPoolAllocator(size_t FirstChunkSlots, bool bUseThreadCache)
+			: FreeList(nullptr), NextChunkSlots(FirstChunkSlots ? FirstChunkSlots : 1),
+			  Capacity(0), NumOut(0), bThreadCache(bUseThreadCache)
+		{
+		}
+
+		/**
+		 * @brief Bloques libres que un hilo guarda para el pool global.
+		 *
+		 * Al terminar el hilo se devuelven al pool, que sigue vivo porque
+		 * Get() nunca lo destruye.
+		 */
+		struct ThreadCache
+		{
+			FreeNode* Head = nullptr;
+			size_t Count = 0;
+
+			~ThreadCache()
+			{
+				if (Head)
+				{
+					Get().ReturnFromCache(*this, Count);
+				}
+				ThreadCacheState& State = GetThreadCacheState();
+				State.Cache = nullptr;
+				State.bDestroyed = true;
+			}
+		};
+
+		/**
+		 * @brief Estado de la caché del hilo. Es trivialmente destructible, así
+		 *        que sigue siendo válido después de ~ThreadCache, cuando aún
+		 *        pueden liberarse bloques (p. ej. un objeto global destruido
+		 *        después de los thread_local del hilo principal).
+		 */
+		struct ThreadCacheState
+		{
+			ThreadCache* Cache;
+			bool bDestroyed;
+		};
+
+		static ThreadCacheState& GetThreadCacheState()
+		{
+			static thread_local ThreadCacheState State = { nullptr, false };
+			return State;
+		}
+
+		/**
+		 * @brief Caché del hilo, o nullptr si ya se destruyó: entonces se usa
+		 *        directamente la lista compartida (con el mutex) y no se
+		 *        vuelve a crear una caché que nadie devolvería.
+		 */
+		static ThreadCache* GetThreadCache()
+		{
+			ThreadCacheState& State = GetThreadCacheState();
+			if (!State.Cache && !State.bDestroyed)
+			{
+				static thread_local ThreadCache Cache;
+				State.Cache = &Cache;
+			}
+			return State.Cache;
+		}
+
+		void ReturnFromCache(ThreadCache& Cache, size_t Count)
+		{
+			FreeNode* First = Cache.Head;
+			FreeNode* Last = First;
+			for (size_t i = 1; i < Count; ++i)
+			{
+				Last = Last->Next;
+			}
+			Cache.Head = Last->Next;
+			Cache.Count -= Count;
+
+			std::lock_guard<std::mutex> Lock(Mutex);
+			Last->Next = FreeList;
+			FreeList = First;
+			NumOut -= Count;
+		}
+
+		FreeNode* PopOne()
+		{
+			if (!FreeList)
+			{
+				Grow();
+			}
+			FreeNode* Node = FreeList;
+			FreeList = Node->Next;
+			++NumOut;
+			return Node;
+		}
+
+		void PushOne(FreeNode* Node)
+		{
+			Node->Next = FreeList;
+			FreeList = Node;
+			--NumOut;
+		}
+
+		/**
+		 * @brief Separa hasta Count bloques de la lista libre (creciendo si está vacía).
+		 */
+		FreeNode* PopBatch(size_t Count, size_t& OutCount)
+		{
+			if (!FreeList)
+			{
+				Grow();
+			}
+			FreeNode* First = FreeList;
+			FreeNode* Last = First;
+			OutCount = 1;
+			while (OutCount < Count && Last->Next)
+			{
+				Last = Last->Next;
+				++OutCount;
+			}
+			FreeList = Last->Next;
+			Last->Next = nullptr;
+			NumOut += OutCount;
+			return First;
+		}
+
+		/**
+		 * @brief Pide un trozo nuevo y encadena sus bloques en orden de dirección.
+		 */
+		void Grow()
+		{
+			const size_t Slots = NextChunkSlots;
+			unsigned char* Chunk = static_cast<unsigned char*>(TrackedAllocate(Slots * SLOT_SIZE, SLOT_ALIGNMENT));
+			Chunks.push_back(Chunk);
+
+			for (size_t i = 0; i < Slots; ++i)
+			{
+				FreeNode* Node = reinterpret_cast<FreeNode*>(Chunk + i * SLOT_SIZE);
+				Node->Next = (i + 1 < Slots) ? reinterpret_cast<FreeNode*>(Chunk + (i + 1) * SLOT_SIZE) : FreeList;
+			}
+			FreeList = reinterpret_cast<FreeNode*>(Chunk);
+
+			Capacity += Slots;
+			NextChunkSlots = Slots * 2 < MAX_CHUNK_SLOTS ? Slots * 2 : MAX_CHUNK_SLOTS;
+		}
+
+		FreeNode* FreeList;
+		size_t NextChunkSlots;
+		size_t Capacity;
+		size_t NumOut;  ///< Protegido por Mutex en modo ThreadSafe.
+		std::vector<void*> Chunks;
+		mutable std::mutex Mutex;
+		bool bThreadCache;
+	};
+}
+
+/**
+ * @brief Hace que MakeShared<Type> reserve del pool global de su tipo.
+ *
+ * Usar en el ámbito global, después de la definición de Type.
+ */
+#define EU_POOL_ALLOCATED(Type) \
+	namespace EU { template<> struct TUsePoolAllocator<Type> : std::true_type {}; }
@@ -0,0 +1,136 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+namespace EU {
+	/**
+	 * @brief Modo de conteo de referencias de los punteros compartidos.
+	 *
+	 * ThreadSafe (por defecto) usa contadores atómicos: se pueden copiar y
+	 * destruir punteros al mismo objeto desde varios hilos (carga de assets,
+	 * jobs) sin bloqueos. NotThreadSafe usa enteros simples y solo es válido
+	 * si todas las copias viven en un mismo hilo.
+	 */
+	enum class ESPMode
+	{
+		NotThreadSafe,
+		ThreadSafe
+	};
+
+	/**
+	 * @brief Contador de referencias según el modo.
+	 *
+	 * Los incrementos son relajados (quien incrementa ya tiene una referencia,
+	 * así que el objeto no puede desaparecer). El decremento es release y el
+	 * que llega a cero hace un fence acquire antes de destruir, para ver todas
+	 * las escrituras hechas por los demás hilos antes de soltar su referencia.
+	 */
+	template<ESPMode Mode>
+	class TRefCounter;
+
+	template<>
+	class TRefCounter<ESPMode::ThreadSafe>
+	{
+	public:
+		explicit TRefCounter(int32_t initial) : count(initial) {}
+
+		void increment()
+		{
+			count.fetch_add(1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * @brief Decrementa el contador.
+		 *
+		 * @return true si llegó a cero.
+		 */
+		bool decrement()
+		{
+			if (count.fetch_sub(1, std::memory_order_release) == 1)
+			{
+				std::atomic_thread_fence(std::memory_order_acquire);
+				return true;
+			}
+			return false;
+		}
+
+		/**
+		 * @brief Incrementa solo si el contador no es cero (usado por TWeakPointer::lock).
+		 *
+		 * @return true si se incrementó.
+		 */
+		bool incrementIfNotZero()
+		{
+			int32_t current = count.load(std::memory_order_relaxed);
+			while (current != 0)
+			{
+				if (count.compare_exchange_weak(current, current + 1, std::memory_order_relaxed))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		int32_t get() const
+		{
+			return count.load(std::memory_order_relaxed);
+		}
+
+	private:
+		std::atomic<int32_t> count;
+	};
+
+	template<>
+	class TRefCounter<ESPMode::NotThreadSafe>
+	{
+	public:
+		explicit TRefCounter(int32_t initial) : count(initial) {}
+
+		void increment() { ++count; }
+		bool decrement() { return --count == 0; }
+
+		bool incrementIfNotZero()
+		{
+			if (count == 0)
+			{
+				return false;
+			}
+			++count;
+			return true;
+		}
+
+		int32_t get() const { return count; }
+
+	private:
+		int32_t count;
+	};
+}
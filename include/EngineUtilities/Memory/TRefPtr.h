@@ -0,0 +1,254 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "EngineUtilities/Memory/TRefCount.h"
+
+namespace EU {
+	/**
+	 * @brief Base para objetos con contador de referencias intrusivo.
+	 *
+	 * El contador vive dentro del propio objeto, así que un TRefPtr a él
+	 * no necesita bloque de control: crear, copiar o soltar la referencia
+	 * solo toca el objeto. Expone AddRef/Release con la misma forma que COM,
+	 * por lo que TRefPtr sirve igual para recursos del motor y para
+	 * interfaces D3D11.
+	 *
+	 * El contador empieza en 0; el primer TRefPtr lo sube a 1. Copiar el
+	 * objeto no copia el contador.
+	 *
+	 * @tparam Derived Clase que hereda (CRTP), destruida con delete al llegar a cero.
+	 * @tparam Mode Política de conteo (atómica por defecto).
+	 */
+	template<typename Derived, ESPMode Mode = ESPMode::ThreadSafe>
+	class TRefCounted
+	{
+	public:
+		void AddRef() const
+		{
+			refCount.increment();
+		}
+
+		void Release() const
+		{
+			if (refCount.decrement())
+			{
+				delete static_cast<const Derived*>(this);
+			}
+		}
+
+		int32_t GetRefCount() const
+		{
+			return refCount.get();
+		}
+
+	protected:
+		TRefCounted() : refCount(0) {}
+		TRefCounted(const TRefCounted&) : refCount(0) {}
+		TRefCounted& operator=(const TRefCounted&) { return *this; }
+		~TRefCounted() = default;
+
+	private:
+		mutable TRefCounter<Mode> refCount;
+	};
+
+	/**
+	 * @brief Puntero con conteo de referencias intrusivo.
+	 *
+	 * Funciona con cualquier T que tenga AddRef() y Release(): clases que
+	 * heredan de TRefCounted o interfaces COM (ID3D11ShaderResourceView...).
+	 * Ocupa un puntero y copiarlo es un AddRef; no reserva memoria.
+	 *
+	 * Construir desde un puntero crudo hace AddRef. Para punteros que ya
+	 * traen una referencia propia (lo que devuelven las funciones Create* de
+	 * D3D11) usar attach() o releaseAndGetAddressOf().
+	 *
+	 * @tparam T Tipo del objeto referenciado.
+	 */
+	template<typename T>
+	class TRefPtr
+	{
+	public:
+		TRefPtr() : ptr(nullptr) {}
+		TRefPtr(std::nullptr_t) : ptr(nullptr) {}
+
+		/**
+		 * @brief Toma una referencia nueva a rawPtr (AddRef).
+		 */
+		TRefPtr(T* rawPtr) : ptr(rawPtr)
+		{
+			if (ptr)
+			{
+				ptr->AddRef();
+			}
+		}
+
+		TRefPtr(const TRefPtr& other) : TRefPtr(other.ptr) {}
+
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		TRefPtr(const TRefPtr<U>& other) : TRefPtr(other.get()) {}
+
+		TRefPtr(TRefPtr&& other) noexcept : ptr(other.ptr)
+		{
+			other.ptr = nullptr;
+		}
+
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		TRefPtr(TRefPtr<U>&& other) noexcept : ptr(other.detach()) {}
+
+		~TRefPtr()
+		{
+			if (ptr)
+			{
+				ptr->Release();
+			}
+		}
+
+		TRefPtr& operator=(const TRefPtr& other)
+		{
+			TRefPtr(other).swap(*this);
+			return *this;
+		}
+
+		TRefPtr& operator=(TRefPtr&& other) noexcept
+		{
+			TRefPtr(std::move(other)).swap(*this);
+			return *this;
+		}
+
+		TRefPtr& operator=(T* rawPtr)
+		{
+			TRefPtr(rawPtr).swap(*this);
+			return *this;
+		}
+
+		T& operator*() const { return *ptr; }
+		T* operator->() const { return ptr; }
+
+		explicit operator bool() const { return ptr != nullptr; }
+
+		T* get() const { return ptr; }
+		bool isNull() const { return ptr == nullptr; }
+
+		/**
+		 * @brief Suelta la referencia actual (Release) y queda nulo.
+		 */
+		void reset()
+		{
+			TRefPtr().swap(*this);
+		}
+
+		/**
+		 * @brief Adopta un puntero que ya trae una referencia (sin AddRef).
+		 */
+		void attach(T* rawPtr)
+		{
+			if (ptr)
+			{
+				ptr->Release();
+			}
+			ptr = rawPtr;
+		}
+
+		/**
+		 * @brief Entrega la referencia al llamador sin hacer Release.
+		 */
+		T* detach()
+		{
+			T* old = ptr;
+			ptr = nullptr;
+			return old;
+		}
+
+		/**
+		 * @brief Dirección del puntero interno, para pasar a funciones que leen un T* const*
+		 *        (por ejemplo PSSetShaderResources).
+		 */
+		T* const* getAddressOf() const { return &ptr; }
+
+		/**
+		 * @brief Suelta la referencia actual y devuelve la dirección del puntero
+		 *        interno para que una función Create* escriba en él.
+		 */
+		T** releaseAndGetAddressOf()
+		{
+			reset();
+			return &ptr;
+		}
+
+		void swap(TRefPtr& other) noexcept
+		{
+			std::swap(ptr, other.ptr);
+		}
+
+		bool operator==(const TRefPtr& other) const { return ptr == other.ptr; }
+		bool operator!=(const TRefPtr& other) const { return ptr != other.ptr; }
+
+	private:
+		T* ptr;  ///< Objeto referenciado (una referencia propia si no es nulo).
+	};
+
+	/**
+	 * @brief Crea un objeto derivado de TRefCounted y devuelve la primera referencia.
+	 */
+	template<typename T, typename... Args>
+	TRefPtr<T> MakeRef(Args&&... args)
+	{
+		return TRefPtr<T>(new T(std::forward<Args>(args)...));
+	}
+
+	static_assert(sizeof(TRefPtr<int>) == sizeof(int*), "TRefPtr must be pointer-sized");
+
+	// EXAMPLE
+
+	/*
+	class Material : public EU::TRefCounted<Material>
+	{
+	public:
+		std::string name;
+		explicit Material(const std::string& inName) : name(inName) {}
+	};
+
+	int main()
+	{
+		EU::TRefPtr<Material> shared = EU::MakeRef<Material>("Metal");
+
+		std::vector<EU::TRefPtr<Material>> perActor(10000, shared);  ///< 10000 AddRef, ninguna reserva extra.
+		std::cout << shared->GetRefCount() << std::endl;             ///< 10001
+
+		// Interfaces COM: el Create* escribe una referencia propia en el puntero.
+		// EU::TRefPtr<ID3D11ShaderResourceView> srv;
+		// device->CreateShaderResourceView(texture, &desc, srv.releaseAndGetAddressOf());
+		return 0;
+	}
+	*/
+}
@@ -1,7 +1,7 @@
 ﻿/*
  * MIT License
  *
- * Copyright (c) 2025 Roberto Charreton
+ * Copyright (c) 2024 Roberto Charreton
  *
  * Permission is hereby granted, free of charge, to any person obtaining a copy
  * of this software and associated documentation files (the "Software"), to deal
@@ -27,147 +27,349 @@
  * SOFTWARE.
 */
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "EngineUtilities/Memory/TPoolAllocator.h"
+#include "EngineUtilities/Memory/TRefCount.h"
 
 namespace EU {
+	template<typename T, ESPMode Mode>
+	class TWeakPointer;
+
+	template<typename T, ESPMode Mode>
+	class TSharedPointer;
+
+	/**
+	 * @brief Contadores de las reservas hechas por TSharedPointer/MakeShared.
+	 *
+	 * Solo se actualizan si se compila con EU_SHARED_POINTER_STATS; sirven
+	 * para comparar, por ejemplo, cuántas reservas cuesta crear 100k actores
+	 * con TSharedPointer<T>(new T) frente a MakeShared<T>().
+	 */
+	struct SharedPointerStats
+	{
+		static inline std::atomic<uint64_t> heapAllocations{ 0 };  ///< Bloques del heap (objeto y/o bloque de control).
+		static inline std::atomic<uint64_t> controlBlocks{ 0 };    ///< Bloques de control creados.
+
+		static void reset()
+		{
+			heapAllocations.store(0, std::memory_order_relaxed);
+			controlBlocks.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	namespace detail {
+		inline void
+		countSharedAllocation(uint64_t heapBlocks)
+		{
+#if defined(EU_SHARED_POINTER_STATS)
+			SharedPointerStats::heapAllocations.fetch_add(heapBlocks, std::memory_order_relaxed);
+			SharedPointerStats::controlBlocks.fetch_add(1, std::memory_order_relaxed);
+#else
+			(void)heapBlocks;
+#endif
+		}
+
+		/**
+		 * @brief Bloque de control compartido por todos los TSharedPointer y
+		 *        TWeakPointer de un mismo objeto.
+		 *
+		 * strongCount cuenta los TSharedPointer; weakCount cuenta los
+		 * TWeakPointer más uno que representa a todos los fuertes juntos. El
+		 * objeto se destruye cuando strongCount llega a cero y el bloque cuando
+		 * weakCount llega a cero, así un TWeakPointer siempre puede consultar
+		 * si el objeto sigue vivo.
+		 */
+		template<ESPMode Mode>
+		class TControlBlock
+		{
+		public:
+			TControlBlock() : strongCount(1), weakCount(1) {}
+
+			void addStrong() { strongCount.increment(); }
+			bool tryAddStrong() { return strongCount.incrementIfNotZero(); }
+			void addWeak() { weakCount.increment(); }
+			int32_t getStrongCount() const { return strongCount.get(); }
+
+			void releaseStrong()
+			{
+				if (strongCount.decrement())
+				{
+					destroyObject();
+					releaseWeak();
+				}
+			}
+
+			void releaseWeak()
+			{
+				if (weakCount.decrement())
+				{
+					destroySelf();
+				}
+			}
+
+		protected:
+			virtual ~TControlBlock() {}
+
+			/**
+			 * @brief Destruye el objeto gestionado (strongCount llegó a cero).
+			 */
+			virtual void destroyObject() = 0;
+
+			/**
+			 * @brief Libera el propio bloque (weakCount llegó a cero).
+			 */
+			virtual void destroySelf() { delete this; }
+
+		private:
+			TRefCounter<Mode> strongCount;
+			TRefCounter<Mode> weakCount;
+		};
+
+		/**
+		 * @brief Bloque de control para un objeto reservado aparte con new.
+		 *
+		 * Guarda el puntero con su tipo original, así el objeto se destruye
+		 * correctamente aunque el último TSharedPointer sea de una clase base.
+		 */
+		template<typename T, ESPMode Mode>
+		class TPointerControlBlock : public TControlBlock<Mode>
+		{
+		public:
+			explicit TPointerControlBlock(T* object) : object(object)
+			{
+				countSharedAllocation(2);  ///< El objeto (new T del llamador) y este bloque.
+			}
+
+		protected:
+			void destroyObject() override { delete object; }
+
+		private:
+			T* object;
+		};
+
+		/**
+		 * @brief Bloque de control que contiene al objeto (MakeShared): una sola
+		 *        reserva para ambos, y el objeto queda junto a sus contadores.
+		 *
+		 * El almacenamiento sobrevive al objeto mientras queden TWeakPointer.
+		 */
+		template<typename T, ESPMode Mode>
+		class TInlineControlBlock : public TControlBlock<Mode>
+		{
+		public:
+			template<typename... Args>
+			explicit TInlineControlBlock(Args&&... args)
+			{
+				::new (static_cast<void*>(storage)) T(std::forward<Args>(args)...);
+			}
+
+			T* getObject() { return reinterpret_cast<T*>(storage); }
+
+		protected:
+			void destroyObject() override { getObject()->~T(); }
+
+		private:
+			alignas(T) unsigned char storage[sizeof(T)];
+		};
+
+		/**
+		 * @brief TInlineControlBlock reservado con un asignador externo (AllocateShared).
+		 *
+		 * AllocatorType debe ofrecer void* Allocate(size_t Size, size_t Alignment)
+		 * y void Deallocate(void* Ptr, size_t Size), y vivir más que el bloque.
+		 */
+		template<typename T, ESPMode Mode, typename AllocatorType>
+		class TAllocatedControlBlock : public TInlineControlBlock<T, Mode>
+		{
+		public:
+			template<typename... Args>
+			explicit TAllocatedControlBlock(AllocatorType& allocator, Args&&... args)
+				: TInlineControlBlock<T, Mode>(std::forward<Args>(args)...), allocator(&allocator)
+			{
+			}
+
+		protected:
+			void destroySelf() override
+			{
+				AllocatorType* owner = allocator;
+				this->~TAllocatedControlBlock();
+				owner->Deallocate(this, sizeof(TAllocatedControlBlock));
+			}
+
+		private:
+			AllocatorType* allocator;
+		};
+
+		/**
+		 * @brief TInlineControlBlock sacado del pool global de su tipo
+		 *        (MakeShared con TUsePoolAllocator<T>).
+		 */
+		template<typename T, ESPMode Mode>
+		class TPooledControlBlock : public TInlineControlBlock<T, Mode>
+		{
+		public:
+			template<typename... Args>
+			explicit TPooledControlBlock(Args&&... args)
+				: TInlineControlBlock<T, Mode>(std::forward<Args>(args)...)
+			{
+			}
+
+		protected:
+			void destroySelf() override
+			{
+				this->~TPooledControlBlock();
+				TPoolAllocator<TPooledControlBlock>::Get().Deallocate(this, sizeof(TPooledControlBlock));
+			}
+		};
+
+		/**
+		 * @brief Acceso de las funciones de creación al constructor privado que
+		 *        adopta un bloque de control ya contado.
+		 */
+		struct SharedPointerAccess
+		{
+			template<typename T, ESPMode Mode>
+			static TSharedPointer<T, Mode>
+			adopt(T* object, TControlBlock<Mode>* control)
+			{
+				return TSharedPointer<T, Mode>(object, control);
+			}
+		};
+	}
+
 	/**
 	 * @brief Clase TSharedPointer para manejar la gestión de memoria compartida.
 	 *
 	 * La clase TSharedPointer gestiona la memoria de un objeto de tipo T y lleva un
 	 * recuento de referencias para permitir la compartición segura de un mismo objeto
 	 * en múltiples instancias de TSharedPointer.
+	 *
+	 * El recuento vive en un bloque de control con contadores fuertes y débiles.
+	 * Con Mode = ESPMode::ThreadSafe (por defecto) los contadores son atómicos y
+	 * se pueden copiar y soltar punteros al mismo objeto desde varios hilos; con
+	 * ESPMode::NotThreadSafe el conteo es más barato pero de un solo hilo.
+	 *
+	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Mode Política de conteo de referencias.
 	 */
-	template<typename T>
+	template<typename T, ESPMode Mode = ESPMode::ThreadSafe>
 	class TSharedPointer
 	{
 	public:
+		typedef detail::TControlBlock<Mode> ControlBlock;
+
 		/**
 		 * @brief Constructor por defecto.
 		 *
-		 * Inicializa el puntero y el recuento de referencias a nullptr.
+		 * Inicializa el puntero y el bloque de control a nullptr.
 		 */
-		TSharedPointer() : ptr(nullptr), refCount(nullptr) {}
+		TSharedPointer() : ptr(nullptr), control(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un puntero crudo.
 		 *
+		 * Si no se puede reservar el bloque de control, el objeto se destruye
+		 * antes de propagar la excepción (como std::shared_ptr).
+		 *
 		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
 		 */
-		explicit TSharedPointer(T* rawPtr) : ptr(rawPtr), refCount(new int(1)) {}
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		explicit TSharedPointer(U* rawPtr)
+			: ptr(rawPtr), control(rawPtr ? createPointerControl(rawPtr) : nullptr)
+		{
+		}
 
 		/**
-		 * @brief Constructor desde un puntero crudo y un recuento de referencias.
+		 * @brief Constructor de copia.
+		 *
+		 * Copia el puntero y el bloque de control del otro TSharedPointer y
+		 * aumenta el recuento de referencias.
 		 *
-		 * @param rawPtr Puntero crudo al objeto gestionado.
-		 * @param existingRefCount Puntero al recuento de referencias existente.
+		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(T* rawPtr, int* existingRefCount) : ptr(rawPtr), refCount(existingRefCount)
+		TSharedPointer(const TSharedPointer& other) : ptr(other.ptr), control(other.control)
 		{
-			if (refCount)
+			if (control)
 			{
-				++(*refCount);
+				control->addStrong();
 			}
 		}
 
 		/**
-		 * @brief Constructor de copia.
-		 *
-		 * Copia el puntero y el recuento de referencias del otro TSharedPointer y
-		 * aumenta el recuento de referencias.
-		 *
-		 * @param other Otro objeto TSharedPointer del mismo tipo T.
+		 * @brief Constructor de conversión desde un TSharedPointer de una clase derivada.
 		 */
-		TSharedPointer(const TSharedPointer<T>& other) : ptr(other.ptr), refCount(other.refCount)
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		TSharedPointer(const TSharedPointer<U, Mode>& other) : ptr(other.ptr), control(other.control)
 		{
-			if (refCount)
+			if (control)
 			{
-				++(*refCount);
+				control->addStrong();
 			}
 		}
 
 		/**
 		 * @brief Constructor de movimiento.
 		 *
-		 * Transfiere la propiedad del puntero y el recuento de referencias del otro
+		 * Transfiere la propiedad del puntero y el bloque de control del otro
 		 * TSharedPointer al nuevo objeto TSharedPointer.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		TSharedPointer(TSharedPointer<T>&& other) noexcept : ptr(other.ptr), refCount(other.refCount)
+		TSharedPointer(TSharedPointer&& other) noexcept : ptr(other.ptr), control(other.control)
+		{
+			other.ptr = nullptr;
+			other.control = nullptr;
+		}
+
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		TSharedPointer(TSharedPointer<U, Mode>&& other) noexcept : ptr(other.ptr), control(other.control)
 		{
 			other.ptr = nullptr;
-			other.refCount = nullptr;
+			other.control = nullptr;
 		}
 
 		/**
 		 * @brief Operador de asignación de copia.
 		 *
-		 * Libera el objeto actual, copia el puntero y el recuento de referencias del otro
-		 * TSharedPointer, y aumenta el recuento de referencias.
-		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(const TSharedPointer<T>& other)
+		TSharedPointer& operator=(const TSharedPointer& other)
 		{
-			if (this != &other)
-			{
-				// Disminuir el recuento de referencias del objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
-				// Copiar datos del otro puntero compartido
-				ptr = other.ptr;
-				refCount = other.refCount;
-				if (refCount)
-				{
-					++(*refCount);
-				}
-			}
+			TSharedPointer(other).swap(*this);
 			return *this;
 		}
 
 		/**
 		 * @brief Operador de asignación de movimiento.
 		 *
-		 * Libera el objeto actual, transfiere la propiedad del puntero y el recuento de
-		 * referencias del otro TSharedPointer al actual.
+		 * Libera el objeto actual y transfiere la propiedad del otro TSharedPointer al actual.
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 * @return Referencia al objeto TSharedPointer actual.
 		 */
-		TSharedPointer<T>& operator=(TSharedPointer<T>&& other) noexcept
+		TSharedPointer& operator=(TSharedPointer&& other) noexcept
 		{
-			if (this != &other)
-			{
-				// Liberar el objeto actual
-				if (refCount && --(*refCount) == 0)
-				{
-					delete ptr;
-					delete refCount;
-				}
-				// Transferir los datos del otro puntero compartido
-				ptr = other.ptr;
-				refCount = other.refCount;
-				other.ptr = nullptr;
-				other.refCount = nullptr;
-			}
+			TSharedPointer(std::move(other)).swap(*this);
 			return *this;
 		}
 
 		/**
 		 * @brief Destructor.
 		 *
-		 * Disminuye el recuento de referencias y libera la memoria del objeto
-		 * gestionado si el recuento de referencias llega a cero.
+		 * Disminuye el recuento de referencias y libera el objeto gestionado si
+		 * el recuento llega a cero.
 		 */
 		~TSharedPointer()
 		{
-			if (refCount && --(*refCount) == 0)
+			if (control)
 			{
-				delete ptr;
-				delete refCount;
+				control->releaseStrong();
 			}
 		}
 
@@ -204,10 +406,11 @@ namespace EU {
 		 */
 		bool isNull() const { return ptr == nullptr; }
 
-
-	public:
-		T* ptr;       ///< Puntero al objeto gestionado.
-		int* refCount; ///< Puntero al recuento de referencias.
+		/**
+		 * @brief Número de TSharedPointer que comparten el objeto (orientativo
+		 *        si otros hilos están copiando o soltando referencias).
+		 */
+		int32_t useCount() const { return control ? control->getStrongCount() : 0; }
 
 		/**
 		 * @brief Método swap.
@@ -216,73 +419,149 @@ namespace EU {
 		 *
 		 * @param other Otro objeto TSharedPointer del mismo tipo T.
 		 */
-		void swap(TSharedPointer<T>& other) noexcept
+		void swap(TSharedPointer& other) noexcept
 		{
-			T* tempPtr = other.ptr;
-			int* tempRefCount = other.refCount;
-
-			other.ptr = this->ptr;
-			other.refCount = this->refCount;
-
-			this->ptr = tempPtr;
-			this->refCount = tempRefCount;
+			std::swap(ptr, other.ptr);
+			std::swap(control, other.control);
 		}
 
 		/**
-				 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
-				 *
-				 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar (por defecto es nullptr).
-				 */
+		 * @brief Libera el objeto actual y opcionalmente asigna un nuevo objeto.
+		 *
+		 * @param newPtr Nuevo puntero crudo al objeto que se va a gestionar (por defecto es nullptr).
+		 */
 		void reset(T* newPtr = nullptr)
 		{
-			// Disminuir el recuento de referencias del objeto actual
-			if (refCount && --(*refCount) == 0)
-			{
-				delete ptr;
-				delete refCount;
-			}
-
-			// Si newPtr es nullptr, asignar nullptr al puntero y recuento de referencias
-			if (newPtr == nullptr)
-			{
-				ptr = nullptr;
-				refCount = nullptr;
-			}
-			else
-			{
-				// Asignar nuevo objeto y manejar el recuento de referencias
-				ptr = newPtr;
-				refCount = new int(1);
-			}
+			TSharedPointer(newPtr).swap(*this);
 		}
 
 		// Método de conversión para hacer cast dinámico
 		template<typename U>
-		TSharedPointer<U> dynamic_pointer_cast() const {
+		TSharedPointer<U, Mode> dynamic_pointer_cast() const {
 			// Intenta convertir el puntero de tipo T a U
 			U* castedPtr = dynamic_cast<U*>(ptr);
 			if (castedPtr) {
-				// Si la conversión es exitosa, devuelve un nuevo TSharedPointer<U>
-				return TSharedPointer<U>(castedPtr, refCount);
+				// Si la conversión es exitosa, comparte el bloque de control
+				control->addStrong();
+				return TSharedPointer<U, Mode>(castedPtr, control);
 			}
-			else {
-				// Si falla la conversión, devuelve un TSharedPointer<U> nulo
-				return TSharedPointer<U>();
+			// Si falla la conversión, devuelve un TSharedPointer<U> nulo
+			return TSharedPointer<U, Mode>();
+		}
+
+		// Cast estático (sin comprobación en tiempo de ejecución)
+		template<typename U>
+		TSharedPointer<U, Mode> static_pointer_cast() const {
+			if (control) {
+				control->addStrong();
 			}
+			return TSharedPointer<U, Mode>(static_cast<U*>(ptr), control);
 		}
+
+	private:
+		template<typename U, ESPMode M>
+		friend class TSharedPointer;
+
+		template<typename U, ESPMode M>
+		friend class TWeakPointer;
+
+		friend struct detail::SharedPointerAccess;
+
+		/**
+		 * @brief Adopta una referencia fuerte ya contada en el bloque de control.
+		 */
+		TSharedPointer(T* rawPtr, ControlBlock* existingControl) : ptr(rawPtr), control(existingControl) {}
+
+		/**
+		 * @brief Crea el bloque de control de un objeto reservado por el
+		 *        llamador; si falla, borra el objeto y relanza.
+		 */
+		template<typename U>
+		static ControlBlock* createPointerControl(U* rawPtr)
+		{
+			try
+			{
+				return new detail::TPointerControlBlock<U, Mode>(rawPtr);
+			}
+			catch (...)
+			{
+				delete rawPtr;
+				throw;
+			}
+		}
+
+		T* ptr;                 ///< Puntero al objeto gestionado.
+		ControlBlock* control;  ///< Bloque de control con los recuentos (nullptr si es nulo).
 	};
 
 	/**
 	 * @brief Función de utilidad para crear un TSharedPointer.
 	 *
+	 * El objeto y su bloque de control se crean en una sola reserva de
+	 * memoria (en lugar de dos con TSharedPointer<T>(new T)). Si el tipo
+	 * se marcó con EU_POOL_ALLOCATED, esa reserva sale del pool de su tipo.
+	 *
 	 * @tparam T Tipo del objeto gestionado.
+	 * @tparam Mode Política de conteo de referencias.
 	 * @tparam Args Tipos de los argumentos del constructor del objeto gestionado.
 	 * @param args Argumentos del constructor del objeto gestionado.
 	 * @return Un objeto TSharedPointer gestionando un nuevo objeto de tipo T.
 	 */
-	template<typename T, typename... Args>
-	TSharedPointer<T> MakeShared(Args... args)
+	template<typename T, ESPMode Mode = ESPMode::ThreadSafe, typename... Args>
+	TSharedPointer<T, Mode> MakeShared(Args&&... args)
 	{
-		return TSharedPointer<T>(new T(args...));
+		if constexpr (TUsePoolAllocator<T>::value)
+		{
+			typedef detail::TPooledControlBlock<T, Mode> BlockType;
+			TPoolAllocator<BlockType>& pool = TPoolAllocator<BlockType>::Get();
+
+			void* memory = pool.Allocate(sizeof(BlockType), alignof(BlockType));
+			BlockType* block;
+			try
+			{
+				block = ::new (memory) BlockType(std::forward<Args>(args)...);
+			}
+			catch (...)
+			{
+				pool.Deallocate(memory, sizeof(BlockType));
+				throw;
+			}
+			detail::countSharedAllocation(0);
+			return detail::SharedPointerAccess::adopt<T, Mode>(block->getObject(), block);
+		}
+		else
+		{
+			detail::TInlineControlBlock<T, Mode>* block = new detail::TInlineControlBlock<T, Mode>(std::forward<Args>(args)...);
+			detail::countSharedAllocation(1);
+			return detail::SharedPointerAccess::adopt<T, Mode>(block->getObject(), block);
+		}
 	}
-}
\ No newline at end of file
+
+	/**
+	 * @brief Igual que MakeShared pero reserva el bloque con un asignador
+	 *        propio (por ejemplo un pool de objetos del mismo tamaño).
+	 *
+	 * @param allocator Asignador con Allocate(Size, Alignment) y
+	 *        Deallocate(Ptr, Size); debe vivir más que todos los punteros.
+	 */
+	template<typename T, ESPMode Mode = ESPMode::ThreadSafe, typename AllocatorType, typename... Args>
+	TSharedPointer<T, Mode> AllocateShared(AllocatorType& allocator, Args&&... args)
+	{
+		typedef detail::TAllocatedControlBlock<T, Mode, AllocatorType> BlockType;
+
+		void* memory = allocator.Allocate(sizeof(BlockType), alignof(BlockType));
+		BlockType* block;
+		try
+		{
+			block = ::new (memory) BlockType(allocator, std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			allocator.Deallocate(memory, sizeof(BlockType));
+			throw;
+		}
+		detail::countSharedAllocation(0);
+		return detail::SharedPointerAccess::adopt<T, Mode>(block->getObject(), block);
+	}
+
+}
@@ -0,0 +1,366 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace EU {
+	/**
+	 * @brief Borrador por defecto de TUniquePtr: delete (o delete[] para arrays).
+	 */
+	template<typename T>
+	struct TDefaultDelete
+	{
+		TDefaultDelete() = default;
+
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		TDefaultDelete(const TDefaultDelete<U>&) {}
+
+		void operator()(T* ptr) const
+		{
+			static_assert(sizeof(T) > 0, "TDefaultDelete: cannot delete an incomplete type");
+			delete ptr;
+		}
+	};
+
+	template<typename T>
+	struct TDefaultDelete<T[]>
+	{
+		void operator()(T* ptr) const
+		{
+			static_assert(sizeof(T) > 0, "TDefaultDelete: cannot delete an incomplete type");
+			delete[] ptr;
+		}
+	};
+
+	/**
+	 * @brief Borrador para objetos COM (ID3D11Buffer, ID3D11Texture2D, ...):
+	 *        libera la referencia con Release() en lugar de delete.
+	 */
+	struct TComReleaser
+	{
+		template<typename T>
+		void operator()(T* ptr) const
+		{
+			ptr->Release();
+		}
+	};
+
+	namespace detail {
+		/**
+		 * @brief Guarda el puntero y el borrador. Si el borrador no tiene
+		 *        estado se hereda de él (optimización de base vacía), así
+		 *        TUniquePtr ocupa lo mismo que un puntero crudo.
+		 */
+		template<typename Pointer, typename Deleter,
+		         bool bEmpty = std::is_empty<Deleter>::value && !std::is_final<Deleter>::value>
+		class TUniqueStorage : private Deleter
+		{
+		public:
+			TUniqueStorage(Pointer inPtr, const Deleter& inDeleter) : Deleter(inDeleter), ptr(inPtr) {}
+			TUniqueStorage(Pointer inPtr, Deleter&& inDeleter) : Deleter(std::move(inDeleter)), ptr(inPtr) {}
+
+			Deleter& deleter() { return *this; }
+			const Deleter& deleter() const { return *this; }
+
+			Pointer ptr;
+		};
+
+		template<typename Pointer, typename Deleter>
+		class TUniqueStorage<Pointer, Deleter, false>
+		{
+		public:
+			TUniqueStorage(Pointer inPtr, const Deleter& inDeleter) : ptr(inPtr), del(inDeleter) {}
+			TUniqueStorage(Pointer inPtr, Deleter&& inDeleter) : ptr(inPtr), del(std::move(inDeleter)) {}
+
+			Deleter& deleter() { return del; }
+			const Deleter& deleter() const { return del; }
+
+			Pointer ptr;
+
+		private:
+			Deleter del;
+		};
+	}
+
+	/**
+	 * @brief Clase TUniquePtr para manejar un objeto con un único propietario.
+	 *
+	 * Solo se puede mover, no copiar; al destruirse libera el objeto con
+	 * Deleter. No tiene contador de referencias: copiar, mover o destruir un
+	 * TUniquePtr no toca memoria compartida, y con un borrador sin estado
+	 * ocupa lo mismo que un puntero crudo.
+	 *
+	 * @tparam T Tipo del objeto gestionado (T[] para arrays).
+	 * @tparam Deleter Borrador; por defecto TDefaultDelete<T>.
+	 */
+	template<typename T, typename Deleter = TDefaultDelete<T>>
+	class TUniquePtr
+	{
+	public:
+		/**
+		 * @brief Constructor por defecto: puntero nulo.
+		 */
+		TUniquePtr() : storage(nullptr, Deleter()) {}
+		TUniquePtr(std::nullptr_t) : storage(nullptr, Deleter()) {}
+
+		/**
+		 * @brief Constructor que toma la propiedad de un puntero crudo.
+		 *
+		 * @param rawPtr Puntero crudo al objeto que se va a gestionar.
+		 */
+		explicit TUniquePtr(T* rawPtr) : storage(rawPtr, Deleter()) {}
+
+		/**
+		 * @brief Constructor con un borrador con estado.
+		 */
+		TUniquePtr(T* rawPtr, const Deleter& deleter) : storage(rawPtr, deleter) {}
+
+		TUniquePtr(const TUniquePtr&) = delete;
+		TUniquePtr& operator=(const TUniquePtr&) = delete;
+
+		/**
+		 * @brief Constructor de movimiento: transfiere la propiedad.
+		 */
+		TUniquePtr(TUniquePtr&& other) noexcept
+			: storage(other.release(), std::move(other.getDeleter()))
+		{
+		}
+
+		/**
+		 * @brief Conversión desde un TUniquePtr de una clase derivada.
+		 */
+		template<typename U, typename E,
+		         typename = typename std::enable_if<std::is_convertible<U*, T*>::value && !std::is_array<U>::value>::type>
+		TUniquePtr(TUniquePtr<U, E>&& other) noexcept
+			: storage(other.release(), Deleter(std::move(other.getDeleter())))
+		{
+		}
+
+		TUniquePtr& operator=(TUniquePtr&& other) noexcept
+		{
+			reset(other.release());
+			getDeleter() = std::move(other.getDeleter());
+			return *this;
+		}
+
+		TUniquePtr& operator=(std::nullptr_t)
+		{
+			reset();
+			return *this;
+		}
+
+		/**
+		 * @brief Destructor: libera el objeto gestionado.
+		 */
+		~TUniquePtr()
+		{
+			if (storage.ptr)
+			{
+				getDeleter()(storage.ptr);
+			}
+		}
+
+		T& operator*() const { return *storage.ptr; }
+		T* operator->() const { return storage.ptr; }
+
+		explicit operator bool() const { return storage.ptr != nullptr; }
+
+		/**
+		 * @brief Obtener el puntero crudo (sigue siendo propiedad del TUniquePtr).
+		 */
+		T* get() const { return storage.ptr; }
+
+		/**
+		 * @brief Comprobar si el puntero es nulo.
+		 */
+		bool isNull() const { return storage.ptr == nullptr; }
+
+		Deleter& getDeleter() { return storage.deleter(); }
+		const Deleter& getDeleter() const { return storage.deleter(); }
+
+		/**
+		 * @brief Renuncia a la propiedad sin liberar el objeto.
+		 *
+		 * @return El puntero crudo, que ahora debe liberar el llamador.
+		 */
+		T* release()
+		{
+			T* old = storage.ptr;
+			storage.ptr = nullptr;
+			return old;
+		}
+
+		/**
+		 * @brief Libera el objeto actual y toma la propiedad de newPtr.
+		 */
+		void reset(T* newPtr = nullptr)
+		{
+			T* old = storage.ptr;
+			storage.ptr = newPtr;
+			if (old)
+			{
+				getDeleter()(old);
+			}
+		}
+
+		void swap(TUniquePtr& other) noexcept
+		{
+			std::swap(storage, other.storage);
+		}
+
+	private:
+		detail::TUniqueStorage<T*, Deleter> storage;
+	};
+
+	/**
+	 * @brief Especialización para arrays: operator[] en lugar de -> y *.
+	 */
+	template<typename T, typename Deleter>
+	class TUniquePtr<T[], Deleter>
+	{
+	public:
+		TUniquePtr() : storage(nullptr, Deleter()) {}
+		TUniquePtr(std::nullptr_t) : storage(nullptr, Deleter()) {}
+		explicit TUniquePtr(T* rawPtr) : storage(rawPtr, Deleter()) {}
+		TUniquePtr(T* rawPtr, const Deleter& deleter) : storage(rawPtr, deleter) {}
+
+		TUniquePtr(const TUniquePtr&) = delete;
+		TUniquePtr& operator=(const TUniquePtr&) = delete;
+
+		TUniquePtr(TUniquePtr&& other) noexcept
+			: storage(other.release(), std::move(other.getDeleter()))
+		{
+		}
+
+		TUniquePtr& operator=(TUniquePtr&& other) noexcept
+		{
+			reset(other.release());
+			getDeleter() = std::move(other.getDeleter());
+			return *this;
+		}
+
+		TUniquePtr& operator=(std::nullptr_t)
+		{
+			reset();
+			return *this;
+		}
+
+		~TUniquePtr()
+		{
+			if (storage.ptr)
+			{
+				getDeleter()(storage.ptr);
+			}
+		}
+
+		T& operator[](size_t index) const { return storage.ptr[index]; }
+
+		explicit operator bool() const { return storage.ptr != nullptr; }
+
+		T* get() const { return storage.ptr; }
+		bool isNull() const { return storage.ptr == nullptr; }
+
+		Deleter& getDeleter() { return storage.deleter(); }
+		const Deleter& getDeleter() const { return storage.deleter(); }
+
+		T* release()
+		{
+			T* old = storage.ptr;
+			storage.ptr = nullptr;
+			return old;
+		}
+
+		void reset(T* newPtr = nullptr)
+		{
+			T* old = storage.ptr;
+			storage.ptr = newPtr;
+			if (old)
+			{
+				getDeleter()(old);
+			}
+		}
+
+		void swap(TUniquePtr& other) noexcept
+		{
+			std::swap(storage, other.storage);
+		}
+
+	private:
+		detail::TUniqueStorage<T*, Deleter> storage;
+	};
+
+	/**
+	 * @brief Crea un objeto de tipo T gestionado por un TUniquePtr.
+	 *
+	 * @param args Argumentos del constructor de T.
+	 */
+	template<typename T, typename... Args>
+	typename std::enable_if<!std::is_array<T>::value, TUniquePtr<T>>::type
+	MakeUnique(Args&&... args)
+	{
+		return TUniquePtr<T>(new T(std::forward<Args>(args)...));
+	}
+
+	/**
+	 * @brief Crea un array de count elementos inicializados a su valor por defecto.
+	 */
+	template<typename T>
+	typename std::enable_if<std::is_array<T>::value && std::extent<T>::value == 0, TUniquePtr<T>>::type
+	MakeUnique(size_t count)
+	{
+		typedef typename std::remove_extent<T>::type ElementType;
+		return TUniquePtr<T>(new ElementType[count]());
+	}
+
+	static_assert(sizeof(TUniquePtr<int>) == sizeof(int*), "TUniquePtr must not add overhead with an empty deleter");
+	static_assert(sizeof(TUniquePtr<int[]>) == sizeof(int*), "TUniquePtr must not add overhead with an empty deleter");
+
+	// EXAMPLE
+
+	/*
+	struct Scratch { std::vector<float> positions; };
+
+	int main()
+	{
+		EU::TUniquePtr<Scratch> scratch = EU::MakeUnique<Scratch>();  ///< Un único dueño: sin contador de referencias.
+		scratch->positions.resize(1024);
+
+		EU::TUniquePtr<Scratch> owner = std::move(scratch);  ///< scratch queda nulo.
+
+		EU::TUniquePtr<float[]> weights = EU::MakeUnique<float[]>(256);
+		weights[0] = 1.0f;
+
+		// Objetos COM de D3D11: Release() al salir del ámbito.
+		// EU::TUniquePtr<ID3D11Buffer, EU::TComReleaser> buffer(rawBuffer);
+		return 0;
+	}
+	*/
+}
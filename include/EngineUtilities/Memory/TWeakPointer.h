@@ -37,22 +37,57 @@ namespace
 		 * La clase TWeakPointer proporciona una manera de observar un objeto gestionado por un TSharedPointer
 		 * sin tener influencia sobre el recuento de referencias del objeto. Permite acceder al objeto solo si
 		 * aún existe.
+		 *
+		 * Mantiene vivo el bloque de control (no el objeto), por lo que lock()
+		 * distingue siempre un objeto destruido de uno vivo, también cuando otro
+		 * hilo suelta la última referencia fuerte a la vez.
 		 */
-	template<typename T>
+	template<typename T, ESPMode Mode = ESPMode::ThreadSafe>
 	class TWeakPointer {
 	public:
+		typedef detail::TControlBlock<Mode> ControlBlock;
+
 		/**
 		 * @brief Constructor por defecto.
 		 */
-		TWeakPointer() : ptr(nullptr), refCount(nullptr) {}
+		TWeakPointer() : ptr(nullptr), control(nullptr) {}
 
 		/**
 		 * @brief Constructor que toma un TSharedPointer.
 		 *
 		 * @param sharedPtr TSharedPointer desde el cual se observará el objeto.
 		 */
-		TWeakPointer(const TSharedPointer<T>& sharedPtr)
-			: ptr(sharedPtr.ptr), refCount(sharedPtr.refCount) {
+		template<typename U, typename = typename std::enable_if<std::is_convertible<U*, T*>::value>::type>
+		TWeakPointer(const TSharedPointer<U, Mode>& sharedPtr)
+			: ptr(sharedPtr.ptr), control(sharedPtr.control) {
+			if (control) {
+				control->addWeak();
+			}
+		}
+
+		TWeakPointer(const TWeakPointer& other)
+			: ptr(other.ptr), control(other.control) {
+			if (control) {
+				control->addWeak();
+			}
+		}
+
+		TWeakPointer(TWeakPointer&& other) noexcept
+			: ptr(other.ptr), control(other.control) {
+			other.ptr = nullptr;
+			other.control = nullptr;
+		}
+
+		TWeakPointer&
+			operator=(TWeakPointer other) noexcept {
+			swap(other);
+			return *this;
+		}
+
+		~TWeakPointer() {
+			if (control) {
+				control->releaseWeak();
+			}
 		}
 
 		/**
@@ -60,21 +95,39 @@ namespace
 		 *
 		 * @return Un TSharedPointer al objeto gestionado, o nullptr si el objeto ha sido destruido.
 		 */
-		TSharedPointer<T>
+		TSharedPointer<T, Mode>
 			lock() const {
-			if (refCount && *refCount > 0) {
-				return TSharedPointer<T>(ptr, refCount);
+			if (control && control->tryAddStrong()) {
+				return TSharedPointer<T, Mode>(ptr, control);
 			}
-			return TSharedPointer<T>();
+			return TSharedPointer<T, Mode>();
+		}
+
+		/**
+		 * @brief Indica si el objeto observado ya fue destruido.
+		 */
+		bool
+			expired() const {
+			return !control || control->getStrongCount() == 0;
 		}
 
-		// Hacer que TSharedPointer sea un amigo para acceder a los miembros privados.
-		template<typename U>
-		friend class TSharedPointer;
+		/**
+		 * @brief Deja de observar el objeto.
+		 */
+		void
+			reset() {
+			TWeakPointer().swap(*this);
+		}
+
+		void
+			swap(TWeakPointer& other) noexcept {
+			std::swap(ptr, other.ptr);
+			std::swap(control, other.control);
+		}
 
 	private:
-		T* ptr;       ///< Puntero al objeto observado.
-		int* refCount; ///< Puntero al recuento de referencias del TSharedPointer original.
+		T* ptr;                 ///< Puntero al objeto observado.
+		ControlBlock* control;  ///< Bloque de control compartido con los TSharedPointer.
 	};
 
 	/*
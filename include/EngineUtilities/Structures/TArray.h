@@ -26,20 +26,34 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
 */
-
 #pragma once
+#include <cassert>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "EngineUtilities/Memory/TAllocator.h"
+
 namespace EU {
 	/**
 	 * @brief TArray es una clase de array dinámica para almacenar elementos de tipo T.
 	 *
-	 * Esta implementación de TArray proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de elementos, con operaciones básicas como agregar, eliminar y acceder a elementos.
-	 * La memoria se gestiona dinámicamente, aumentando la capacidad del array según sea necesario.
+	 * La memoria se reserva sin inicializar y los elementos se construyen en
+	 * sitio (placement new) solo cuando se añaden; al crecer se mueven, no se
+	 * copian, y los tipos trivialmente copiables se reubican con memcpy.
+	 * El asignador es un parámetro: TInlineArray<T, N> guarda hasta N
+	 * elementos dentro del propio objeto sin tocar el heap.
+	 *
+	 * Añadir elementos puede reubicar el array: los punteros y referencias
+	 * obtenidos antes dejan de ser válidos.
 	 *
 	 * @tparam T El tipo de elementos almacenados en el array.
+	 * @tparam Allocator Asignador de memoria (ver TAllocator.h).
 	 */
-	template<typename T>
-	class TArray
+	template<typename T, typename Allocator = TDefaultAllocator<T>>
+	class TArray : private Allocator
 	{
 	private:
 		T* Data;           ///< Puntero a la memoria donde se almacenan los elementos del array.
@@ -47,82 +61,343 @@ namespace EU {
 		size_t Size;       ///< Número de elementos actualmente en el array.
 
 		/**
-		 * @brief Redimensiona el array para tener una nueva capacidad.
+		 * @brief Mueve Count elementos de Source a la memoria sin inicializar
+		 *        Dest y destruye los originales.
+		 */
+		static void Relocate(T* Dest, T* Source, size_t Count)
+		{
+			if constexpr (std::is_trivially_copyable<T>::value)
+			{
+				if (Count)
+				{
+					std::memcpy(static_cast<void*>(Dest), Source, Count * sizeof(T));
+				}
+				return;
+			}
+			for (size_t i = 0; i < Count; ++i)
+			{
+				::new (static_cast<void*>(Dest + i)) T(std::move(Source[i]));
+				Source[i].~T();
+			}
+		}
+
+		static void DestroyRange(T* First, size_t Count)
+		{
+			if constexpr (!std::is_trivially_destructible<T>::value)
+			{
+				for (size_t i = 0; i < Count; ++i)
+				{
+					First[i].~T();
+				}
+			}
+		}
+
+		bool IsInline()
+		{
+			return Data == Allocator::InlineData();
+		}
+
+		/**
+		 * @brief Capacidad real de un bloque: el espacio interno del asignador
+		 *        puede ser mayor que lo pedido.
+		 */
+		size_t CapacityOf(T* Block, size_t Requested)
+		{
+			return Block == Allocator::InlineData() && Requested < Allocator::InlineCapacity()
+				? Allocator::InlineCapacity() : Requested;
+		}
+
+		/**
+		 * @brief Cambia la capacidad del array moviendo los elementos existentes.
 		 *
-		 * @param NewCapacity La nueva capacidad del array.
+		 * @param NewCapacity La nueva capacidad del array (>= Size).
 		 */
-		void Resize(size_t NewCapacity)
+		void Reallocate(size_t NewCapacity)
 		{
-			T* NewData = new T[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
-			for (size_t i = 0; i < Size; ++i)
+			T* NewData = this->Allocate(NewCapacity);
+			if (NewData == Data)
 			{
-				NewData[i] = Data[i];  ///< Copiar los elementos existentes al nuevo bloque de memoria.
+				return;
 			}
-			delete[] Data;  ///< Liberar la memoria del array antiguo.
-			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
-			Capacity = NewCapacity;  ///< Actualizar la capacidad del array.
+			Relocate(NewData, Data, Size);
+			this->Deallocate(Data, Capacity);
+			Data = NewData;
+			Capacity = CapacityOf(NewData, NewCapacity);
+		}
+
+		size_t GrowCapacity(size_t MinCapacity) const
+		{
+			const size_t Doubled = Capacity < 4 ? 4 : Capacity * 2;
+			return Doubled > MinCapacity ? Doubled : MinCapacity;
+		}
+
+		/**
+		 * @brief Crece y construye el nuevo elemento antes de mover los viejos,
+		 *        así Args puede referirse a un elemento del propio array.
+		 */
+		template<typename... Args>
+		T& EmplaceGrow(Args&&... InArgs)
+		{
+			const size_t NewCapacity = GrowCapacity(Size + 1);
+			T* NewData = this->Allocate(NewCapacity);
+			::new (static_cast<void*>(NewData + Size)) T(std::forward<Args>(InArgs)...);
+			Relocate(NewData, Data, Size);
+			this->Deallocate(Data, Capacity);
+			Data = NewData;
+			Capacity = CapacityOf(NewData, NewCapacity);
+			return Data[Size++];
+		}
+
+		/**
+		 * @brief Toma los elementos de Other: roba su bloque del heap o, si
+		 *        están en su almacenamiento interno, los mueve uno a uno.
+		 */
+		void MoveFrom(TArray& Other)
+		{
+			if (Other.IsInline())
+			{
+				Relocate(Data, Other.Data, Other.Size);
+				Size = Other.Size;
+				Other.Size = 0;
+				return;
+			}
+			Data = Other.Data;
+			Capacity = Other.Capacity;
+			Size = Other.Size;
+			Other.Data = Other.Allocator::InlineData();
+			Other.Capacity = Allocator::InlineCapacity();
+			Other.Size = 0;
 		}
 
 	public:
+		typedef T ElementType;
+
+		/**
+		 * @brief Constructor por defecto; no reserva memoria (salvo el espacio interno del asignador).
+		 */
+		TArray()
+			: Data(Allocator::InlineData()), Capacity(Allocator::InlineCapacity()), Size(0)
+		{
+		}
+
 		/**
-		 * @brief Constructor por defecto que inicializa el array con capacidad y tamaño cero.
+		 * @brief Construye el array a partir de una lista de elementos.
 		 */
-		TArray() : Data(nullptr), Capacity(0), Size(0)	{}
+		TArray(std::initializer_list<T> Elements)
+			: TArray()
+		{
+			Reserve(Elements.size());
+			for (const T& Element : Elements)
+			{
+				::new (static_cast<void*>(Data + Size++)) T(Element);
+			}
+		}
+
+		TArray(const TArray& Other)
+			: Allocator(Other), Data(Allocator::InlineData()), Capacity(Allocator::InlineCapacity()), Size(0)
+		{
+			Reserve(Other.Size);
+			for (size_t i = 0; i < Other.Size; ++i)
+			{
+				::new (static_cast<void*>(Data + i)) T(Other.Data[i]);
+			}
+			Size = Other.Size;
+		}
+
+		TArray(TArray&& Other) noexcept
+			: Allocator(std::move(static_cast<Allocator&>(Other))),
+			  Data(Allocator::InlineData()), Capacity(Allocator::InlineCapacity()), Size(0)
+		{
+			MoveFrom(Other);
+		}
+
+		TArray& operator=(const TArray& Other)
+		{
+			if (this != &Other)
+			{
+				Empty();
+				Reserve(Other.Size);
+				for (size_t i = 0; i < Other.Size; ++i)
+				{
+					::new (static_cast<void*>(Data + i)) T(Other.Data[i]);
+				}
+				Size = Other.Size;
+			}
+			return *this;
+		}
+
+		TArray& operator=(TArray&& Other) noexcept
+		{
+			if (this != &Other)
+			{
+				DestroyRange(Data, Size);
+				this->Deallocate(Data, Capacity);
+				Data = Allocator::InlineData();
+				Capacity = Allocator::InlineCapacity();
+				Size = 0;
+				static_cast<Allocator&>(*this) = std::move(static_cast<Allocator&>(Other));
+				MoveFrom(Other);
+			}
+			return *this;
+		}
 
 		/**
-		 * @brief Destructor que libera la memoria asignada al array.
+		 * @brief Destructor que destruye los elementos y libera la memoria asignada al array.
 		 */
-		~TArray()	{
-			delete[] Data;  ///< Liberar la memoria del array.
+		~TArray()
+		{
+			DestroyRange(Data, Size);
+			this->Deallocate(Data, Capacity);
 		}
 
 		/**
 		 * @brief Añade un nuevo elemento al final del array.
 		 *
 		 * @param Element El elemento a añadir al array.
+		 * @return El índice del elemento añadido.
 		 */
-		void Add(const T& Element)
+		size_t Add(const T& Element)
+		{
+			Emplace(Element);
+			return Size - 1;
+		}
+
+		/**
+		 * @brief Versión de Add que mueve el elemento.
+		 */
+		size_t Add(T&& Element)
+		{
+			Emplace(std::move(Element));
+			return Size - 1;
+		}
+
+		/**
+		 * @brief Construye un elemento al final del array con los argumentos dados.
+		 *
+		 * @return Referencia al elemento construido.
+		 */
+		template<typename... Args>
+		T& Emplace(Args&&... InArgs)
 		{
 			if (Size == Capacity)
 			{
-				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
+				return EmplaceGrow(std::forward<Args>(InArgs)...);
 			}
-			Data[Size++] = Element;  ///< Añadir el nuevo elemento y aumentar el tamaño.
+			::new (static_cast<void*>(Data + Size)) T(std::forward<Args>(InArgs)...);
+			return Data[Size++];
 		}
 
 		/**
-		 * @brief Elimina el elemento en la posición especificada.
+		 * @brief Elimina el elemento en la posición especificada conservando el
+		 *        orden (desplaza los siguientes con std::move).
 		 *
 		 * @param Index La posición del elemento a eliminar.
 		 */
 		void RemoveAt(size_t Index)
 		{
-			if (Index >= Size)
+			assert(Index < Size && "TArray: index out of range");
+			for (size_t i = Index; i + 1 < Size; ++i)
 			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de índice fuera de rango.
-				return;
+				Data[i] = std::move(Data[i + 1]);
 			}
-			for (size_t i = Index; i < Size - 1; ++i)
+			Data[--Size].~T();
+		}
+
+		/**
+		 * @brief Elimina el elemento en la posición especificada en O(1)
+		 *        moviendo el último a su lugar. No conserva el orden.
+		 *
+		 * @param Index La posición del elemento a eliminar.
+		 */
+		void RemoveAtSwap(size_t Index)
+		{
+			assert(Index < Size && "TArray: index out of range");
+			if (Index + 1 != Size)
 			{
-				Data[i] = Data[i + 1];  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
+				Data[Index] = std::move(Data[Size - 1]);
 			}
-			--Size;  ///< Disminuir el tamaño del array.
+			Data[--Size].~T();
+		}
+
+		/**
+		 * @brief Elimina el último elemento.
+		 */
+		void Pop()
+		{
+			assert(Size > 0 && "TArray: Pop on empty array");
+			Data[--Size].~T();
+		}
+
+		/**
+		 * @brief Garantiza capacidad para Count elementos sin volver a reservar.
+		 */
+		void Reserve(size_t Count)
+		{
+			if (Count > Capacity)
+			{
+				Reallocate(Count);
+			}
+		}
+
+		/**
+		 * @brief Ajusta la capacidad al número de elementos (o al espacio
+		 *        interno del asignador si caben en él).
+		 */
+		void Shrink()
+		{
+			if (Capacity > Size && !IsInline())
+			{
+				if (Size == 0 && Allocator::InlineCapacity() == 0)
+				{
+					this->Deallocate(Data, Capacity);
+					Data = nullptr;
+					Capacity = 0;
+					return;
+				}
+				Reallocate(Size);
+			}
+		}
+
+		/**
+		 * @brief Cambia el número de elementos; los nuevos se construyen por defecto.
+		 */
+		void SetNum(size_t NewSize)
+		{
+			if (NewSize > Size)
+			{
+				Reserve(NewSize);
+				for (size_t i = Size; i < NewSize; ++i)
+				{
+					::new (static_cast<void*>(Data + i)) T();
+				}
+			}
+			else
+			{
+				DestroyRange(Data + NewSize, Size - NewSize);
+			}
+			Size = NewSize;
+		}
+
+		/**
+		 * @brief Destruye todos los elementos conservando la capacidad.
+		 */
+		void Empty()
+		{
+			DestroyRange(Data, Size);
+			Size = 0;
 		}
 
 		/**
 		 * @brief Sobrecarga del operador [] para acceder a elementos por índice.
+		 *        El índice solo se comprueba en compilaciones de depuración.
 		 *
 		 * @param Index La posición del elemento a acceder.
 		 * @return Referencia al elemento en la posición especificada.
 		 */
 		T& operator[](size_t Index)
 		{
-			if (Index >= Size)
-			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de índice fuera de rango.
-				exit(1);  ///< Salir del programa en caso de error.
-			}
-			return Data[Index];  ///< Devolver el elemento en la posición especificada.
+			assert(Index < Size && "TArray: index out of range");
+			return Data[Index];
 		}
 
 		/**
@@ -133,14 +408,25 @@ namespace EU {
 		 */
 		const T& operator[](size_t Index) const
 		{
-			if (Index >= Size)
-			{
-				std::cerr << "Index out of range" << std::endl;  ///< Manejar el caso de índice fuera de rango.
-				exit(1);  ///< Salir del programa en caso de error.
-			}
-			return Data[Index];  ///< Devolver el elemento en la posición especificada.
+			assert(Index < Size && "TArray: index out of range");
+			return Data[Index];
 		}
 
+		T& Last()
+		{
+			assert(Size > 0 && "TArray: Last on empty array");
+			return Data[Size - 1];
+		}
+
+		const T& Last() const
+		{
+			assert(Size > 0 && "TArray: Last on empty array");
+			return Data[Size - 1];
+		}
+
+		T* GetData() { return Data; }
+		const T* GetData() const { return Data; }
+
 		/**
 		 * @brief Devuelve el número de elementos actualmente en el array.
 		 *
@@ -148,7 +434,15 @@ namespace EU {
 		 */
 		size_t Num() const
 		{
-			return Size;  ///< Devolver el tamaño actual del array.
+			return Size;
+		}
+
+		/**
+		 * @brief Indica si el array no contiene elementos.
+		 */
+		bool IsEmpty() const
+		{
+			return Size == 0;
 		}
 
 		/**
@@ -158,10 +452,22 @@ namespace EU {
 		 */
 		size_t GetCapacity() const
 		{
-			return Capacity;  ///< Devolver la capacidad actual del array.
+			return Capacity;
 		}
+
+		T* begin() { return Data; }
+		T* end() { return Data + Size; }
+		const T* begin() const { return Data; }
+		const T* end() const { return Data + Size; }
 	};
 
+	/**
+	 * @brief TArray que guarda hasta N elementos dentro del propio objeto;
+	 *        solo reserva memoria del heap al superar N.
+	 */
+	template<typename T, size_t N>
+	using TInlineArray = TArray<T, TInlineAllocator<T, N>>;
+
 	// EXAMPLE
 
 	/*
@@ -169,6 +475,7 @@ namespace EU {
 
 		// TArray Example
 		TArray<int> MyArray;
+		MyArray.Reserve(8);  ///< Una sola reserva para los elementos siguientes.
 		MyArray.Add(1);
 		MyArray.Add(2);
 		MyArray.Add(3);
@@ -176,17 +483,23 @@ namespace EU {
 		MyArray.Add(5);
 
 		MyArray.Add(6);
-		MyArray.RemoveAt(2);
+		MyArray.RemoveAt(2);      ///< Conserva el orden: 1 2 4 5 6
+		MyArray.RemoveAtSwap(0);  ///< O(1): 6 2 4 5
 
-		for (size_t i = 0; i < MyArray.Num(); ++i)
+		for (int Value : MyArray)
 		{
-			std::cout << MyArray[i] << " ";
+			std::cout << Value << " ";
 		}
 		std::cout << std::endl;
 
 		std::cout << "Size: " << MyArray.Num() << ", Capacity: " << MyArray.GetCapacity() << std::endl;
 
+		// TInlineArray Example: las mallas de un actor rara vez son más de 4.
+		TInlineArray<std::string, 4> MeshNames;
+		MeshNames.Emplace("Body");    ///< Sin reservas de memoria hasta el quinto elemento.
+		MeshNames.Emplace("Weapon");
+
 		return 0;
 	}
 	*/
-}
\ No newline at end of file
+}
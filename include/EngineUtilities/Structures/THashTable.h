@@ -0,0 +1,595 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "EngineUtilities/Utilities/SIMD.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace EU {
+	/**
+	 * @brief Hash por defecto de los contenedores EU (envuelve std::hash).
+	 *
+	 * THashTable mezcla el resultado, así que std::hash<int> (identidad) es válido.
+	 */
+	template<typename K>
+	struct THash
+	{
+		size_t operator()(const K& Key) const
+		{
+			return std::hash<K>()(Key);
+		}
+	};
+
+	/**
+	 * @brief Hash transparente para cadenas: std::string, std::string_view y
+	 *        const char* producen el mismo valor, lo que permite buscar sin
+	 *        construir un std::string temporal.
+	 */
+	template<>
+	struct THash<std::string>
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view Key) const
+		{
+			return std::hash<std::string_view>()(Key);
+		}
+	};
+
+	/**
+	 * @brief Comparación transparente (a == b) para búsqueda heterogénea.
+	 */
+	struct TEqualTo
+	{
+		using is_transparent = void;
+
+		template<typename A, typename B>
+		bool operator()(const A& Left, const B& Right) const
+		{
+			return Left == Right;
+		}
+	};
+
+	namespace detail {
+		/**
+		 * Bytes de control: 0..127 = ranura ocupada (7 bits bajos del hash),
+		 * negativo = vacía o borrada.
+		 */
+		typedef int8_t ControlByte;
+		const ControlByte CTRL_EMPTY = -128;
+		const ControlByte CTRL_DELETED = -2;
+
+		/**
+		 * Número de bytes de control que se comparan a la vez.
+		 */
+		const size_t GROUP_WIDTH = 16;
+
+		inline uint32_t
+		CountTrailingZeros(uint32_t Mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long Index;
+			_BitScanForward(&Index, Mask);
+			return Index;
+#else
+			return __builtin_ctz(Mask);
+#endif
+		}
+
+		inline uint32_t
+		CountLeadingZeros16(uint32_t Mask)
+		{
+#if defined(_MSC_VER)
+			unsigned long Index;
+			_BitScanReverse(&Index, Mask);
+			return 15 - Index;
+#else
+			return __builtin_clz(Mask) - 16;
+#endif
+		}
+
+		/**
+		 * Mezcla final (multiplicación de Fibonacci y plegado de la mitad alta)
+		 * para que H1 y H2 sean uniformes aunque el hash del usuario sea la
+		 * identidad.
+		 */
+		inline size_t
+		MixHash(size_t Hash)
+		{
+			uint64_t X = static_cast<uint64_t>(Hash) * 0x9e3779b97f4a7c15ULL;
+			return static_cast<size_t>(X ^ (X >> 32));
+		}
+
+		/**
+		 * Grupo de 16 bytes de control. Cada Match* devuelve una máscara con el
+		 * bit i activo si el byte i cumple la condición.
+		 */
+		struct Group
+		{
+#if defined(EU_SIMD_SSE2)
+			__m128i Ctrl;
+
+			explicit Group(const ControlByte* Pos)
+				: Ctrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(Pos)))
+			{
+			}
+
+			uint32_t Match(ControlByte H2) const
+			{
+				return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(Ctrl, _mm_set1_epi8(H2))));
+			}
+
+			uint32_t MatchEmpty() const
+			{
+				return Match(CTRL_EMPTY);
+			}
+
+			/**
+			 * Vacías o borradas: los bytes con el bit de signo activo.
+			 */
+			uint32_t MatchEmptyOrDeleted() const
+			{
+				return static_cast<uint32_t>(_mm_movemask_epi8(Ctrl));
+			}
+#else
+			ControlByte Ctrl[GROUP_WIDTH];
+
+			explicit Group(const ControlByte* Pos)
+			{
+				std::memcpy(Ctrl, Pos, GROUP_WIDTH);
+			}
+
+			uint32_t Match(ControlByte H2) const
+			{
+				uint32_t Mask = 0;
+				for (size_t i = 0; i < GROUP_WIDTH; ++i)
+				{
+					Mask |= static_cast<uint32_t>(Ctrl[i] == H2) << i;
+				}
+				return Mask;
+			}
+
+			uint32_t MatchEmpty() const
+			{
+				return Match(CTRL_EMPTY);
+			}
+
+			uint32_t MatchEmptyOrDeleted() const
+			{
+				uint32_t Mask = 0;
+				for (size_t i = 0; i < GROUP_WIDTH; ++i)
+				{
+					Mask |= static_cast<uint32_t>(Ctrl[i] < 0) << i;
+				}
+				return Mask;
+			}
+#endif
+		};
+
+		/**
+		 * @brief Tabla hash de direccionamiento abierto estilo Swiss table.
+		 *
+		 * Los elementos viven en un arreglo plano de ranuras sin inicializar; un
+		 * arreglo paralelo de bytes de control guarda 7 bits del hash de cada
+		 * ranura ocupada. La búsqueda compara 16 bytes de control por instrucción
+		 * y solo toca las ranuras cuyo byte coincide, por lo que casi nunca se
+		 * llama a KeyEqual sobre un elemento que no es el buscado.
+		 *
+		 * La capacidad es siempre potencia de dos (>= 16) y el factor de carga
+		 * máximo es 7/8. Los últimos 16 bytes de control replican los primeros
+		 * para que un grupo se pueda leer desde cualquier posición sin envolver.
+		 *
+		 * @tparam Element Tipo almacenado en cada ranura.
+		 * @tparam KeyOf Política con static const Key& Get(const Element&).
+		 * @tparam Hasher Función hash (transparente para búsqueda heterogénea).
+		 * @tparam KeyEqual Comparación de claves.
+		 */
+		template<typename Element, typename KeyOf, typename Hasher, typename KeyEqual>
+		class THashTable
+		{
+		public:
+			THashTable()
+				: Ctrl(EmptyControl()), Slots(nullptr), Capacity(0), Size(0), GrowthLeft(0)
+			{
+			}
+
+			THashTable(const THashTable& Other)
+				: THashTable()
+			{
+				Reserve(Other.Size);
+				for (size_t i = 0; i < Other.Capacity; ++i)
+				{
+					if (IsFull(Other.Ctrl[i]))
+					{
+						const size_t Hash = HashOf(KeyOf::Get(Other.Slots[i]));
+						ConstructAt(FindInsertSlot(Hash), Hash, Other.Slots[i]);
+					}
+				}
+			}
+
+			THashTable(THashTable&& Other) noexcept
+				: Ctrl(Other.Ctrl), Slots(Other.Slots), Capacity(Other.Capacity),
+				  Size(Other.Size), GrowthLeft(Other.GrowthLeft)
+			{
+				Other.Ctrl = EmptyControl();
+				Other.Slots = nullptr;
+				Other.Capacity = Other.Size = Other.GrowthLeft = 0;
+			}
+
+			THashTable& operator=(THashTable Other) noexcept
+			{
+				Swap(Other);
+				return *this;
+			}
+
+			~THashTable()
+			{
+				DestroyAll();
+				Deallocate(Ctrl, Slots, Capacity);
+			}
+
+			void Swap(THashTable& Other) noexcept
+			{
+				std::swap(Ctrl, Other.Ctrl);
+				std::swap(Slots, Other.Slots);
+				std::swap(Capacity, Other.Capacity);
+				std::swap(Size, Other.Size);
+				std::swap(GrowthLeft, Other.GrowthLeft);
+			}
+
+			size_t Num() const { return Size; }
+			size_t GetCapacity() const { return Capacity; }
+
+			/**
+			 * @brief Busca una clave; devuelve nullptr si no existe.
+			 */
+			template<typename Q>
+			Element* Find(const Q& Key) const
+			{
+				const size_t Index = FindIndex(Key, HashOf(Key));
+				return Index == NOT_FOUND ? nullptr : Slots + Index;
+			}
+
+			/**
+			 * @brief Busca la clave y, si no existe, construye un elemento con Args.
+			 *
+			 * @return El elemento y si fue insertado.
+			 */
+			template<typename Q, typename... Args>
+			std::pair<Element*, bool> TryEmplace(const Q& Key, Args&&... InArgs)
+			{
+				const size_t Hash = HashOf(Key);
+				const size_t Index = FindIndex(Key, Hash);
+				if (Index != NOT_FOUND)
+				{
+					return std::pair<Element*, bool>(Slots + Index, false);
+				}
+				if (GrowthLeft == 0)
+				{
+					Grow();
+				}
+				const size_t Slot = FindInsertSlot(Hash);
+				ConstructAt(Slot, Hash, std::forward<Args>(InArgs)...);
+				return std::pair<Element*, bool>(Slots + Slot, true);
+			}
+
+			/**
+			 * @brief Inserta un elemento cuya clave se sabe ausente, sin buscarla.
+			 *        Lo usan las operaciones de conjuntos, donde la unicidad ya
+			 *        está garantizada por el origen.
+			 */
+			template<typename Arg>
+			Element* InsertUnique(Arg&& Value)
+			{
+				if (GrowthLeft == 0)
+				{
+					Grow();
+				}
+				const size_t Hash = HashOf(KeyOf::Get(Value));
+				const size_t Slot = FindInsertSlot(Hash);
+				ConstructAt(Slot, Hash, std::forward<Arg>(Value));
+				return Slots + Slot;
+			}
+
+			/**
+			 * @brief Elimina la clave si existe.
+			 *
+			 * @return true si se eliminó un elemento.
+			 */
+			template<typename Q>
+			bool Erase(const Q& Key)
+			{
+				const size_t Index = FindIndex(Key, HashOf(Key));
+				if (Index == NOT_FOUND)
+				{
+					return false;
+				}
+				EraseAt(Index);
+				return true;
+			}
+
+			/**
+			 * @brief Elimina el elemento de la ranura Index (debe estar ocupada).
+			 */
+			void EraseAt(size_t Index)
+			{
+				Slots[Index].~Element();
+				--Size;
+
+				// Si ninguna secuencia de sondeo pudo haber pasado por esta ranura
+				// con un grupo lleno, se puede marcar vacía en vez de borrada.
+				const uint32_t EmptyAfter = Group(Ctrl + Index).MatchEmpty();
+				const uint32_t EmptyBefore = Group(Ctrl + ((Index - GROUP_WIDTH) & (Capacity - 1))).MatchEmpty();
+				const bool bWasNeverFull = EmptyAfter && EmptyBefore &&
+					CountTrailingZeros(EmptyAfter) + CountLeadingZeros16(EmptyBefore) < GROUP_WIDTH;
+				SetCtrl(Index, bWasNeverFull ? CTRL_EMPTY : CTRL_DELETED);
+				GrowthLeft += bWasNeverFull ? 1 : 0;
+			}
+
+			/**
+			 * @brief Destruye todos los elementos conservando la capacidad.
+			 */
+			void Clear()
+			{
+				DestroyAll();
+				if (Capacity)
+				{
+					std::memset(Ctrl, CTRL_EMPTY, Capacity + GROUP_WIDTH);
+				}
+				Size = 0;
+				GrowthLeft = MaxLoad(Capacity);
+			}
+
+			/**
+			 * @brief Garantiza espacio para Count elementos sin volver a redimensionar.
+			 */
+			void Reserve(size_t Count)
+			{
+				if (Count > Size + GrowthLeft)
+				{
+					Resize(CapacityFor(Count));
+				}
+			}
+
+			/**
+			 * @brief Reconstruye la tabla con la menor capacidad que admite
+			 *        max(Count, Num()) elementos. Rehash(0) ajusta la memoria al
+			 *        tamaño actual y elimina las ranuras borradas.
+			 */
+			void Rehash(size_t Count)
+			{
+				const size_t Needed = Count > Size ? Count : Size;
+				Resize(Needed == 0 ? 0 : CapacityFor(Needed));
+			}
+
+			/**
+			 * Índice de la primera ranura ocupada en [Index, Capacity), o Capacity.
+			 */
+			size_t NextFull(size_t Index) const
+			{
+				while (Index < Capacity && !IsFull(Ctrl[Index]))
+				{
+					++Index;
+				}
+				return Index;
+			}
+
+			Element* SlotAt(size_t Index) const { return Slots + Index; }
+
+		private:
+			static constexpr size_t NOT_FOUND = ~size_t(0);
+
+			ControlByte* Ctrl;   ///< Capacity + GROUP_WIDTH bytes de control.
+			Element* Slots;      ///< Capacity ranuras sin inicializar.
+			size_t Capacity;     ///< Número de ranuras (potencia de dos, o 0).
+			size_t Size;         ///< Elementos vivos.
+			size_t GrowthLeft;   ///< Inserciones en ranuras vacías antes de crecer.
+
+			static bool IsFull(ControlByte C) { return C >= 0; }
+			static size_t H1(size_t Hash) { return Hash >> 7; }
+			static ControlByte H2(size_t Hash) { return static_cast<ControlByte>(Hash & 0x7f); }
+			static size_t MaxLoad(size_t InCapacity) { return InCapacity - InCapacity / 8; }
+
+			/**
+			 * Bytes de control compartidos por las tablas vacías: todo grupo leído
+			 * está vacío, así que Find termina sin reservar memoria.
+			 */
+			static ControlByte* EmptyControl()
+			{
+				alignas(16) static ControlByte Empty[GROUP_WIDTH] = {
+					CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY,
+					CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY, CTRL_EMPTY
+				};
+				return Empty;
+			}
+
+			static size_t CapacityFor(size_t Count)
+			{
+				size_t NewCapacity = GROUP_WIDTH;
+				while (MaxLoad(NewCapacity) < Count)
+				{
+					NewCapacity *= 2;
+				}
+				return NewCapacity;
+			}
+
+			template<typename Q>
+			size_t HashOf(const Q& Key) const
+			{
+				return MixHash(Hasher()(Key));
+			}
+
+			/**
+			 * Sondeo triangular por grupos: con capacidad potencia de dos visita
+			 * todas las posiciones antes de repetir.
+			 */
+			template<typename Q>
+			size_t FindIndex(const Q& Key, size_t Hash) const
+			{
+				if (Capacity == 0)
+				{
+					return NOT_FOUND;
+				}
+				const size_t Mask = Capacity - 1;
+				size_t Pos = H1(Hash) & Mask;
+				for (size_t Step = GROUP_WIDTH; ; Step += GROUP_WIDTH)
+				{
+					const Group G(Ctrl + Pos);
+					for (uint32_t Bits = G.Match(H2(Hash)); Bits; Bits &= Bits - 1)
+					{
+						const size_t Index = (Pos + CountTrailingZeros(Bits)) & Mask;
+						if (KeyEqual()(KeyOf::Get(Slots[Index]), Key))
+						{
+							return Index;
+						}
+					}
+					if (G.MatchEmpty())
+					{
+						return NOT_FOUND;
+					}
+					Pos = (Pos + Step) & Mask;
+				}
+			}
+
+			size_t FindInsertSlot(size_t Hash) const
+			{
+				const size_t Mask = Capacity - 1;
+				size_t Pos = H1(Hash) & Mask;
+				for (size_t Step = GROUP_WIDTH; ; Step += GROUP_WIDTH)
+				{
+					const uint32_t Bits = Group(Ctrl + Pos).MatchEmptyOrDeleted();
+					if (Bits)
+					{
+						return (Pos + CountTrailingZeros(Bits)) & Mask;
+					}
+					Pos = (Pos + Step) & Mask;
+				}
+			}
+
+			void SetCtrl(size_t Index, ControlByte Value)
+			{
+				Ctrl[Index] = Value;
+				if (Index < GROUP_WIDTH)
+				{
+					Ctrl[Capacity + Index] = Value;  ///< Copia espejo del inicio.
+				}
+			}
+
+			template<typename... Args>
+			void ConstructAt(size_t Index, size_t Hash, Args&&... InArgs)
+			{
+				::new (static_cast<void*>(Slots + Index)) Element(std::forward<Args>(InArgs)...);
+				GrowthLeft -= Ctrl[Index] == CTRL_EMPTY ? 1 : 0;
+				SetCtrl(Index, H2(Hash));
+				++Size;
+			}
+
+			/**
+			 * Crece al doble, o reconstruye con la misma capacidad si la mitad
+			 * del espacio consumido son ranuras borradas.
+			 */
+			void Grow()
+			{
+				if (Capacity && Size <= MaxLoad(Capacity) / 2)
+				{
+					Resize(Capacity);
+				}
+				else
+				{
+					Resize(Capacity ? Capacity * 2 : GROUP_WIDTH);
+				}
+			}
+
+			void Resize(size_t NewCapacity)
+			{
+				ControlByte* OldCtrl = Ctrl;
+				Element* OldSlots = Slots;
+				const size_t OldCapacity = Capacity;
+
+				if (NewCapacity == 0)
+				{
+					Ctrl = EmptyControl();
+					Slots = nullptr;
+				}
+				else
+				{
+					Ctrl = static_cast<ControlByte*>(::operator new(NewCapacity + GROUP_WIDTH));
+					std::memset(Ctrl, CTRL_EMPTY, NewCapacity + GROUP_WIDTH);
+					Slots = std::allocator<Element>().allocate(NewCapacity);
+				}
+				Capacity = NewCapacity;
+				GrowthLeft = MaxLoad(NewCapacity);
+				Size = 0;
+
+				for (size_t i = 0; i < OldCapacity; ++i)
+				{
+					if (IsFull(OldCtrl[i]))
+					{
+						const size_t Hash = HashOf(KeyOf::Get(OldSlots[i]));
+						ConstructAt(FindInsertSlot(Hash), Hash, std::move(OldSlots[i]));
+						OldSlots[i].~Element();
+					}
+				}
+				Deallocate(OldCtrl, OldSlots, OldCapacity);
+			}
+
+			void DestroyAll()
+			{
+				for (size_t i = 0; i < Capacity; ++i)
+				{
+					if (IsFull(Ctrl[i]))
+					{
+						Slots[i].~Element();
+					}
+				}
+			}
+
+			static void Deallocate(ControlByte* InCtrl, Element* InSlots, size_t InCapacity)
+			{
+				if (InCapacity)
+				{
+					::operator delete(InCtrl);
+					std::allocator<Element>().deallocate(InSlots, InCapacity);
+				}
+			}
+		};
+	}
+}
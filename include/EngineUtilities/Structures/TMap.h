@@ -27,170 +27,252 @@
  * SOFTWARE.
 */
 #pragma once
+#include <cassert>
+
+#include "EngineUtilities/Structures/THashTable.h"
+#include "EngineUtilities/Structures/TPair.h"
+
 namespace EU {
 	/**
-	 * @brief TMap es una clase de mapa (diccionario) dinámica para almacenar pares clave-valor.
+	 * @brief TMap es un mapa hash (diccionario) para almacenar pares clave-valor.
+	 *
+	 * Tabla de direccionamiento abierto estilo Swiss table (ver THashTable):
+	 * Add, Find y Remove son O(1) promedio y los pares se guardan contiguos en
+	 * memoria. Admite valores solo movibles, búsqueda heterogénea (por ejemplo
+	 * un TMap<std::string, T> se consulta con const char* o std::string_view
+	 * sin crear cadenas temporales) y control explícito de Reserve/Rehash.
 	 *
-	 * Esta implementación de TMap proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de pares clave-valor, con operaciones básicas como agregar, eliminar y acceder a valores.
-	 * La memoria se gestiona dinámicamente, aumentando la capacidad del mapa según sea necesario.
+	 * Añadir o eliminar elementos puede mover los pares: los punteros e
+	 * iteradores obtenidos antes dejan de ser válidos.
 	 *
 	 * @tparam K El tipo de las claves.
 	 * @tparam V El tipo de los valores.
+	 * @tparam Hasher Función hash; por defecto THash<K>.
+	 * @tparam KeyEqual Comparación de claves; por defecto TEqualTo (transparente).
 	 */
-	template<typename K, typename V>
+	template<typename K, typename V, typename Hasher = THash<K>, typename KeyEqual = TEqualTo>
 	class TMap
 	{
+	public:
+		typedef TPair<K, V> ElementType;
+
 	private:
-		struct Pair
+		struct KeyOf
+		{
+			static const K& Get(const ElementType& Element) { return Element.Key; }
+		};
+
+		typedef detail::THashTable<ElementType, KeyOf, Hasher, KeyEqual> TableType;
+
+		TableType Table;  ///< Almacenamiento de los pares.
+
+	public:
+		/**
+		 * @brief Iterador sobre los pares del mapa (orden no especificado).
+		 */
+		template<bool bConst>
+		class TIterator
 		{
-			K Key;
-			V Value;
+		public:
+			typedef typename std::conditional<bConst, const ElementType, ElementType>::type Reference;
+
+			TIterator(const TableType* InTable, size_t InIndex)
+				: Table(InTable), Index(InTable->NextFull(InIndex))
+			{
+			}
+
+			Reference& operator*() const { return *Table->SlotAt(Index); }
+			Reference* operator->() const { return Table->SlotAt(Index); }
 
-			Pair() : Key(), Value() {}
-			Pair(const K& Key, const V& Value) : Key(Key), Value(Value) {}
+			TIterator& operator++()
+			{
+				Index = Table->NextFull(Index + 1);
+				return *this;
+			}
+
+			bool operator==(const TIterator& Other) const { return Index == Other.Index; }
+			bool operator!=(const TIterator& Other) const { return Index != Other.Index; }
+
+		private:
+			const TableType* Table;
+			size_t Index;
 		};
 
-		Pair* Data;        ///< Puntero a la memoria donde se almacenan los pares clave-valor.
-		size_t Capacity;   ///< Capacidad actual del mapa (número de pares que puede almacenar).
-		size_t Size;       ///< Número de pares actualmente en el mapa.
+		typedef TIterator<false> Iterator;
+		typedef TIterator<true> ConstIterator;
 
 		/**
-		 * @brief Redimensiona el mapa para tener una nueva capacidad.
+		 * @brief Constructor por defecto; no reserva memoria hasta la primera inserción.
+		 */
+		TMap() {}
+
+		/**
+		 * @brief Añade un par clave-valor, reemplazando el valor si la clave ya existe.
 		 *
-		 * @param NewCapacity La nueva capacidad del mapa.
+		 * @param Key La clave del nuevo par.
+		 * @param Value El valor del nuevo par.
+		 * @return Referencia al valor guardado.
 		 */
-		void Resize(size_t NewCapacity)
+		V& Add(const K& Key, const V& Value)
 		{
-			Pair* NewData = new Pair[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
-			for (size_t i = 0; i < Size; ++i)
+			std::pair<ElementType*, bool> Result = Table.TryEmplace(Key, Key, Value);
+			if (!Result.second)
 			{
-				NewData[i] = Data[i];  ///< Copiar los pares existentes al nuevo bloque de memoria.
+				Result.first->Value = Value;
 			}
-			delete[] Data;  ///< Liberar la memoria del mapa antiguo.
-			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
-			Capacity = NewCapacity;  ///< Actualizar la capacidad del mapa.
+			return Result.first->Value;
 		}
 
-	public:
 		/**
-		 * @brief Constructor por defecto que inicializa el mapa con capacidad y tamaño cero.
+		 * @brief Versión de Add que mueve la clave y el valor.
 		 */
-		TMap()
-			: Data(nullptr), Capacity(0), Size(0)
+		V& Add(K&& Key, V&& Value)
 		{
+			std::pair<ElementType*, bool> Result = Table.TryEmplace(Key, std::move(Key), std::move(Value));
+			if (!Result.second)
+			{
+				Result.first->Value = std::move(Value);
+			}
+			return Result.first->Value;
 		}
 
 		/**
-		 * @brief Destructor que libera la memoria asignada al mapa.
+		 * @brief Construye el valor en sitio si la clave no existe.
+		 *
+		 * @param Key La clave.
+		 * @param Args Argumentos para el constructor de V; sin ninguno, el
+		 *        valor se inicializa con V().
+		 * @return Referencia al valor nuevo, o al existente (Args se ignoran).
 		 */
-		~TMap()
+		template<typename... Args>
+		V& Emplace(const K& Key, Args&&... InArgs)
 		{
-			delete[] Data;  ///< Liberar la memoria del mapa.
+			return Table.TryEmplace(Key, Key, std::forward<Args>(InArgs)...).first->Value;
 		}
 
 		/**
-		 * @brief Añade un nuevo par clave-valor al mapa.
+		 * @brief Devuelve el valor de la clave, insertando V() si no existe.
+		 */
+		V& FindOrAdd(const K& Key)
+		{
+			return Table.TryEmplace(Key, Key).first->Value;
+		}
+
+		/**
+		 * @brief Busca el valor asociado a una clave.
 		 *
-		 * @param Key La clave del nuevo par.
-		 * @param Value El valor del nuevo par.
+		 * @param Key La clave (o cualquier tipo comparable con K si Hasher es transparente).
+		 * @return Puntero al valor, o nullptr si la clave no existe.
 		 */
-		void Add(const K& Key, const V& Value)
+		template<typename Q>
+		V* Find(const Q& Key)
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i].Key == Key)
-				{
-					Data[i].Value = Value;  ///< Actualizar el valor si la clave ya existe.
-					return;
-				}
-			}
-			if (Size == Capacity)
-			{
-				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
-			}
-			Data[Size++] = Pair(Key, Value);  ///< Añadir el nuevo par y aumentar el tamaño.
+			ElementType* Element = Table.Find(Key);
+			return Element ? &Element->Value : nullptr;
+		}
+
+		template<typename Q>
+		const V* Find(const Q& Key) const
+		{
+			const ElementType* Element = Table.Find(Key);
+			return Element ? &Element->Value : nullptr;
+		}
+
+		/**
+		 * @brief Indica si la clave existe en el mapa.
+		 */
+		template<typename Q>
+		bool Contains(const Q& Key) const
+		{
+			return Table.Find(Key) != nullptr;
 		}
 
 		/**
-		 * @brief Elimina el par clave-valor en la posición especificada.
+		 * @brief Elimina el par con la clave especificada.
 		 *
 		 * @param Key La clave del par a eliminar.
+		 * @return true si la clave existía.
 		 */
-		void Remove(const K& Key)
+		template<typename Q>
+		bool Remove(const Q& Key)
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i].Key == Key)
-				{
-					for (size_t j = i; j < Size - 1; ++j)
-					{
-						Data[j] = Data[j + 1];  ///< Desplazar los pares hacia la izquierda para llenar el hueco.
-					}
-					--Size;  ///< Disminuir el tamaño del mapa.
-					return;
-				}
-			}
-			std::cerr << "Key not found" << std::endl;  ///< Manejar el caso de clave no encontrada.
+			return Table.Erase(Key);
 		}
 
 		/**
-		 * @brief Sobrecarga del operador [] para acceder a valores por clave.
+		 * @brief Acceso por clave; inserta V() si la clave no existe.
 		 *
 		 * @param Key La clave del valor a acceder.
 		 * @return Referencia al valor asociado con la clave especificada.
 		 */
 		V& operator[](const K& Key)
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i].Key == Key)
-				{
-					return Data[i].Value;  ///< Devolver el valor si la clave se encuentra.
-				}
-			}
-			std::cerr << "Key not found" << std::endl;  ///< Manejar el caso de clave no encontrada.
-			exit(1);  ///< Salir del programa en caso de error.
+			return FindOrAdd(Key);
 		}
 
 		/**
-		 * @brief Versión constante de la sobrecarga del operador [] para acceder a valores por clave.
-		 *
-		 * @param Key La clave del valor a acceder.
-		 * @return Referencia constante al valor asociado con la clave especificada.
+		 * @brief Acceso constante por clave. La clave debe existir; usar Find()
+		 *        cuando no se tenga la certeza.
 		 */
 		const V& operator[](const K& Key) const
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i].Key == Key)
-				{
-					return Data[i].Value;  ///< Devolver el valor si la clave se encuentra.
-				}
-			}
-			std::cerr << "Key not found" << std::endl;  ///< Manejar el caso de clave no encontrada.
-			exit(1);  ///< Salir del programa en caso de error.
+			const V* Value = Find(Key);
+			assert(Value && "TMap: key not found");
+			return *Value;
 		}
 
 		/**
 		 * @brief Devuelve el número de pares actualmente en el mapa.
-		 *
-		 * @return El número de pares en el mapa.
 		 */
 		size_t Num() const
 		{
-			return Size;  ///< Devolver el tamaño actual del mapa.
+			return Table.Num();
 		}
 
 		/**
-		 * @brief Devuelve la capacidad actual del mapa.
-		 *
-		 * @return La capacidad del mapa.
+		 * @brief Indica si el mapa no contiene pares.
+		 */
+		bool IsEmpty() const
+		{
+			return Table.Num() == 0;
+		}
+
+		/**
+		 * @brief Devuelve el número de ranuras reservadas (incluye el margen de carga).
 		 */
 		size_t GetCapacity() const
 		{
-			return Capacity;  ///< Devolver la capacidad actual del mapa.
+			return Table.GetCapacity();
 		}
+
+		/**
+		 * @brief Reserva espacio para Count pares sin redimensionar.
+		 */
+		void Reserve(size_t Count)
+		{
+			Table.Reserve(Count);
+		}
+
+		/**
+		 * @brief Reconstruye la tabla para Count pares (0 = ajustar a Num()).
+		 */
+		void Rehash(size_t Count)
+		{
+			Table.Rehash(Count);
+		}
+
+		/**
+		 * @brief Elimina todos los pares conservando la memoria reservada.
+		 */
+		void Empty()
+		{
+			Table.Clear();
+		}
+
+		Iterator begin() { return Iterator(&Table, 0); }
+		Iterator end() { return Iterator(&Table, Table.GetCapacity()); }
+		ConstIterator begin() const { return ConstIterator(&Table, 0); }
+		ConstIterator end() const { return ConstIterator(&Table, Table.GetCapacity()); }
 	};
 
 	// EXAMPLE
@@ -198,19 +280,25 @@ namespace EU {
 	/*
 	int main()
 	{
-		TMap<int, std::string> MyMap;  ///< Crear una instancia de TMap para claves enteras y valores string.
-		MyMap.Add(1, "One");  ///< Añadir pares clave-valor al mapa.
-		MyMap.Add(2, "Two");
-		MyMap.Add(3, "Three");
-
-		MyMap.Remove(2);  ///< Eliminar el par con clave 2.
+		TMap<std::string, int> MyMap;  ///< Crear una instancia de TMap para claves string y valores enteros.
+		MyMap.Add("One", 1);  ///< Añadir pares clave-valor al mapa.
+		MyMap.Add("Two", 2);
+		MyMap["Three"] = 3;
 
-		std::cout << "Key 1: " << MyMap[1] << std::endl;  ///< Acceder e imprimir el valor asociado con la clave 1.
-		std::cout << "Key 3: " << MyMap[3] << std::endl;  ///< Acceder e imprimir el valor asociado con la clave 3.
+		MyMap.Remove("Two");  ///< Eliminar el par con clave "Two" (sin crear un std::string).
 
-		std::cout << "Size: " << MyMap.Num() << ", Capacity: " << MyMap.GetCapacity() << std::endl;  ///< Imprimir el tamaño y la capacidad del mapa.
+		if (const int* Value = MyMap.Find("One"))
+		{
+			std::cout << "One: " << *Value << std::endl;
+		}
+		for (auto& Pair : MyMap)
+		{
+			Pair.Print();
+		}
 
+		std::cout << "Size: " << MyMap.Num() << ", Capacity: " << MyMap.GetCapacity() << std::endl;
 		return 0;
 	}
 	*/
-}
\ No newline at end of file
+
+}
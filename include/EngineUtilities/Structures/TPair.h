@@ -27,10 +27,11 @@
  * SOFTWARE.
 */
 #pragma once
+#include <iostream>
+#include <type_traits>
+#include <utility>
 
 namespace EU {
-#pragma once
-#include <iostream>
 
 	/**
 	 * @brief Clase TPair para representar un par de valores.
@@ -58,6 +59,33 @@ namespace EU {
 		 */
 		TPair(const KeyType& InKey, const ValueType& InValue) : Key(InKey), Value(InValue) {}
 
+		/**
+		 * @brief Constructor que copia o mueve la clave e inicializa el valor
+		 *        por valor (ValueType()), sin copiarlo ni moverlo.
+		 *
+		 * Excluye a TPair para no tapar al constructor de copia.
+		 *
+		 * @param InKey Clave (copiada o movida).
+		 */
+		template<typename KeyArg,
+		         typename = typename std::enable_if<
+		           !std::is_same<typename std::decay<KeyArg>::type, TPair>::value>::type>
+		explicit TPair(KeyArg&& InKey)
+			: Key(std::forward<KeyArg>(InKey)), Value() {}
+
+		/**
+		 * @brief Constructor que mueve la clave y construye el valor en sitio.
+		 *
+		 * Permite guardar valores no copiables (solo movibles) en contenedores.
+		 *
+		 * @param InKey Clave (copiada o movida).
+		 * @param InValueArgs Argumentos para el constructor del valor.
+		 */
+		template<typename KeyArg, typename ValueArg, typename... ValueArgs>
+		TPair(KeyArg&& InKey, ValueArg&& InValueArg, ValueArgs&&... InValueArgs)
+			: Key(std::forward<KeyArg>(InKey)),
+			  Value(std::forward<ValueArg>(InValueArg), std::forward<ValueArgs>(InValueArgs)...) {}
+
 		/**
 		 * @brief Clave del par.
 		 */
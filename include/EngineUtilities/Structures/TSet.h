@@ -27,116 +27,248 @@
  * SOFTWARE.
 */
 #pragma once
+#include <initializer_list>
+
+#include "EngineUtilities/Structures/THashTable.h"
 
 namespace EU {
 	/**
-	 * @brief TSet es una clase de conjunto dinámica para almacenar elementos únicos.
+	 * @brief TSet es un conjunto hash para almacenar elementos únicos.
+	 *
+	 * Usa la misma tabla de direccionamiento abierto que TMap (ver THashTable):
+	 * Add, Contains y Remove son O(1) promedio. Las operaciones de conjuntos
+	 * (Union, Intersect, Difference) reservan el resultado una sola vez y lo
+	 * llenan sin volver a buscar cada elemento, y Append inserta lotes con
+	 * una única reserva.
 	 *
-	 * Esta implementación de TSet proporciona una forma sencilla de almacenar y gestionar
-	 * colecciones de elementos únicos, con operaciones básicas como agregar, eliminar y verificar la existencia de elementos.
-	 * La memoria se gestiona dinámicamente, aumentando la capacidad del conjunto según sea necesario.
+	 * Añadir o eliminar elementos puede moverlos: los punteros e iteradores
+	 * obtenidos antes dejan de ser válidos.
 	 *
 	 * @tparam T El tipo de los elementos almacenados en el conjunto.
+	 * @tparam Hasher Función hash; por defecto THash<T>.
+	 * @tparam KeyEqual Comparación de elementos; por defecto TEqualTo (transparente).
 	 */
-	template<typename T>
+	template<typename T, typename Hasher = THash<T>, typename KeyEqual = TEqualTo>
 	class TSet
 	{
 	private:
-		T* Data;        ///< Puntero a la memoria donde se almacenan los elementos.
-		size_t Capacity;   ///< Capacidad actual del conjunto (número de elementos que puede almacenar).
-		size_t Size;       ///< Número de elementos actualmente en el conjunto.
+		struct KeyOf
+		{
+			static const T& Get(const T& Element) { return Element; }
+		};
+
+		typedef detail::THashTable<T, KeyOf, Hasher, KeyEqual> TableType;
 
+		TableType Table;  ///< Almacenamiento de los elementos.
+
+	public:
 		/**
-		 * @brief Redimensiona el conjunto para tener una nueva capacidad.
-		 *
-		 * @param NewCapacity La nueva capacidad del conjunto.
+		 * @brief Iterador constante sobre los elementos (orden no especificado).
+		 *        Los elementos no se pueden modificar en sitio porque eso
+		 *        cambiaría su hash.
 		 */
-		void Resize(size_t NewCapacity)
+		class ConstIterator
 		{
-			T* NewData = new T[NewCapacity];  ///< Crear un nuevo bloque de memoria con la nueva capacidad.
-			for (size_t i = 0; i < Size; ++i)
+		public:
+			ConstIterator(const TableType* InTable, size_t InIndex)
+				: Table(InTable), Index(InTable->NextFull(InIndex))
 			{
-				NewData[i] = Data[i];  ///< Copiar los elementos existentes al nuevo bloque de memoria.
 			}
-			delete[] Data;  ///< Liberar la memoria del conjunto antiguo.
-			Data = NewData; ///< Actualizar el puntero Data para que apunte al nuevo bloque de memoria.
-			Capacity = NewCapacity;  ///< Actualizar la capacidad del conjunto.
+
+			const T& operator*() const { return *Table->SlotAt(Index); }
+			const T* operator->() const { return Table->SlotAt(Index); }
+
+			ConstIterator& operator++()
+			{
+				Index = Table->NextFull(Index + 1);
+				return *this;
+			}
+
+			bool operator==(const ConstIterator& Other) const { return Index == Other.Index; }
+			bool operator!=(const ConstIterator& Other) const { return Index != Other.Index; }
+
+		private:
+			const TableType* Table;
+			size_t Index;
+		};
+
+		/**
+		 * @brief Constructor por defecto; no reserva memoria hasta la primera inserción.
+		 */
+		TSet() {}
+
+		/**
+		 * @brief Construye el conjunto a partir de una lista de elementos.
+		 */
+		TSet(std::initializer_list<T> Elements)
+		{
+			Append(Elements);
 		}
 
-	public:
 		/**
-		 * @brief Constructor por defecto que inicializa el conjunto con capacidad y tamaño cero.
+		 * @brief Añade un nuevo elemento al conjunto.
+		 *
+		 * @param Element El elemento a añadir.
+		 * @return true si se añadió; false si ya existía.
 		 */
-		TSet()
-			: Data(nullptr), Capacity(0), Size(0)
+		bool Add(const T& Element)
 		{
+			return Table.TryEmplace(Element, Element).second;
 		}
 
 		/**
-		 * @brief Destructor que libera la memoria asignada al conjunto.
+		 * @brief Versión de Add que mueve el elemento.
 		 */
-		~TSet()
+		bool Add(T&& Element)
 		{
-			delete[] Data;  ///< Liberar la memoria del conjunto.
+			return Table.TryEmplace(Element, std::move(Element)).second;
 		}
 
 		/**
-		 * @brief Añade un nuevo elemento al conjunto.
+		 * @brief Añade Count elementos con una sola reserva de memoria.
 		 *
-		 * @param Element El elemento a añadir.
+		 * @param Elements Puntero al primer elemento.
+		 * @param Count Número de elementos (puede contener duplicados).
 		 */
-		void Add(const T& Element)
+		void Append(const T* Elements, size_t Count)
 		{
-			if (Contains(Element))
+			Table.Reserve(Table.Num() + Count);
+			for (size_t i = 0; i < Count; ++i)
 			{
-				return;  ///< No añadir duplicados.
+				Table.TryEmplace(Elements[i], Elements[i]);
 			}
-			if (Size == Capacity)
+		}
+
+		void Append(std::initializer_list<T> Elements)
+		{
+			Append(Elements.begin(), Elements.size());
+		}
+
+		/**
+		 * @brief Añade todos los elementos de otro conjunto (unión en sitio).
+		 */
+		void Append(const TSet& Other)
+		{
+			Table.Reserve(Table.Num() + Other.Num());
+			for (const T& Element : Other)
 			{
-				Resize(Capacity == 0 ? 1 : Capacity * 2);  ///< Redimensionar si es necesario.
+				Table.TryEmplace(Element, Element);
 			}
-			Data[Size++] = Element;  ///< Añadir el nuevo elemento y aumentar el tamaño.
 		}
 
 		/**
 		 * @brief Elimina el elemento especificado del conjunto.
 		 *
 		 * @param Element El elemento a eliminar.
+		 * @return true si el elemento existía.
 		 */
-		void Remove(const T& Element)
+		template<typename Q>
+		bool Remove(const Q& Element)
 		{
-			for (size_t i = 0; i < Size; ++i)
-			{
-				if (Data[i] == Element)
-				{
-					for (size_t j = i; j < Size - 1; ++j)
-					{
-						Data[j] = Data[j + 1];  ///< Desplazar los elementos hacia la izquierda para llenar el hueco.
-					}
-					--Size;  ///< Disminuir el tamaño del conjunto.
-					return;
-				}
-			}
-			std::cerr << "Element not found" << std::endl;  ///< Manejar el caso de elemento no encontrado.
+			return Table.Erase(Element);
 		}
 
 		/**
 		 * @brief Verifica si el conjunto contiene el elemento especificado.
 		 *
-		 * @param Element El elemento a verificar.
+		 * @param Element El elemento (o cualquier tipo comparable con T si Hasher es transparente).
 		 * @return true Si el conjunto contiene el elemento.
 		 * @return false Si el conjunto no contiene el elemento.
 		 */
-		bool Contains(const T& Element) const
+		template<typename Q>
+		bool Contains(const Q& Element) const
+		{
+			return Table.Find(Element) != nullptr;
+		}
+
+		/**
+		 * @brief Devuelve un puntero al elemento guardado, o nullptr si no existe.
+		 */
+		template<typename Q>
+		const T* Find(const Q& Element) const
+		{
+			return Table.Find(Element);
+		}
+
+		/**
+		 * @brief Elementos presentes en este conjunto o en Other.
+		 */
+		TSet Union(const TSet& Other) const
+		{
+			const TSet& Larger = Num() >= Other.Num() ? *this : Other;
+			const TSet& Smaller = Num() >= Other.Num() ? Other : *this;
+
+			TSet Result;
+			Result.Table.Reserve(Larger.Num() + Smaller.Num());
+			for (const T& Element : Larger)
+			{
+				Result.Table.InsertUnique(Element);
+			}
+			for (const T& Element : Smaller)
+			{
+				if (!Larger.Contains(Element))
+				{
+					Result.Table.InsertUnique(Element);
+				}
+			}
+			return Result;
+		}
+
+		/**
+		 * @brief Elementos presentes en ambos conjuntos. Recorre el menor y
+		 *        consulta el mayor.
+		 */
+		TSet Intersect(const TSet& Other) const
+		{
+			const TSet& Larger = Num() >= Other.Num() ? *this : Other;
+			const TSet& Smaller = Num() >= Other.Num() ? Other : *this;
+
+			TSet Result;
+			Result.Table.Reserve(Smaller.Num());
+			for (const T& Element : Smaller)
+			{
+				if (Larger.Contains(Element))
+				{
+					Result.Table.InsertUnique(Element);
+				}
+			}
+			return Result;
+		}
+
+		/**
+		 * @brief Elementos de este conjunto que no están en Other.
+		 */
+		TSet Difference(const TSet& Other) const
+		{
+			TSet Result;
+			Result.Table.Reserve(Num());
+			for (const T& Element : *this)
+			{
+				if (!Other.Contains(Element))
+				{
+					Result.Table.InsertUnique(Element);
+				}
+			}
+			return Result;
+		}
+
+		/**
+		 * @brief Indica si todos los elementos de Other están en este conjunto.
+		 */
+		bool Includes(const TSet& Other) const
 		{
-			for (size_t i = 0; i < Size; ++i)
+			if (Other.Num() > Num())
+			{
+				return false;
+			}
+			for (const T& Element : Other)
 			{
-				if (Data[i] == Element)
+				if (!Contains(Element))
 				{
-					return true;  ///< Devolver true si el elemento se encuentra.
+					return false;
 				}
 			}
-			return false;  ///< Devolver false si el elemento no se encuentra.
+			return true;
 		}
 
 		/**
@@ -146,18 +278,53 @@ namespace EU {
 		 */
 		size_t Num() const
 		{
-			return Size;  ///< Devolver el tamaño actual del conjunto.
+			return Table.Num();
 		}
 
 		/**
-		 * @brief Devuelve la capacidad actual del conjunto.
+		 * @brief Indica si el conjunto no contiene elementos.
+		 */
+		bool IsEmpty() const
+		{
+			return Table.Num() == 0;
+		}
+
+		/**
+		 * @brief Devuelve el número de ranuras reservadas (incluye el margen de carga).
 		 *
 		 * @return La capacidad del conjunto.
 		 */
 		size_t GetCapacity() const
 		{
-			return Capacity;  ///< Devolver la capacidad actual del conjunto.
+			return Table.GetCapacity();
+		}
+
+		/**
+		 * @brief Reserva espacio para Count elementos sin redimensionar.
+		 */
+		void Reserve(size_t Count)
+		{
+			Table.Reserve(Count);
 		}
+
+		/**
+		 * @brief Reconstruye la tabla para Count elementos (0 = ajustar a Num()).
+		 */
+		void Rehash(size_t Count)
+		{
+			Table.Rehash(Count);
+		}
+
+		/**
+		 * @brief Elimina todos los elementos conservando la memoria reservada.
+		 */
+		void Empty()
+		{
+			Table.Clear();
+		}
+
+		ConstIterator begin() const { return ConstIterator(&Table, 0); }
+		ConstIterator end() const { return ConstIterator(&Table, Table.GetCapacity()); }
 	};
 
 	// Example
@@ -175,9 +342,15 @@ namespace EU {
 		std::cout << "Contains 1: " << MySet.Contains(1) << std::endl;  ///< Verificar e imprimir si el conjunto contiene el elemento 1.
 		std::cout << "Contains 2: " << MySet.Contains(2) << std::endl;  ///< Verificar e imprimir si el conjunto contiene el elemento 2.
 
+		TSet<int> Other = { 3, 4, 5 };
+		TSet<int> Common = MySet.Intersect(Other);  ///< { 3 }
+		TSet<int> All = MySet.Union(Other);         ///< { 1, 3, 4, 5 }
+		TSet<int> OnlyMine = MySet.Difference(Other);  ///< { 1 }
+
 		std::cout << "Size: " << MySet.Num() << ", Capacity: " << MySet.GetCapacity() << std::endl;  ///< Imprimir el tamaño y la capacidad del conjunto.
 
 		return 0;
 	}
 	*/
-}
\ No newline at end of file
+
+}
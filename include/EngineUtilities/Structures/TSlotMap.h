@@ -0,0 +1,390 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+#include <cassert>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+#include "EngineUtilities/Structures/TArray.h"
+
+namespace EU {
+	/**
+	 * @brief Handle de un elemento de TSlotMap: índice de ranura + generación.
+	 *
+	 * Con Word = uint32_t se usan 20 bits de índice (1M ranuras) y 12 de
+	 * generación; con uint64_t, 32 y 32. Un handle cuyo elemento se eliminó
+	 * deja de ser válido aunque la ranura se reutilice, porque la generación
+	 * de la ranura cambia. El handle por defecto (valor 0) es nulo.
+	 *
+	 * @tparam T Tipo del elemento (evita mezclar handles de mapas distintos).
+	 * @tparam Word uint32_t o uint64_t.
+	 */
+	template<typename T, typename Word = uint32_t>
+	struct TSlotHandle
+	{
+		static_assert(std::is_same<Word, uint32_t>::value || std::is_same<Word, uint64_t>::value,
+		              "TSlotHandle: Word must be uint32_t or uint64_t");
+
+		static constexpr uint32_t INDEX_BITS = sizeof(Word) == 4 ? 20 : 32;
+		static constexpr Word INDEX_MASK = (Word(1) << INDEX_BITS) - 1;
+		static constexpr Word GENERATION_MASK = ~Word(0) >> INDEX_BITS;
+
+		Word Value;
+
+		constexpr TSlotHandle() : Value(0) {}
+
+		constexpr TSlotHandle(uint32_t Index, uint32_t Generation)
+			: Value((static_cast<Word>(Generation) << INDEX_BITS) | Index)
+		{
+		}
+
+		constexpr uint32_t GetIndex() const { return static_cast<uint32_t>(Value & INDEX_MASK); }
+		constexpr uint32_t GetGeneration() const { return static_cast<uint32_t>(Value >> INDEX_BITS); }
+
+		/**
+		 * @brief Indica si el handle no es nulo (no comprueba que el elemento siga vivo).
+		 */
+		constexpr bool IsSet() const { return Value != 0; }
+
+		constexpr bool operator==(const TSlotHandle& Other) const { return Value == Other.Value; }
+		constexpr bool operator!=(const TSlotHandle& Other) const { return Value != Other.Value; }
+	};
+
+	/**
+	 * @brief TSlotMap guarda elementos en un arreglo denso y los identifica con
+	 *        handles estables que detectan el uso tras eliminar.
+	 *
+	 * - Insert y Remove son O(1): Remove mueve el último elemento al hueco.
+	 * - Get es O(1): una indirección ranura -> índice denso más la
+	 *   comprobación de generación.
+	 * - Iterar recorre los elementos contiguos, sin huecos.
+	 *
+	 * A diferencia de un índice en un std::vector, un handle no cambia cuando
+	 * se eliminan otros elementos, y a diferencia de un puntero compartido no
+	 * tiene contador de referencias. Las ranuras libres se reutilizan en
+	 * orden FIFO para retrasar el desbordamiento de la generación, y una
+	 * ranura que agota sus generaciones se retira para siempre: un handle
+	 * antiguo nunca vuelve a ser válido. Si no quedan ranuras libres ni
+	 * índices para crear otra, Insert/Emplace lanzan std::length_error (en
+	 * cualquier configuración) sin modificar el mapa.
+	 *
+	 * @tparam T Tipo de los elementos.
+	 * @tparam Word Tamaño del handle: uint32_t o uint64_t.
+	 */
+	template<typename T, typename Word = uint32_t>
+	class TSlotMap
+	{
+	public:
+		typedef TSlotHandle<T, Word> Handle;
+
+	private:
+		static constexpr uint32_t NONE = ~uint32_t(0);
+
+		struct Slot
+		{
+			uint32_t Index;       ///< Índice denso si está ocupada; siguiente libre si no.
+			uint32_t Generation;  ///< Generación actual; 0 si la ranura se retiró.
+		};
+
+		TArray<T> Values;            ///< Elementos contiguos.
+		TArray<uint32_t> DenseToSlot; ///< Ranura de cada elemento denso.
+		TArray<Slot> Slots;          ///< Tabla de ranuras indexada por el handle.
+		uint32_t FreeHead;           ///< Primera ranura libre (o NONE).
+		uint32_t FreeTail;           ///< Última ranura libre (o NONE).
+		size_t NumRetired;           ///< Ranuras retiradas por agotar su generación.
+
+		/**
+		 * @brief Falla si el próximo elemento no tendría ranura: no hay
+		 *        ninguna libre y el handle no puede indexar una más.
+		 */
+		void CheckSlotAvailable() const
+		{
+			if (FreeHead == NONE && Slots.Num() >= Handle::INDEX_MASK)
+			{
+				throw std::length_error("TSlotMap: out of slots");
+			}
+		}
+
+		/**
+		 * @brief Toma una ranura libre (o crea una) y la enlaza con el
+		 *        elemento denso recién añadido.
+		 */
+		Handle Bind()
+		{
+			uint32_t SlotIndex;
+			if (FreeHead != NONE)
+			{
+				SlotIndex = FreeHead;
+				FreeHead = Slots[SlotIndex].Index;
+				if (FreeHead == NONE)
+				{
+					FreeTail = NONE;
+				}
+			}
+			else
+			{
+				SlotIndex = static_cast<uint32_t>(Slots.Num());
+				Slots.Add(Slot{ 0, 1 });
+			}
+			Slots[SlotIndex].Index = static_cast<uint32_t>(Values.Num() - 1);
+			DenseToSlot.Add(SlotIndex);
+			return Handle(SlotIndex, Slots[SlotIndex].Generation);
+		}
+
+		void Release(uint32_t SlotIndex)
+		{
+			Slot& Freed = Slots[SlotIndex];
+			Freed.Index = NONE;
+			if (Freed.Generation == static_cast<uint32_t>(Handle::GENERATION_MASK))
+			{
+				// La siguiente generación repetiría una ya entregada: la ranura
+				// no vuelve a la lista libre y ningún handle la iguala (las
+				// generaciones válidas empiezan en 1)
+				Freed.Generation = 0;
+				++NumRetired;
+				return;
+			}
+			++Freed.Generation;
+			if (FreeTail == NONE)
+			{
+				FreeHead = SlotIndex;
+			}
+			else
+			{
+				Slots[FreeTail].Index = SlotIndex;
+			}
+			FreeTail = SlotIndex;
+		}
+
+		/**
+		 * @brief Índice denso del handle, o NONE si no es válido.
+		 */
+		uint32_t DenseIndexOf(Handle H) const
+		{
+			const uint32_t SlotIndex = H.GetIndex();
+			if (SlotIndex >= Slots.Num() || Slots[SlotIndex].Generation != H.GetGeneration())
+			{
+				return NONE;
+			}
+			return Slots[SlotIndex].Index;
+		}
+
+	public:
+		TSlotMap()
+			: FreeHead(NONE), FreeTail(NONE), NumRetired(0)
+		{
+		}
+
+		/**
+		 * @brief Añade un elemento.
+		 *
+		 * @return Handle estable del elemento.
+		 */
+		Handle Insert(const T& Element)
+		{
+			CheckSlotAvailable();
+			Values.Add(Element);
+			return Bind();
+		}
+
+		Handle Insert(T&& Element)
+		{
+			CheckSlotAvailable();
+			Values.Add(std::move(Element));
+			return Bind();
+		}
+
+		/**
+		 * @brief Construye un elemento en sitio.
+		 *
+		 * @return Handle estable del elemento.
+		 */
+		template<typename... Args>
+		Handle Emplace(Args&&... InArgs)
+		{
+			CheckSlotAvailable();
+			Values.Emplace(std::forward<Args>(InArgs)...);
+			return Bind();
+		}
+
+		/**
+		 * @brief Elimina el elemento del handle; el handle y sus copias dejan de ser válidos.
+		 *
+		 * @return true si el handle era válido.
+		 */
+		bool Remove(Handle H)
+		{
+			const uint32_t Dense = DenseIndexOf(H);
+			if (Dense == NONE)
+			{
+				return false;
+			}
+			const size_t Last = Values.Num() - 1;
+			Values.RemoveAtSwap(Dense);
+			DenseToSlot.RemoveAtSwap(Dense);
+			if (Dense != Last)
+			{
+				Slots[DenseToSlot[Dense]].Index = Dense;  ///< El último elemento ocupa ahora el hueco.
+			}
+			Release(H.GetIndex());
+			return true;
+		}
+
+		/**
+		 * @brief Devuelve el elemento del handle, o nullptr si ya no existe.
+		 */
+		T* Get(Handle H)
+		{
+			const uint32_t Dense = DenseIndexOf(H);
+			return Dense == NONE ? nullptr : &Values[Dense];
+		}
+
+		const T* Get(Handle H) const
+		{
+			const uint32_t Dense = DenseIndexOf(H);
+			return Dense == NONE ? nullptr : &Values[Dense];
+		}
+
+		bool Contains(Handle H) const
+		{
+			return DenseIndexOf(H) != NONE;
+		}
+
+		/**
+		 * @brief Acceso sin comprobar la generación: dos lecturas y ningún salto.
+		 *
+		 * Solo para handles que se sabe vivos (la generación se verifica con
+		 * assert en depuración).
+		 */
+		T& GetUnchecked(Handle H)
+		{
+			assert(Contains(H) && "TSlotMap: stale or invalid handle");
+			return Values[Slots[H.GetIndex()].Index];
+		}
+
+		const T& GetUnchecked(Handle H) const
+		{
+			assert(Contains(H) && "TSlotMap: stale or invalid handle");
+			return Values[Slots[H.GetIndex()].Index];
+		}
+
+		/**
+		 * @brief Acceso por handle. El handle debe ser válido; usar Get() si no hay certeza.
+		 */
+		T& operator[](Handle H)
+		{
+			T* Element = Get(H);
+			assert(Element && "TSlotMap: stale or invalid handle");
+			return *Element;
+		}
+
+		const T& operator[](Handle H) const
+		{
+			const T* Element = Get(H);
+			assert(Element && "TSlotMap: stale or invalid handle");
+			return *Element;
+		}
+
+		/**
+		 * @brief Handle del elemento en la posición densa Index (0 <= Index < Num()).
+		 */
+		Handle GetHandleAt(size_t Index) const
+		{
+			const uint32_t SlotIndex = DenseToSlot[Index];
+			return Handle(SlotIndex, Slots[SlotIndex].Generation);
+		}
+
+		/**
+		 * @brief Elemento en la posición densa Index. Las posiciones cambian al eliminar.
+		 */
+		T& GetAt(size_t Index) { return Values[Index]; }
+		const T& GetAt(size_t Index) const { return Values[Index]; }
+
+		size_t Num() const { return Values.Num(); }
+		bool IsEmpty() const { return Values.IsEmpty(); }
+
+		/**
+		 * @brief Ranuras retiradas para siempre por agotar su generación.
+		 */
+		size_t GetNumRetired() const { return NumRetired; }
+
+		/**
+		 * @brief Reserva espacio para Count elementos.
+		 */
+		void Reserve(size_t Count)
+		{
+			Values.Reserve(Count);
+			DenseToSlot.Reserve(Count);
+			Slots.Reserve(Count);
+		}
+
+		/**
+		 * @brief Elimina todos los elementos; los handles existentes dejan de ser válidos.
+		 */
+		void Empty()
+		{
+			for (size_t i = 0; i < DenseToSlot.Num(); ++i)
+			{
+				Release(DenseToSlot[i]);
+			}
+			Values.Empty();
+			DenseToSlot.Empty();
+		}
+
+		T* begin() { return Values.begin(); }
+		T* end() { return Values.end(); }
+		const T* begin() const { return Values.begin(); }
+		const T* end() const { return Values.end(); }
+	};
+
+	// EXAMPLE
+
+	/*
+	int main()
+	{
+		TSlotMap<std::string> Names;
+		TSlotMap<std::string>::Handle A = Names.Insert("Plane");
+		TSlotMap<std::string>::Handle B = Names.Insert("Gun");
+
+		Names.Remove(A);                           ///< "Gun" pasa a la posición densa 0...
+		std::cout << *Names.Get(B) << std::endl;   ///< ...pero su handle sigue siendo válido.
+		std::cout << (Names.Get(A) == nullptr) << std::endl;  ///< 1: handle obsoleto.
+
+		TSlotMap<std::string>::Handle C = Names.Insert("Light");  ///< Puede reutilizar la ranura de A con otra generación.
+		std::cout << (A != C) << std::endl;
+
+		for (const std::string& Name : Names)      ///< Iteración densa, sin huecos.
+		{
+			std::cout << Name << std::endl;
+		}
+		return 0;
+	}
+	*/
+}
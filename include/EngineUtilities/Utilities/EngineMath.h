@@ -27,31 +27,241 @@
  * SOFTWARE.
 */
 #pragma once
+
+#include <cstring>
+#include "EngineUtilities/Utilities/SIMD.h"
+
 namespace EU {
 
   // Constantes matemáticas
   constexpr float PI = 3.14159265358979323846f;
   constexpr float E = 2.71828182845904523536f;
+  constexpr float HALF_PI = 1.57079632679489661923f;
+  constexpr float LN2 = 0.693147180559945309417f;
+  constexpr float LOG2E = 1.44269504088896340736f;
+
+  /**
+   * Núcleos de coste fijo usados por las funciones trascendentales.
+   *
+   * Todas siguen el mismo esquema: reducción de rango (Cody-Waite) seguida de
+   * un polinomio minimax evaluado con Horner. No hay bucles dependientes del
+   * dato, así que la latencia es la misma para cualquier entrada. Los mismos
+   * coeficientes se usan en las versiones de 4 y 8 carriles de EngineMathSIMD.h.
+   *
+   * Dos niveles de precisión:
+   *  - Preciso (sin, cos, exp, log...): error ~1-2 ulp en el rango reducido.
+   *  - Rápido (fastSin, fastExp...): polinomios más cortos, error ~1e-5 a 1e-4.
+   */
+  namespace detail {
+    // pi/2 partido en tres para que q * PIO2_1 sea exacto (Cody-Waite).
+    // La reducción es precisa para |x| < ~8000.
+    constexpr float PIO2_1 = 1.5703125f;
+    constexpr float PIO2_2 = 4.837512969970703125e-4f;
+    constexpr float PIO2_3 = 7.54978995489188216e-8f;
+    constexpr float TWO_OVER_PI = 0.636619772367581343f;
+
+    // ln(2) partido en dos para la reducción de exp/log.
+    constexpr float LN2_HI = 0.693359375f;
+    constexpr float LN2_LO = -2.12194440e-4f;
+    constexpr float SQRT_HALF = 0.707106781186547524f;
+
+    // Límites de exp: por encima se satura a +inf, por debajo a 0.
+    constexpr float EXP_MAX = 88.7228390f;
+    constexpr float EXP_MIN = -103.972076f;
+
+    // Precise tier (Cephes single precision minimax coefficients).
+    constexpr float SIN_C1 = -1.9515295891e-4f;
+    constexpr float SIN_C2 = 8.3321608736e-3f;
+    constexpr float SIN_C3 = -1.6666654611e-1f;
+    constexpr float COS_C1 = 2.443315711809948e-5f;
+    constexpr float COS_C2 = -1.388731625493765e-3f;
+    constexpr float COS_C3 = 4.166664568298827e-2f;
+    constexpr float EXP_C1 = 1.9875691500e-4f;
+    constexpr float EXP_C2 = 1.3981999507e-3f;
+    constexpr float EXP_C3 = 8.3334519073e-3f;
+    constexpr float EXP_C4 = 4.1665795894e-2f;
+    constexpr float EXP_C5 = 1.6666665459e-1f;
+    constexpr float EXP_C6 = 5.0000001201e-1f;
+    constexpr float LOG_C1 = 7.0376836292e-2f;
+    constexpr float LOG_C2 = -1.1514610310e-1f;
+    constexpr float LOG_C3 = 1.1676998740e-1f;
+    constexpr float LOG_C4 = -1.2420140846e-1f;
+    constexpr float LOG_C5 = 1.4249322787e-1f;
+    constexpr float LOG_C6 = -1.6668057665e-1f;
+    constexpr float LOG_C7 = 2.0000714765e-1f;
+    constexpr float LOG_C8 = -2.4999993993e-1f;
+    constexpr float LOG_C9 = 3.3333331174e-1f;
+
+    // Fast tier (Remez fits on the same reduced ranges).
+    constexpr float FSIN_C0 = 0.99999857f;
+    constexpr float FSIN_C1 = -0.16662480f;
+    constexpr float FSIN_C2 = 0.0081516356f;
+    constexpr float FCOS_C0 = 0.99999003f;
+    constexpr float FCOS_C1 = -0.49970814f;
+    constexpr float FCOS_C2 = 0.040398536f;
+    constexpr float FEXP_C0 = 0.99992807f;
+    constexpr float FEXP_C1 = 1.0001642f;
+    constexpr float FEXP_C2 = 0.50496326f;
+    constexpr float FEXP_C3 = 0.16566842f;
+    constexpr float FLOG_C0 = 0.99935233f;
+    constexpr float FLOG_C1 = -0.50246527f;
+    constexpr float FLOG_C2 = 0.35871018f;
+    constexpr float FLOG_C3 = -0.22848198f;
+
+    inline int
+    floatAsInt(float value) {
+      int bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      return bits;
+    }
+
+    inline float
+    intAsFloat(int bits) {
+      float value;
+      std::memcpy(&value, &bits, sizeof(value));
+      return value;
+    }
+
+    inline int
+    roundToInt(float value) {
+      return static_cast<int>(value >= 0.0f ? value + 0.5f : value - 0.5f);
+    }
+
+    /**
+     * Reduce x a r en [-pi/4, pi/4] con x = q * pi/2 + r.
+     */
+    inline float
+    reduceHalfPi(float x, int& quadrant) {
+      quadrant = roundToInt(x * TWO_OVER_PI);
+      float q = static_cast<float>(quadrant);
+      return ((x - q * PIO2_1) - q * PIO2_2) - q * PIO2_3;
+    }
+
+    inline float
+    sinPoly(float r) {
+      float z = r * r;
+      return r + r * z * ((SIN_C1 * z + SIN_C2) * z + SIN_C3);
+    }
+
+    inline float
+    cosPoly(float r) {
+      float z = r * r;
+      return 1.0f - 0.5f * z + z * z * ((COS_C1 * z + COS_C2) * z + COS_C3);
+    }
+
+    inline float
+    fastSinPoly(float r) {
+      float z = r * r;
+      return r * ((FSIN_C2 * z + FSIN_C1) * z + FSIN_C0);
+    }
+
+    inline float
+    fastCosPoly(float r) {
+      float z = r * r;
+      return (FCOS_C2 * z + FCOS_C1) * z + FCOS_C0;
+    }
+
+    /**
+     * Devuelve 2^n para n en [-252, 254] como dos potencias normales,
+     * de forma que el resultado de exp no desborde el exponente intermedio.
+     */
+    inline float
+    scaleByPow2(float value, int n) {
+      int half = n >> 1;
+      value *= intAsFloat((half + 127) << 23);
+      return value * intAsFloat((n - half + 127) << 23);
+    }
 
-	/**
-		 * @brief Computes the square root using the Newton-Raphson method.
-		 *
-		 * @param value The value to compute the square root of.
-		 * @return The computed square root.
-		 */
-	inline float sqrt(float value) {
-		if (value < 0) {
-			return 0; // Handle negative input gracefully.
-		}
-		float x = value;
-		float y = 1.0f;
-		float epsilon = 0.00001f; // Desired precision.
-		while (x - y > epsilon) {
-			x = (x + y) / 2.0f;
-			y = value / x;
-		}
-		return x;
-	}
+    /**
+     * Separa value (> 0, normal) en mantisa m en [sqrt(0.5) - 1, sqrt(2) - 1)
+     * y exponente e, con value = (1 + m) * 2^e.
+     */
+    inline float
+    splitLog(float value, int& exponent) {
+      int bits = floatAsInt(value);
+      exponent = ((bits >> 23) & 0xff) - 126;
+      float m = intAsFloat((bits & 0x007fffff) | 0x3f000000);
+      if (m < SQRT_HALF) {
+        exponent -= 1;
+        return m + m - 1.0f;
+      }
+      return m - 1.0f;
+    }
+
+    /**
+     * Raíz cuadrada evaluable en tiempo de compilación: Newton desde una
+     * semilla >= sqrt(value), que decrece monótonamente hasta converger.
+     */
+    constexpr float
+    sqrtNewton(float value) {
+      float x = value > 1.0f ? value : 1.0f;
+      for (int i = 0; i < 128; ++i) {
+        float next = 0.5f * (x + value / x);
+        if (next >= x) {
+          break;
+        }
+        x = next;
+      }
+      return x;
+    }
+  }
+
+  /**
+   * @brief Computes the square root.
+   *
+   * Uses the hardware square root when a SIMD backend is available and a
+   * fixed three-step Newton iteration from an exponent-halved seed otherwise.
+   * Constant-evaluable (iterates Newton to convergence at compile time).
+   *
+   * @param value The value to compute the square root of.
+   * @return The computed square root (0 for negative input).
+   */
+  constexpr float sqrt(float value) {
+    if (value <= 0) {
+      return 0; // Handle negative input gracefully.
+    }
+    if (EU_IS_CONSTANT_EVALUATED()) {
+      return detail::sqrtNewton(value);
+    }
+#if defined(EU_SIMD_SSE2)
+    return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(value)));
+#else
+    float x = detail::intAsFloat((detail::floatAsInt(value) >> 1) + 0x1fbd1df5);
+    x = 0.5f * (x + value / x);
+    x = 0.5f * (x + value / x);
+    x = 0.5f * (x + value / x);
+    return x;
+#endif
+  }
+
+  /**
+   * @brief Computes 1 / sqrt(value) with a relative error below 5e-6.
+   *
+   * Hardware estimate (or the classic bit-level seed) refined with one
+   * Newton-Raphson step.
+   *
+   * @param value The value (must be > 0).
+   * @return The reciprocal square root.
+   */
+  inline float rsqrt(float value) {
+#if defined(EU_SIMD_SSE2)
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(value)));
+#else
+    float y = detail::intAsFloat(0x5f375a86 - (detail::floatAsInt(value) >> 1));
+    y = y * (1.5f - 0.5f * value * y * y);
+#endif
+    return y * (1.5f - 0.5f * value * y * y);
+  }
+
+  /**
+   * @brief Fast square root (value * rsqrt(value)), relative error below 5e-6.
+   *
+   * @param value The value to compute the square root of.
+   * @return The approximate square root (0 for non-positive input).
+   */
+  inline float fastSqrt(float value) {
+    return value > 0 ? value * rsqrt(value) : 0;
+  }
 
   /**
    * @brief Calcula el cuadrado de un número.
@@ -59,7 +269,7 @@ namespace EU {
    * @param value El valor del cual se desea calcular el cuadrado.
    * @return El cuadrado del valor dado.
    */
-  inline float square(float value) {
+  constexpr float square(float value) {
     return value * value;
   }
 
@@ -69,7 +279,7 @@ namespace EU {
    * @param value El valor del cual se desea calcular el cubo.
    * @return El cubo del valor dado.
    */
-  inline float cube(float value) {
+  constexpr float cube(float value) {
     return value * value * value;
   }
 
@@ -80,7 +290,7 @@ namespace EU {
    * @param exponent El exponente al que se eleva la base.
    * @return La base elevada al exponente.
    */
-  inline float power(float base, int exponent) {
+  constexpr float power(float base, int exponent) {
     if (exponent == 0) return 1;
     if (exponent < 0) return 1.0f / power(base, -exponent);
     float result = 1;
@@ -98,7 +308,7 @@ namespace EU {
    * @param value El valor del cual se desea calcular el valor absoluto.
    * @return El valor absoluto del valor dado.
    */
-  inline float abs(float value) {
+  constexpr float abs(float value) {
     return (value < 0) ? -value : value;
   }
 
@@ -109,7 +319,7 @@ namespace EU {
    * @param b El segundo valor.
    * @return El mayor de los dos valores dados.
    */
-  inline float EMax(float a, float b) {
+  constexpr float EMax(float a, float b) {
     return (a > b) ? a : b;
   }
 
@@ -120,7 +330,7 @@ namespace EU {
    * @param b El segundo valor.
    * @return El menor de los dos valores dados.
    */
-  inline float EMin(float a, float b) {
+  constexpr float EMin(float a, float b) {
     return (a < b) ? a : b;
   }
 
@@ -130,7 +340,7 @@ namespace EU {
    * @param value El valor que se desea redondear.
    * @return El valor redondeado al entero más cercano.
    */
-  inline float round(float value) {
+  constexpr float round(float value) {
     return (value > 0) ? static_cast<int>(value + 0.5f) : static_cast<int>(value - 0.5f);
   }
 
@@ -140,7 +350,7 @@ namespace EU {
    * @param value El valor que se desea truncar.
    * @return La parte entera del valor dado, redondeada hacia abajo.
    */
-  inline float floor(float value) {
+  constexpr float floor(float value) {
     int intValue = static_cast<int>(value);
     return (value < intValue) ? intValue - 1 : intValue;
   }
@@ -151,7 +361,7 @@ namespace EU {
    * @param value El valor que se desea redondear hacia arriba.
    * @return El valor redondeado hacia arriba al entero más cercano.
    */
-  inline float ceil(float value) {
+  constexpr float ceil(float value) {
     int intValue = static_cast<int>(value);
     return (value > intValue) ? intValue + 1 : intValue;
   }
@@ -161,36 +371,52 @@ namespace EU {
    * @param value Valor flotante.
    * @return Valor absoluto del número flotante.
    */
-  inline float fabs(float value) {
+  constexpr float fabs(float value) {
     return value < 0.0f ? -value : value;
   }
 
   // Funciones Trigonométricas
   /**
    * Calcula el seno de un ángulo en radianes.
-   * @param angle Ángulo en radianes.
+   * Coste fijo: reducción a [-pi/4, pi/4] y polinomio de grado 7.
+   * @param angle Ángulo en radianes (preciso para |angle| < ~8000).
    * @return Valor del seno del ángulo.
    */
   inline float sin(float angle) {
-    float result = 0.0f;
-    float term = angle;
-    float angle_squared = angle * angle;
-    int n = 1;
-    while (term > 1e-6f || term < -1e-6f) {
-      result += term;
-      term *= -angle_squared / ((2 * n) * (2 * n + 1));
-      ++n;
-    }
-    return result;
+    int q;
+    float r = detail::reduceHalfPi(angle, q);
+    float p = (q & 1) ? detail::cosPoly(r) : detail::sinPoly(r);
+    return (q & 2) ? -p : p;
   }
 
   /**
    * Calcula el coseno de un ángulo en radianes.
-   * @param angle Ángulo en radianes.
+   * @param angle Ángulo en radianes (preciso para |angle| < ~8000).
    * @return Valor del coseno del ángulo.
    */
   inline float cos(float angle) {
-    return sin(angle + PI / 2);
+    int q;
+    float r = detail::reduceHalfPi(angle, q);
+    q += 1;
+    float p = (q & 1) ? detail::cosPoly(r) : detail::sinPoly(r);
+    return (q & 2) ? -p : p;
+  }
+
+  /**
+   * Calcula seno y coseno compartiendo la reducción de rango.
+   * @param angle Ángulo en radianes.
+   * @param outSin Seno del ángulo.
+   * @param outCos Coseno del ángulo.
+   */
+  inline void sincos(float angle, float& outSin, float& outCos) {
+    int q;
+    float r = detail::reduceHalfPi(angle, q);
+    float sp = detail::sinPoly(r);
+    float cp = detail::cosPoly(r);
+    float s = (q & 1) ? cp : sp;
+    float c = (q & 1) ? sp : cp;
+    outSin = (q & 2) ? -s : s;
+    outCos = ((q + 1) & 2) ? -c : c;
   }
 
   /**
@@ -199,26 +425,58 @@ namespace EU {
    * @return Valor de la tangente del ángulo.
    */
   inline float tan(float angle) {
-    float s = sin(angle);
-    float c = cos(angle);
+    float s, c;
+    sincos(angle, s, c);
     return c != 0.0f ? s / c : 0.0f; // Evita la división por cero
   }
 
+  /**
+   * Seno rápido (error absoluto < 2e-5), para bucles por vértice o entidad.
+   * @param angle Ángulo en radianes.
+   * @return Valor aproximado del seno.
+   */
+  inline float fastSin(float angle) {
+    int q = detail::roundToInt(angle * detail::TWO_OVER_PI);
+    float qf = static_cast<float>(q);
+    float r = (angle - qf * detail::PIO2_1) - qf * detail::PIO2_2;
+    float p = (q & 1) ? detail::fastCosPoly(r) : detail::fastSinPoly(r);
+    return (q & 2) ? -p : p;
+  }
+
+  /**
+   * Coseno rápido (error absoluto < 2e-5).
+   * @param angle Ángulo en radianes.
+   * @return Valor aproximado del coseno.
+   */
+  inline float fastCos(float angle) {
+    int q = detail::roundToInt(angle * detail::TWO_OVER_PI);
+    float qf = static_cast<float>(q);
+    float r = (angle - qf * detail::PIO2_1) - qf * detail::PIO2_2;
+    q += 1;
+    float p = (q & 1) ? detail::fastCosPoly(r) : detail::fastSinPoly(r);
+    return (q & 2) ? -p : p;
+  }
+
   /**
    * Calcula el arco seno de un valor.
-   * @param value Valor en el rango [-1, 1].
+   * @param value Valor en el rango [-1, 1] (se satura fuera de él).
    * @return Ángulo en radianes.
    */
   inline float asin(float value) {
-    // Aproximación con la serie de Taylor
-    float x = value;
-    float result = x;
-    float term = x;
-    for (int n = 1; n < 10; ++n) {
-      term *= x * x * (2 * n - 1) / ((2 * n + 1) * (2 * n));
-      result += term;
+    float a = value < 0 ? -value : value;
+    if (a > 1.0f) {
+      a = 1.0f;
     }
-    return result;
+    // Para |x| > 0.5 se usa asin(x) = pi/2 - 2 asin(sqrt((1 - x) / 2)).
+    bool upper = a > 0.5f;
+    float z = upper ? 0.5f * (1.0f - a) : a * a;
+    float x = upper ? sqrt(z) : a;
+    float p = ((((4.2163199048e-2f * z + 2.4181311049e-2f) * z + 4.5470025998e-2f) * z +
+               7.4953002686e-2f) * z + 1.6666752422e-1f) * z * x + x;
+    if (upper) {
+      p = HALF_PI - (p + p);
+    }
+    return value < 0 ? -p : p;
   }
 
   /**
@@ -227,7 +485,7 @@ namespace EU {
    * @return Ángulo en radianes.
    */
   inline float acos(float value) {
-    return PI / 2 - asin(value);
+    return HALF_PI - asin(value);
   }
 
   /**
@@ -236,16 +494,44 @@ namespace EU {
    * @return Ángulo en radianes.
    */
   inline float atan(float value) {
-    // Aproximación de la función arcotangente
-    float result = 0.0f;
-    float term = value;
-    for (int n = 0; n < 10; ++n) {
-      result += term / (2 * n + 1);
-      term *= -value * value;
+    float x = value < 0 ? -value : value;
+    float offset = 0.0f;
+    // Reducción a |x| <= tan(pi/8) con las identidades de pi/4 y pi/2.
+    if (x > 2.414213562373095f) {
+      offset = HALF_PI;
+      x = -1.0f / x;
     }
-    return result;
+    else if (x > 0.4142135623730950f) {
+      offset = 0.25f * PI;
+      x = (x - 1.0f) / (x + 1.0f);
+    }
+    float z = x * x;
+    float p = offset + ((((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z -
+                         3.33329491539e-1f) * z * x + x);
+    return value < 0 ? -p : p;
+  }
+
+  /**
+   * Calcula el arco tangente de y / x usando los signos para elegir el cuadrante.
+   * @param y Componente y.
+   * @param x Componente x.
+   * @return Ángulo en radianes en [-pi, pi].
+   */
+  inline float atan2(float y, float x) {
+    if (x > 0.0f) {
+      return atan(y / x);
+    }
+    if (x < 0.0f) {
+      return y >= 0.0f ? atan(y / x) + PI : atan(y / x) - PI;
+    }
+    if (y > 0.0f) {
+      return HALF_PI;
+    }
+    return y < 0.0f ? -HALF_PI : 0.0f;
   }
 
+  inline float exp(float value);
+
   /**
    * Calcula el seno hiperbólico de un valor.
    * @param value Valor.
@@ -279,7 +565,7 @@ namespace EU {
    * @param degrees Ángulo en grados.
    * @return Ángulo en radianes.
    */
-  inline float radians(float degrees) {
+  constexpr float radians(float degrees) {
     return degrees * PI / 180.0f;
   }
 
@@ -288,43 +574,86 @@ namespace EU {
    * @param radians Ángulo en radianes.
    * @return Ángulo en grados.
    */
-  inline float degrees(float radians) {
+  constexpr float degrees(float radians) {
     return radians * 180.0f / PI;
   }
 
   // Funciones Exponenciales y Logarítmicas
   /**
    * Calcula la función exponencial e^x.
+   * Coste fijo: x = n ln2 + r, polinomio de grado 7 en r y escalado por 2^n.
    * @param value Exponente.
    * @return Valor de e^x.
    */
   inline float exp(float value) {
-    float result = 1.0f;
-    float term = 1.0f;
-    for (int n = 1; n < 20; ++n) {
-      term *= value / n;
-      result += term;
+    if (value > detail::EXP_MAX) {
+      value = detail::EXP_MAX;
     }
-    return result;
+    if (value < detail::EXP_MIN) {
+      value = detail::EXP_MIN;
+    }
+    int n = detail::roundToInt(value * LOG2E);
+    float nf = static_cast<float>(n);
+    float r = (value - nf * detail::LN2_HI) - nf * detail::LN2_LO;
+    float p = (((((detail::EXP_C1 * r + detail::EXP_C2) * r + detail::EXP_C3) * r + detail::EXP_C4) * r +
+                detail::EXP_C5) * r + detail::EXP_C6) * r * r + r + 1.0f;
+    return detail::scaleByPow2(p, n);
+  }
+
+  /**
+   * Exponencial rápida (error relativo < 1e-4).
+   * @param value Exponente, se satura a [-87, 88].
+   * @return Valor aproximado de e^x.
+   */
+  inline float fastExp(float value) {
+    if (value > 88.0f) {
+      value = 88.0f;
+    }
+    if (value < -87.0f) {
+      value = -87.0f;
+    }
+    int n = detail::roundToInt(value * LOG2E);
+    float r = value - static_cast<float>(n) * LN2;
+    float p = ((detail::FEXP_C3 * r + detail::FEXP_C2) * r + detail::FEXP_C1) * r + detail::FEXP_C0;
+    return p * detail::intAsFloat((n + 127) << 23);
   }
 
   /**
    * Calcula el logaritmo natural de un valor.
+   * Coste fijo: separa mantisa y exponente y evalúa un polinomio de grado 9.
    * @param value Valor.
-   * @return Logaritmo natural.
+   * @return Logaritmo natural (0 para valores no positivos).
    */
   inline float log(float value) {
-    // Aproximación usando la serie de Taylor
     if (value <= 0) return 0;
-    float x = (value - 1) / (value + 1);
-    float x2 = x * x;
-    float result = 0.0f;
-    float term = x;
-    for (int n = 1; n < 20; ++n) {
-      result += term / (2 * n - 1);
-      term *= x2;
+    int e;
+    int denormalShift = 0;
+    if (value < 1.17549435e-38f) {
+      value *= 33554432.0f; // 2^25, lleva los subnormales al rango normal
+      denormalShift = 25;
     }
-    return 2 * result;
+    float x = detail::splitLog(value, e);
+    float fe = static_cast<float>(e - denormalShift);
+    float z = x * x;
+    float y = ((((((((detail::LOG_C1 * x + detail::LOG_C2) * x + detail::LOG_C3) * x + detail::LOG_C4) * x +
+                   detail::LOG_C5) * x + detail::LOG_C6) * x + detail::LOG_C7) * x + detail::LOG_C8) * x +
+               detail::LOG_C9) * x * z;
+    y += detail::LN2_LO * fe;
+    y -= 0.5f * z;
+    return x + y + detail::LN2_HI * fe;
+  }
+
+  /**
+   * Logaritmo natural rápido (error absoluto < 1e-4).
+   * @param value Valor (normal y positivo).
+   * @return Logaritmo natural aproximado (0 para valores no positivos).
+   */
+  inline float fastLog(float value) {
+    if (value <= 0) return 0;
+    int e;
+    float x = detail::splitLog(value, e);
+    float p = ((detail::FLOG_C3 * x + detail::FLOG_C2) * x + detail::FLOG_C1) * x + detail::FLOG_C0;
+    return x * p + static_cast<float>(e) * LN2;
   }
 
   /**
@@ -333,7 +662,7 @@ namespace EU {
    * @return Logaritmo en base 10.
    */
   inline float log10(float value) {
-    return log(value) / log(10);
+    return log(value) * 0.434294481903251827651f;
   }
 
   // Operaciones de Redondeo Avanzadas
@@ -343,7 +672,7 @@ namespace EU {
    * @param b Divisor.
    * @return Módulo.
    */
-  inline float mod(float a, float b) {
+  constexpr float mod(float a, float b) {
     return a - b * static_cast<int>(a / b);
   }
 
@@ -353,7 +682,7 @@ namespace EU {
    * @param radius Radio del círculo.
    * @return Área del círculo.
    */
-  inline float circleArea(float radius) {
+  constexpr float circleArea(float radius) {
     return PI * radius * radius;
   }
 
@@ -362,7 +691,7 @@ namespace EU {
    * @param radius Radio del círculo.
    * @return Circunferencia del círculo.
    */
-  inline float circleCircumference(float radius) {
+  constexpr float circleCircumference(float radius) {
     return 2 * PI * radius;
   }
 
@@ -372,7 +701,7 @@ namespace EU {
    * @param height Alto del rectángulo.
    * @return Área del rectángulo.
    */
-  inline float rectangleArea(float width, float height) {
+  constexpr float rectangleArea(float width, float height) {
     return width * height;
   }
 
@@ -382,7 +711,7 @@ namespace EU {
    * @param height Alto del rectángulo.
    * @return Perímetro del rectángulo.
    */
-  inline float rectanglePerimeter(float width, float height) {
+  constexpr float rectanglePerimeter(float width, float height) {
     return 2 * (width + height);
   }
 
@@ -392,7 +721,7 @@ namespace EU {
    * @param height Altura del triángulo.
    * @return Área del triángulo.
    */
-  inline float triangleArea(float base, float height) {
+  constexpr float triangleArea(float base, float height) {
     return 0.5f * base * height;
   }
 
@@ -404,7 +733,7 @@ namespace EU {
    * @param y2 Coordenada y del segundo punto.
    * @return Distancia entre los dos puntos.
    */
-  inline float distance(float x1, float y1, float x2, float y2) {
+  constexpr float distance(float x1, float y1, float x2, float y2) {
     float dx = x2 - x1;
     float dy = y2 - y1;
     return sqrt(dx * dx + dy * dy);
@@ -418,7 +747,7 @@ namespace EU {
    * @param t Parámetro de interpolación entre 0 y 1.
    * @return Valor interpolado.
    */
-  inline float lerp(float a, float b, float t) {
+  constexpr float lerp(float a, float b, float t) {
     return a + t * (b - a);
   }
 
@@ -427,7 +756,7 @@ namespace EU {
    * @param n Número entero no negativo.
    * @return Factorial de n.
    */
-  inline int factorial(int n) {
+  constexpr int factorial(int n) {
     int result = 1;
     for (int i = 2; i <= n; ++i) {
       result *= i;
@@ -442,8 +771,7 @@ namespace EU {
    * @param epsilon Margen de error.
    * @return Verdadero si los valores son aproximadamente iguales.
    */
-  inline bool approxEqual(float a, float b, float epsilon) {
+  constexpr bool approxEqual(float a, float b, float epsilon) {
     return fabs(a - b) < epsilon;
   }
-
 }
\ No newline at end of file
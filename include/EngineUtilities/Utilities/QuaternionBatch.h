@@ -0,0 +1,218 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+#include "EngineUtilities/Utilities/SIMD.h"
+#include "EngineUtilities/Utilities/EngineMathSIMD.h"
+#include "EngineUtilities/Utilities/TransformBatch.h"
+#include "EngineUtilities/Vectors/Quaternion.h"
+
+/**
+ * @file QuaternionBatch.h
+ * @brief Array versions of Quaternion::nlerp and Quaternion::slerp.
+ *
+ * Four quaternions are loaded per iteration and transposed to SoA (w, x, y, z
+ * registers). SLERP uses a polynomial acos and SIMD::sin, with the nlerp
+ * fallback for nearly identical rotations selected per lane, so there are no
+ * branches or libm calls in the loop. Large arrays are split with
+ * Batch::parallelFor.
+ */
+namespace EU {
+namespace Batch {
+  static_assert(sizeof(Quaternion) == 4 * sizeof(float), "Quaternion must be four packed floats");
+
+  namespace detail {
+    /**
+     * Cuatro cuaterniones en formato SoA.
+     */
+    struct Quat4 {
+      SIMD::Float4 w, x, y, z;
+
+      void load(const Quaternion* q) {
+        w = SIMD::load4(q[0].data());
+        x = SIMD::load4(q[1].data());
+        y = SIMD::load4(q[2].data());
+        z = SIMD::load4(q[3].data());
+        SIMD::transpose4(w, x, y, z);
+      }
+
+      void store(Quaternion* q) const {
+        SIMD::Float4 r0 = w, r1 = x, r2 = y, r3 = z;
+        SIMD::transpose4(r0, r1, r2, r3);
+        SIMD::store(&q[0].w, r0);
+        SIMD::store(&q[1].w, r1);
+        SIMD::store(&q[2].w, r2);
+        SIMD::store(&q[3].w, r3);
+      }
+
+      SIMD::Float4 dot(const Quat4& o) const {
+        return SIMD::madd(w, o.w, SIMD::madd(x, o.x, SIMD::madd(y, o.y, SIMD::mul(z, o.z))));
+      }
+
+      /**
+       * a * wa + b * wb, normalizado.
+       */
+      static Quat4 blend(const Quat4& a, SIMD::Float4 wa, const Quat4& b, SIMD::Float4 wb) {
+        Quat4 r;
+        r.w = SIMD::madd(a.w, wa, SIMD::mul(b.w, wb));
+        r.x = SIMD::madd(a.x, wa, SIMD::mul(b.x, wb));
+        r.y = SIMD::madd(a.y, wa, SIMD::mul(b.y, wb));
+        r.z = SIMD::madd(a.z, wa, SIMD::mul(b.z, wb));
+        const SIMD::Float4 invLen = SIMD::div(SIMD::splat4(1.0f), SIMD::sqrt(r.dot(r)));
+        r.w = SIMD::mul(r.w, invLen);
+        r.x = SIMD::mul(r.x, invLen);
+        r.y = SIMD::mul(r.y, invLen);
+        r.z = SIMD::mul(r.z, invLen);
+        return r;
+      }
+    };
+
+    /**
+     * acos(x) para x en [0, 1]: sqrt(1 - x) * P(x), error < 2e-7 (Abramowitz-Stegun 4.4.46).
+     */
+    inline SIMD::Float4
+    acosUnit(SIMD::Float4 x) {
+      SIMD::Float4 p = SIMD::splat4(-0.0012624911f);
+      p = SIMD::madd(p, x, SIMD::splat4(0.0066700901f));
+      p = SIMD::madd(p, x, SIMD::splat4(-0.0170881256f));
+      p = SIMD::madd(p, x, SIMD::splat4(0.0308918810f));
+      p = SIMD::madd(p, x, SIMD::splat4(-0.0501743046f));
+      p = SIMD::madd(p, x, SIMD::splat4(0.0889789874f));
+      p = SIMD::madd(p, x, SIMD::splat4(-0.2145988016f));
+      p = SIMD::madd(p, x, SIMD::splat4(1.5707963050f));
+      return SIMD::mul(p, SIMD::sqrt(SIMD::sub(SIMD::splat4(1.0f), x)));
+    }
+
+    /**
+     * Lleva b al mismo hemisferio que a; devuelve |a . b|.
+     */
+    inline SIMD::Float4
+    shortestPath(const Quat4& a, Quat4& b) {
+      const SIMD::Float4 d = a.dot(b);
+      const SIMD::Float4 sign = SIMD::bitAnd(d, SIMD::splat4(-0.0f));
+      b.w = SIMD::bitXor(b.w, sign);
+      b.x = SIMD::bitXor(b.x, sign);
+      b.y = SIMD::bitXor(b.y, sign);
+      b.z = SIMD::bitXor(b.z, sign);
+      return SIMD::bitXor(d, sign);
+    }
+
+    template<bool Spherical>
+    inline void
+    interpolateRange(const Quaternion* a, const Quaternion* b, float t, Quaternion* out,
+                     size_t begin, size_t end) {
+      const SIMD::Float4 vt = SIMD::splat4(t);
+      const SIMD::Float4 vs = SIMD::splat4(1.0f - t);
+
+      size_t i = begin;
+      for (; i + 4 <= end; i += 4) {
+        Quat4 qa, qb;
+        qa.load(a + i);
+        qb.load(b + i);
+        const SIMD::Float4 d = shortestPath(qa, qb);
+
+        SIMD::Float4 wa = vs, wb = vt;
+        if (Spherical) {
+          const SIMD::Float4 theta = acosUnit(SIMD::EMin(d, SIMD::splat4(1.0f)));
+          const SIMD::Float4 invSin = SIMD::div(SIMD::splat4(1.0f), SIMD::sin(theta));
+          const SIMD::Float4 slerpA = SIMD::mul(SIMD::sin(SIMD::mul(vs, theta)), invSin);
+          const SIMD::Float4 slerpB = SIMD::mul(SIMD::sin(SIMD::mul(vt, theta)), invSin);
+          // Mismo umbral que Quaternion::slerp para caer en nlerp.
+          const SIMD::Float4 useSlerp = SIMD::cmpLt(d, SIMD::splat4(0.9995f));
+          wa = SIMD::select(useSlerp, slerpA, vs);
+          wb = SIMD::select(useSlerp, slerpB, vt);
+        }
+        Quat4::blend(qa, wa, qb, wb).store(out + i);
+      }
+      for (; i < end; ++i) {
+        out[i] = Spherical ? Quaternion::slerp(a[i], b[i], t) : Quaternion::nlerp(a[i], b[i], t);
+      }
+    }
+  }
+
+  /**
+   * @brief out[i] = Quaternion::nlerp(a[i], b[i], t) for every i.
+   *
+   * @param a The start rotations.
+   * @param b The end rotations.
+   * @param t The interpolation factor shared by all pairs.
+   * @param out The destination; may alias @p a or @p b.
+   * @param count The number of quaternions.
+   */
+  inline void
+  nlerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count) {
+    parallelFor(count, [&](size_t begin, size_t end, size_t) {
+      detail::interpolateRange<false>(a, b, t, out, begin, end);
+    });
+  }
+
+  /**
+   * @brief out[i] = Quaternion::slerp(a[i], b[i], t) for every i.
+   *
+   * Inputs must be normalized. Matches the scalar version to about 1e-6.
+   *
+   * @param a The start rotations.
+   * @param b The end rotations.
+   * @param t The interpolation factor shared by all pairs.
+   * @param out The destination; may alias @p a or @p b.
+   * @param count The number of quaternions.
+   */
+  inline void
+  slerp(const Quaternion* a, const Quaternion* b, float t, Quaternion* out, size_t count) {
+    parallelFor(count, [&](size_t begin, size_t end, size_t) {
+      detail::interpolateRange<true>(a, b, t, out, begin, end);
+    });
+  }
+
+  // EXAMPLE: blend two poses of 100k bones.
+
+  /*
+  #include <chrono>
+  #include <cstdio>
+
+  int main()
+  {
+    const size_t N = 100000;
+    std::vector<EU::Quaternion> poseA(N), poseB(N), result(N);
+    for (size_t i = 0; i < N; ++i) {
+      poseA[i] = EU::Quaternion::fromEuler(0.001f * i, 0.0f, 0.0f);
+      poseB[i] = EU::Quaternion::fromEuler(0.0f, 0.002f * i, 0.3f);
+    }
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    EU::Batch::slerp(&poseA[0], &poseB[0], 0.25f, &result[0], N);
+    auto t1 = std::chrono::high_resolution_clock::now();
+
+    std::printf("%s slerp: %.2f ns/quaternion\n", EU::SIMD::backendName(),
+                std::chrono::duration<double, std::nano>(t1 - t0).count() / N);
+    return 0;
+  }
+  */
+}
+}
@@ -0,0 +1,501 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+#pragma once
+
+/**
+ * @file SIMD.h
+ * @brief Compile-time selected SIMD backend for the EU math types.
+ *
+ * The backend is picked from the compiler target flags:
+ *  - EU_SIMD_AVX2 : /arch:AVX2 or -mavx2 (8-wide Float8 is native).
+ *  - EU_SIMD_SSE2 : x64, /arch:SSE2 or -msse2.
+ *  - scalar       : anything else, or when EU_SIMD_SCALAR is defined.
+ *
+ * EU_SIMD_FMA is enabled when fused multiply-add is available, in which case
+ * madd() compiles to a single vfmadd instruction.
+ */
+
+#if !defined(EU_SIMD_SCALAR)
+#  if defined(__AVX2__)
+#    define EU_SIMD_AVX2 1
+#  endif
+#  if defined(EU_SIMD_AVX2) || defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define EU_SIMD_SSE2 1
+#  endif
+#  if defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))
+#    define EU_SIMD_FMA 1
+#  endif
+#endif
+
+#if defined(EU_SIMD_AVX2) || defined(EU_SIMD_FMA)
+#  include <immintrin.h>
+#elif defined(EU_SIMD_SSE2)
+#  include <emmintrin.h>
+#else
+#  include <cmath>
+#  include <cstring>
+#endif
+
+#define EU_ALIGN16 alignas(16)
+#define EU_ALIGN32 alignas(32)
+
+/**
+ * EU_IS_CONSTANT_EVALUATED() is true while the compiler evaluates a constexpr
+ * function, letting the math types fall back to plain scalar code there
+ * (intrinsics cannot be constant-evaluated) while keeping the SIMD path at
+ * run time. EU_HAS_CONSTEXPR_SIMD is 0 on compilers without the builtin; in
+ * that case only the scalar-only types are usable in constant expressions.
+ */
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 9) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1925)
+#  define EU_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#  define EU_HAS_CONSTEXPR_SIMD 1
+#else
+#  define EU_IS_CONSTANT_EVALUATED() false
+#  define EU_HAS_CONSTEXPR_SIMD 0
+#endif
+
+namespace EU {
+namespace SIMD {
+
+  /**
+   * @brief Returns the name of the backend selected at compile time.
+   */
+  inline const char*
+  backendName() {
+#if defined(EU_SIMD_AVX2)
+    return "AVX2";
+#elif defined(EU_SIMD_SSE2)
+    return "SSE2";
+#else
+    return "Scalar";
+#endif
+  }
+
+  //--------------------------------------------------------------------------
+  // Float4: four packed floats.
+  //--------------------------------------------------------------------------
+#if defined(EU_SIMD_SSE2)
+  using Float4 = __m128;
+
+  inline Float4 load4(const float* p) { return _mm_loadu_ps(p); }
+  inline Float4 loadAligned4(const float* p) { return _mm_load_ps(p); }
+  inline Float4 set4(float x, float y, float z, float w) { return _mm_setr_ps(x, y, z, w); }
+  inline Float4 splat4(float value) { return _mm_set1_ps(value); }
+  inline Float4 zero4() { return _mm_setzero_ps(); }
+
+  inline void store(float* p, Float4 a) { _mm_storeu_ps(p, a); }
+  inline void storeAligned(float* p, Float4 a) { _mm_store_ps(p, a); }
+
+  inline Float4 add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+  inline Float4 sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+  inline Float4 mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+  inline Float4 div(Float4 a, Float4 b) { return _mm_div_ps(a, b); }
+  inline Float4 EMin(Float4 a, Float4 b) { return _mm_min_ps(a, b); }
+  inline Float4 EMax(Float4 a, Float4 b) { return _mm_max_ps(a, b); }
+  inline Float4 sqrt(Float4 a) { return _mm_sqrt_ps(a); }
+
+  /**
+   * @brief Returns a * b + c.
+   */
+  inline Float4
+  madd(Float4 a, Float4 b, Float4 c) {
+#if defined(EU_SIMD_FMA)
+    return _mm_fmadd_ps(a, b, c);
+#else
+    return _mm_add_ps(_mm_mul_ps(a, b), c);
+#endif
+  }
+
+  /**
+   * @brief Returns c - a * b.
+   */
+  inline Float4
+  nmadd(Float4 a, Float4 b, Float4 c) {
+#if defined(EU_SIMD_FMA)
+    return _mm_fnmadd_ps(a, b, c);
+#else
+    return _mm_sub_ps(c, _mm_mul_ps(a, b));
+#endif
+  }
+
+  inline float getX(Float4 a) { return _mm_cvtss_f32(a); }
+
+  /**
+   * @brief Horizontal sum of the four lanes.
+   */
+  inline float
+  hsum(Float4 a) {
+    Float4 shuf = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+    Float4 sums = _mm_add_ps(a, shuf);
+    shuf = _mm_movehl_ps(shuf, sums);
+    return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+  }
+
+  /**
+   * @brief Transposes the 4x4 matrix held in four row registers.
+   */
+  inline void
+  transpose4(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  }
+
+  /**
+   * @brief Returns (a[X], a[Y], b[Z], b[W]).
+   */
+  template<int X, int Y, int Z, int W>
+  inline Float4
+  shuffle(Float4 a, Float4 b) {
+    return _mm_shuffle_ps(a, b, _MM_SHUFFLE(W, Z, Y, X));
+  }
+#else
+  struct EU_ALIGN16 Float4 {
+    float v[4];
+  };
+
+  inline Float4 load4(const float* p) { return { { p[0], p[1], p[2], p[3] } }; }
+  inline Float4 loadAligned4(const float* p) { return load4(p); }
+  inline Float4 set4(float x, float y, float z, float w) { return { { x, y, z, w } }; }
+  inline Float4 splat4(float value) { return { { value, value, value, value } }; }
+  inline Float4 zero4() { return splat4(0.0f); }
+
+  inline void
+  store(float* p, Float4 a) {
+    p[0] = a.v[0]; p[1] = a.v[1]; p[2] = a.v[2]; p[3] = a.v[3];
+  }
+  inline void storeAligned(float* p, Float4 a) { store(p, a); }
+
+#define EU_SIMD_SCALAR_OP4(name, expr)                                \
+  inline Float4 name(Float4 a, Float4 b) {                            \
+    Float4 r;                                                         \
+    for (int i = 0; i < 4; ++i) { float x = a.v[i], y = b.v[i]; r.v[i] = (expr); } \
+    return r;                                                         \
+  }
+  EU_SIMD_SCALAR_OP4(add, x + y)
+  EU_SIMD_SCALAR_OP4(sub, x - y)
+  EU_SIMD_SCALAR_OP4(mul, x * y)
+  EU_SIMD_SCALAR_OP4(div, x / y)
+  EU_SIMD_SCALAR_OP4(EMin, x < y ? x : y)
+  EU_SIMD_SCALAR_OP4(EMax, x > y ? x : y)
+#undef EU_SIMD_SCALAR_OP4
+
+  inline Float4
+  sqrt(Float4 a) {
+    Float4 r;
+    for (int i = 0; i < 4; ++i) {
+      r.v[i] = std::sqrt(a.v[i]);
+    }
+    return r;
+  }
+
+  /**
+   * @brief Returns a * b + c.
+   */
+  inline Float4 madd(Float4 a, Float4 b, Float4 c) { return add(mul(a, b), c); }
+
+  /**
+   * @brief Returns c - a * b.
+   */
+  inline Float4 nmadd(Float4 a, Float4 b, Float4 c) { return sub(c, mul(a, b)); }
+
+  inline float getX(Float4 a) { return a.v[0]; }
+
+  /**
+   * @brief Horizontal sum of the four lanes.
+   */
+  inline float hsum(Float4 a) { return (a.v[0] + a.v[1]) + (a.v[2] + a.v[3]); }
+
+  /**
+   * @brief Transposes the 4x4 matrix held in four row registers.
+   */
+  inline void
+  transpose4(Float4& r0, Float4& r1, Float4& r2, Float4& r3) {
+    Float4 rows[4] = { r0, r1, r2, r3 };
+    r0 = set4(rows[0].v[0], rows[1].v[0], rows[2].v[0], rows[3].v[0]);
+    r1 = set4(rows[0].v[1], rows[1].v[1], rows[2].v[1], rows[3].v[1]);
+    r2 = set4(rows[0].v[2], rows[1].v[2], rows[2].v[2], rows[3].v[2]);
+    r3 = set4(rows[0].v[3], rows[1].v[3], rows[2].v[3], rows[3].v[3]);
+  }
+
+  /**
+   * @brief Returns (a[X], a[Y], b[Z], b[W]).
+   */
+  template<int X, int Y, int Z, int W>
+  inline Float4
+  shuffle(Float4 a, Float4 b) {
+    return set4(a.v[X], a.v[Y], b.v[Z], b.v[W]);
+  }
+#endif
+
+  /**
+   * @brief Four-lane dot product.
+   */
+  inline float dot4(Float4 a, Float4 b) { return hsum(mul(a, b)); }
+
+  /**
+   * @brief Broadcasts lane I of a to all four lanes.
+   */
+  template<int I>
+  inline Float4 splatLane(Float4 a) { return shuffle<I, I, I, I>(a, a); }
+
+  //--------------------------------------------------------------------------
+  // Float8: eight packed floats. Native on AVX2, two Float4 halves otherwise.
+  //--------------------------------------------------------------------------
+#if defined(EU_SIMD_AVX2)
+  using Float8 = __m256;
+
+  inline Float8 load8(const float* p) { return _mm256_loadu_ps(p); }
+  inline Float8 loadAligned8(const float* p) { return _mm256_load_ps(p); }
+  inline Float8 splat8(float value) { return _mm256_set1_ps(value); }
+  inline Float8 zero8() { return _mm256_setzero_ps(); }
+
+  inline void store(float* p, Float8 a) { _mm256_storeu_ps(p, a); }
+  inline void storeAligned(float* p, Float8 a) { _mm256_store_ps(p, a); }
+
+  inline Float8 add(Float8 a, Float8 b) { return _mm256_add_ps(a, b); }
+  inline Float8 sub(Float8 a, Float8 b) { return _mm256_sub_ps(a, b); }
+  inline Float8 mul(Float8 a, Float8 b) { return _mm256_mul_ps(a, b); }
+  inline Float8 div(Float8 a, Float8 b) { return _mm256_div_ps(a, b); }
+  inline Float8 EMin(Float8 a, Float8 b) { return _mm256_min_ps(a, b); }
+  inline Float8 EMax(Float8 a, Float8 b) { return _mm256_max_ps(a, b); }
+  inline Float8 sqrt(Float8 a) { return _mm256_sqrt_ps(a); }
+
+  inline Float8
+  madd(Float8 a, Float8 b, Float8 c) {
+#if defined(EU_SIMD_FMA)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+  }
+
+  inline Float8
+  nmadd(Float8 a, Float8 b, Float8 c) {
+#if defined(EU_SIMD_FMA)
+    return _mm256_fnmadd_ps(a, b, c);
+#else
+    return _mm256_sub_ps(c, _mm256_mul_ps(a, b));
+#endif
+  }
+#else
+  struct Float8 {
+    Float4 lo;
+    Float4 hi;
+  };
+
+  inline Float8 load8(const float* p) { return { load4(p), load4(p + 4) }; }
+  inline Float8 loadAligned8(const float* p) { return { loadAligned4(p), loadAligned4(p + 4) }; }
+  inline Float8 splat8(float value) { return { splat4(value), splat4(value) }; }
+  inline Float8 zero8() { return { zero4(), zero4() }; }
+
+  inline void store(float* p, Float8 a) { store(p, a.lo); store(p + 4, a.hi); }
+  inline void storeAligned(float* p, Float8 a) { storeAligned(p, a.lo); storeAligned(p + 4, a.hi); }
+
+  inline Float8 add(Float8 a, Float8 b) { return { add(a.lo, b.lo), add(a.hi, b.hi) }; }
+  inline Float8 sub(Float8 a, Float8 b) { return { sub(a.lo, b.lo), sub(a.hi, b.hi) }; }
+  inline Float8 mul(Float8 a, Float8 b) { return { mul(a.lo, b.lo), mul(a.hi, b.hi) }; }
+  inline Float8 div(Float8 a, Float8 b) { return { div(a.lo, b.lo), div(a.hi, b.hi) }; }
+  inline Float8 EMin(Float8 a, Float8 b) { return { EMin(a.lo, b.lo), EMin(a.hi, b.hi) }; }
+  inline Float8 EMax(Float8 a, Float8 b) { return { EMax(a.lo, b.lo), EMax(a.hi, b.hi) }; }
+  inline Float8 sqrt(Float8 a) { return { sqrt(a.lo), sqrt(a.hi) }; }
+  inline Float8 madd(Float8 a, Float8 b, Float8 c) { return { madd(a.lo, b.lo, c.lo), madd(a.hi, b.hi, c.hi) }; }
+  inline Float8 nmadd(Float8 a, Float8 b, Float8 c) { return { nmadd(a.lo, b.lo, c.lo), nmadd(a.hi, b.hi, c.hi) }; }
+#endif
+
+  //--------------------------------------------------------------------------
+  // Integer lanes, comparisons and bitwise helpers. These are what the
+  // range-reduction kernels in EngineMathSIMD.h are written against.
+  // Comparisons return all-ones / all-zeros lane masks.
+  //--------------------------------------------------------------------------
+#if defined(EU_SIMD_SSE2)
+  using Int4 = __m128i;
+
+  inline Int4 splatInt4(int value) { return _mm_set1_epi32(value); }
+  inline Int4 toIntRound(Float4 a) { return _mm_cvtps_epi32(a); }
+  inline Float4 toFloat(Int4 a) { return _mm_cvtepi32_ps(a); }
+  inline Int4 asInt(Float4 a) { return _mm_castps_si128(a); }
+  inline Float4 asFloat(Int4 a) { return _mm_castsi128_ps(a); }
+
+  inline Int4 addi(Int4 a, Int4 b) { return _mm_add_epi32(a, b); }
+  inline Int4 subi(Int4 a, Int4 b) { return _mm_sub_epi32(a, b); }
+  inline Int4 andi(Int4 a, Int4 b) { return _mm_and_si128(a, b); }
+  inline Int4 cmpEqi(Int4 a, Int4 b) { return _mm_cmpeq_epi32(a, b); }
+  template<int N> inline Int4 shiftLeft(Int4 a) { return _mm_slli_epi32(a, N); }
+  template<int N> inline Int4 shiftRight(Int4 a) { return _mm_srai_epi32(a, N); }
+
+  inline Float4 cmpLt(Float4 a, Float4 b) { return _mm_cmplt_ps(a, b); }
+  inline Float4 bitAnd(Float4 a, Float4 b) { return _mm_and_ps(a, b); }
+  inline Float4 bitXor(Float4 a, Float4 b) { return _mm_xor_ps(a, b); }
+  inline Float4 select(Float4 mask, Float4 a, Float4 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+  }
+#else
+  struct EU_ALIGN16 Int4 {
+    int v[4];
+  };
+
+  inline Int4 splatInt4(int value) { return { { value, value, value, value } }; }
+
+  inline Int4
+  toIntRound(Float4 a) {
+    Int4 r;
+    for (int i = 0; i < 4; ++i) {
+      r.v[i] = static_cast<int>(a.v[i] >= 0.0f ? a.v[i] + 0.5f : a.v[i] - 0.5f);
+    }
+    return r;
+  }
+
+  inline Float4
+  toFloat(Int4 a) {
+    return set4(static_cast<float>(a.v[0]), static_cast<float>(a.v[1]),
+                static_cast<float>(a.v[2]), static_cast<float>(a.v[3]));
+  }
+
+  inline Int4 asInt(Float4 a) { Int4 r; std::memcpy(r.v, a.v, sizeof(r.v)); return r; }
+  inline Float4 asFloat(Int4 a) { Float4 r; std::memcpy(r.v, a.v, sizeof(r.v)); return r; }
+
+#define EU_SIMD_SCALAR_INT_OP4(name, expr)                            \
+  inline Int4 name(Int4 a, Int4 b) {                                  \
+    Int4 r;                                                           \
+    for (int i = 0; i < 4; ++i) { int x = a.v[i], y = b.v[i]; r.v[i] = (expr); } \
+    return r;                                                         \
+  }
+  EU_SIMD_SCALAR_INT_OP4(addi, static_cast<int>(static_cast<unsigned>(x) + static_cast<unsigned>(y)))
+  EU_SIMD_SCALAR_INT_OP4(subi, static_cast<int>(static_cast<unsigned>(x) - static_cast<unsigned>(y)))
+  EU_SIMD_SCALAR_INT_OP4(andi, x & y)
+  EU_SIMD_SCALAR_INT_OP4(cmpEqi, x == y ? -1 : 0)
+#undef EU_SIMD_SCALAR_INT_OP4
+
+  template<int N> inline Int4
+  shiftLeft(Int4 a) {
+    Int4 r;
+    for (int i = 0; i < 4; ++i) {
+      r.v[i] = static_cast<int>(static_cast<unsigned>(a.v[i]) << N);
+    }
+    return r;
+  }
+
+  template<int N> inline Int4
+  shiftRight(Int4 a) {
+    Int4 r;
+    for (int i = 0; i < 4; ++i) {
+      r.v[i] = a.v[i] >> N;
+    }
+    return r;
+  }
+
+  inline Float4
+  cmpLt(Float4 a, Float4 b) {
+    Int4 r;
+    for (int i = 0; i < 4; ++i) {
+      r.v[i] = a.v[i] < b.v[i] ? -1 : 0;
+    }
+    return asFloat(r);
+  }
+
+  inline Float4 bitAnd(Float4 a, Float4 b) { return asFloat(andi(asInt(a), asInt(b))); }
+
+  inline Float4
+  bitXor(Float4 a, Float4 b) {
+    Int4 x = asInt(a), y = asInt(b);
+    for (int i = 0; i < 4; ++i) {
+      x.v[i] ^= y.v[i];
+    }
+    return asFloat(x);
+  }
+
+  inline Float4
+  select(Float4 mask, Float4 a, Float4 b) {
+    Int4 m = asInt(mask), x = asInt(a), y = asInt(b);
+    for (int i = 0; i < 4; ++i) {
+      x.v[i] = (m.v[i] & x.v[i]) | (~m.v[i] & y.v[i]);
+    }
+    return asFloat(x);
+  }
+#endif
+
+#if defined(EU_SIMD_AVX2)
+  using Int8 = __m256i;
+
+  inline Int8 splatInt8(int value) { return _mm256_set1_epi32(value); }
+  inline Int8 toIntRound(Float8 a) { return _mm256_cvtps_epi32(a); }
+  inline Float8 toFloat(Int8 a) { return _mm256_cvtepi32_ps(a); }
+  inline Int8 asInt(Float8 a) { return _mm256_castps_si256(a); }
+  inline Float8 asFloat(Int8 a) { return _mm256_castsi256_ps(a); }
+
+  inline Int8 addi(Int8 a, Int8 b) { return _mm256_add_epi32(a, b); }
+  inline Int8 subi(Int8 a, Int8 b) { return _mm256_sub_epi32(a, b); }
+  inline Int8 andi(Int8 a, Int8 b) { return _mm256_and_si256(a, b); }
+  inline Int8 cmpEqi(Int8 a, Int8 b) { return _mm256_cmpeq_epi32(a, b); }
+  template<int N> inline Int8 shiftLeft(Int8 a) { return _mm256_slli_epi32(a, N); }
+  template<int N> inline Int8 shiftRight(Int8 a) { return _mm256_srai_epi32(a, N); }
+
+  inline Float8 cmpLt(Float8 a, Float8 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+  inline Float8 bitAnd(Float8 a, Float8 b) { return _mm256_and_ps(a, b); }
+  inline Float8 bitXor(Float8 a, Float8 b) { return _mm256_xor_ps(a, b); }
+  inline Float8 select(Float8 mask, Float8 a, Float8 b) { return _mm256_blendv_ps(b, a, mask); }
+#else
+  struct Int8 {
+    Int4 lo;
+    Int4 hi;
+  };
+
+  inline Int8 splatInt8(int value) { return { splatInt4(value), splatInt4(value) }; }
+  inline Int8 toIntRound(Float8 a) { return { toIntRound(a.lo), toIntRound(a.hi) }; }
+  inline Float8 toFloat(Int8 a) { return { toFloat(a.lo), toFloat(a.hi) }; }
+  inline Int8 asInt(Float8 a) { return { asInt(a.lo), asInt(a.hi) }; }
+  inline Float8 asFloat(Int8 a) { return { asFloat(a.lo), asFloat(a.hi) }; }
+
+  inline Int8 addi(Int8 a, Int8 b) { return { addi(a.lo, b.lo), addi(a.hi, b.hi) }; }
+  inline Int8 subi(Int8 a, Int8 b) { return { subi(a.lo, b.lo), subi(a.hi, b.hi) }; }
+  inline Int8 andi(Int8 a, Int8 b) { return { andi(a.lo, b.lo), andi(a.hi, b.hi) }; }
+  inline Int8 cmpEqi(Int8 a, Int8 b) { return { cmpEqi(a.lo, b.lo), cmpEqi(a.hi, b.hi) }; }
+  template<int N> inline Int8 shiftLeft(Int8 a) { return { shiftLeft<N>(a.lo), shiftLeft<N>(a.hi) }; }
+  template<int N> inline Int8 shiftRight(Int8 a) { return { shiftRight<N>(a.lo), shiftRight<N>(a.hi) }; }
+
+  inline Float8 cmpLt(Float8 a, Float8 b) { return { cmpLt(a.lo, b.lo), cmpLt(a.hi, b.hi) }; }
+  inline Float8 bitAnd(Float8 a, Float8 b) { return { bitAnd(a.lo, b.lo), bitAnd(a.hi, b.hi) }; }
+  inline Float8 bitXor(Float8 a, Float8 b) { return { bitXor(a.lo, b.lo), bitXor(a.hi, b.hi) }; }
+  inline Float8 select(Float8 mask, Float8 a, Float8 b) {
+    return { select(mask.lo, a.lo, b.lo), select(mask.hi, a.hi, b.hi) };
+  }
+#endif
+
+  /**
+   * @brief Width-generic splats: return a register of the same width as the
+   * first argument, so kernels can be written once for Float4 and Float8.
+   */
+  inline Float4 splatLike(Float4, float value) { return splat4(value); }
+  inline Float8 splatLike(Float8, float value) { return splat8(value); }
+  inline Int4 splatIntLike(Float4, int value) { return splatInt4(value); }
+  inline Int8 splatIntLike(Float8, int value) { return splatInt8(value); }
+
+}
+}
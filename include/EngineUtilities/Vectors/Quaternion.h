@@ -28,8 +28,8 @@
 */
 #pragma once
 
-#include "Utilities/EngineMath.h"
-#include "Vector3.h"
+#include "EngineUtilities/Utilities/EngineMath.h"
+#include "EngineUtilities/Vectors/Vector3.h"
 namespace EU {
 	/**
  * @brief A quaternion class.
@@ -49,7 +49,7 @@ namespace EU {
 		 *
 		 * Initializes the quaternion to (1, 0, 0, 0).
 		 */
-		Quaternion() : w(1), x(0), y(0), z(0) {}
+		constexpr Quaternion() : w(1), x(0), y(0), z(0) {}
 
 		/**
 		 * @brief Parameterized constructor.
@@ -61,7 +61,7 @@ namespace EU {
 		 * @param y The j component.
 		 * @param z The k component.
 		 */
-		Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
+		constexpr Quaternion(float w, float x, float y, float z) : w(w), x(x), y(y), z(z) {}
 
 		/**
 		 * @brief Adds another quaternion to this quaternion.
@@ -69,7 +69,7 @@ namespace EU {
 		 * @param other The quaternion to add.
 		 * @return The result of the addition.
 		 */
-		Quaternion operator+(const Quaternion& other) const {
+		constexpr Quaternion operator+(const Quaternion& other) const {
 			return Quaternion(w + other.w, x + other.x, y + other.y, z + other.z);
 		}
 
@@ -79,7 +79,7 @@ namespace EU {
 		 * @param other The quaternion to subtract.
 		 * @return The result of the subtraction.
 		 */
-		Quaternion operator-(const Quaternion& other) const {
+		constexpr Quaternion operator-(const Quaternion& other) const {
 			return Quaternion(w - other.w, x - other.x, y - other.y, z - other.z);
 		}
 
@@ -89,7 +89,7 @@ namespace EU {
 		 * @param scalar The scalar to multiply by.
 		 * @return The result of the multiplication.
 		 */
-		Quaternion operator*(float scalar) const {
+		constexpr Quaternion operator*(float scalar) const {
 			return Quaternion(w * scalar, x * scalar, y * scalar, z * scalar);
 		}
 
@@ -99,7 +99,7 @@ namespace EU {
 		 * @param other The quaternion to multiply by.
 		 * @return The result of the multiplication.
 		 */
-		Quaternion operator*(const Quaternion& other) const {
+		constexpr Quaternion operator*(const Quaternion& other) const {
 			return Quaternion(
 				w * other.w - x * other.x - y * other.y - z * other.z,
 				w * other.x + x * other.w + y * other.z - z * other.y,
@@ -114,7 +114,7 @@ namespace EU {
 		 * @param other The quaternion to compare with.
 		 * @return True if the quaternions are equal, false otherwise.
 		 */
-		bool operator==(const Quaternion& other) const {
+		constexpr bool operator==(const Quaternion& other) const {
 			return (w == other.w && x == other.x && y == other.y && z == other.z);
 		}
 
@@ -124,7 +124,7 @@ namespace EU {
 		 * @param other The quaternion to compare with.
 		 * @return True if the quaternions are not equal, false otherwise.
 		 */
-		bool operator!=(const Quaternion& other) const {
+		constexpr bool operator!=(const Quaternion& other) const {
 			return !(*this == other);
 		}
 
@@ -133,7 +133,7 @@ namespace EU {
 		 *
 		 * @return The magnitude of the quaternion.
 		 */
-		float magnitude() const {
+		constexpr float magnitude() const {
 			return EU::sqrt(w * w + x * x + y * y + z * z);
 		}
 
@@ -142,7 +142,7 @@ namespace EU {
 		 *
 		 * @return The normalized quaternion.
 		 */
-		Quaternion normalize() const {
+		constexpr Quaternion normalize() const {
 			float mag = magnitude();
 			if (mag == 0) {
 				return Quaternion(1, 0, 0, 0);
@@ -155,7 +155,7 @@ namespace EU {
 		 *
 		 * @return The conjugated quaternion.
 		 */
-		Quaternion conjugate() const {
+		constexpr Quaternion conjugate() const {
 			return Quaternion(w, -x, -y, -z);
 		}
 
@@ -164,7 +164,7 @@ namespace EU {
 		 *
 		 * @return The inverted quaternion.
 		 */
-		Quaternion inverse() const {
+		constexpr Quaternion inverse() const {
 			float magSquared = w * w + x * x + y * y + z * z;
 			if (magSquared == 0) {
 				// Handling division by zero
@@ -179,7 +179,7 @@ namespace EU {
 		 * @param v The vector to rotate.
 		 * @return The rotated vector.
 		 */
-		Vector3 rotate(const Vector3& v) const {
+		constexpr Vector3 rotate(const Vector3& v) const {
 			Quaternion qv(0, v.x, v.y, v.z);
 			Quaternion result = (*this) * qv * this->inverse();
 			return Vector3(result.x, result.y, result.z);
@@ -203,6 +203,136 @@ namespace EU {
 			);
 		}
 
+		/**
+		 * @brief Returns the 4D dot product with another quaternion.
+		 *
+		 * @param other The other quaternion.
+		 * @return w*w' + x*x' + y*y' + z*z'.
+		 */
+		constexpr float dot(const Quaternion& other) const {
+			return w * other.w + x * other.x + y * other.y + z * other.z;
+		}
+
+		/**
+		 * @brief Converts the quaternion to an axis and an angle (in radians).
+		 *
+		 * @param axis Receives the normalized axis; (1, 0, 0) for the identity.
+		 * @param angle Receives the angle in [0, 2*PI].
+		 */
+		void toAxisAngle(Vector3& axis, float& angle) const {
+			Quaternion q = normalize();
+			float sinHalfSq = 1.0f - q.w * q.w;
+			angle = 2.0f * EU::acos(EU::EMin(EU::EMax(q.w, -1.0f), 1.0f));
+			if (sinHalfSq < 1.0e-12f) {
+				axis = Vector3(1.0f, 0.0f, 0.0f);
+				return;
+			}
+			float invSinHalf = EU::rsqrt(sinHalfSq);
+			axis = Vector3(q.x * invSinHalf, q.y * invSinHalf, q.z * invSinHalf);
+		}
+
+		/**
+		 * @brief Constructs a quaternion from Euler angles (in radians).
+		 *
+		 * Same convention as XMMatrixRotationRollPitchYaw: roll about Z is
+		 * applied first, then pitch about X, then yaw about Y.
+		 *
+		 * @param pitch Rotation about the X axis.
+		 * @param yaw Rotation about the Y axis.
+		 * @param roll Rotation about the Z axis.
+		 * @return The quaternion representing the rotation.
+		 */
+		static Quaternion fromEuler(float pitch, float yaw, float roll) {
+			float sp, cp, sy, cy, sr, cr;
+			EU::sincos(pitch * 0.5f, sp, cp);
+			EU::sincos(yaw * 0.5f, sy, cy);
+			EU::sincos(roll * 0.5f, sr, cr);
+			return Quaternion(
+				cy * cp * cr + sy * sp * sr,
+				cy * sp * cr + sy * cp * sr,
+				sy * cp * cr - cy * sp * sr,
+				cy * cp * sr - sy * sp * cr
+			);
+		}
+
+		/**
+		 * @brief Constructs a quaternion from Euler angles stored as (pitch, yaw, roll).
+		 *
+		 * @param euler The angles in radians.
+		 * @return The quaternion representing the rotation.
+		 */
+		static Quaternion fromEuler(const Vector3& euler) {
+			return fromEuler(euler.x, euler.y, euler.z);
+		}
+
+		/**
+		 * @brief Converts the quaternion to Euler angles, inverse of fromEuler().
+		 *
+		 * At gimbal lock (pitch = +-PI/2) the roll is reported as zero.
+		 *
+		 * @return (pitch, yaw, roll) in radians.
+		 */
+		Vector3 toEuler() const {
+			Quaternion q = normalize();
+			// Elements of the rotation matrix (row-vector form) that are needed.
+			float m20 = 2.0f * (q.x * q.z + q.w * q.y);
+			float m21 = 2.0f * (q.y * q.z - q.w * q.x);
+			float m22 = 1.0f - 2.0f * (q.x * q.x + q.y * q.y);
+			float cosPitch = EU::sqrt(m20 * m20 + m22 * m22);
+			// atan2 instead of asin(-m21): asin loses precision as |m21| approaches 1.
+			float pitch = EU::atan2(-m21, cosPitch);
+			if (cosPitch < 1.0e-5f) {
+				float m00 = 1.0f - 2.0f * (q.y * q.y + q.z * q.z);
+				float m02 = 2.0f * (q.x * q.z - q.w * q.y);
+				return Vector3(pitch, EU::atan2(-m02, m00), 0.0f);
+			}
+			float m01 = 2.0f * (q.x * q.y + q.w * q.z);
+			float m11 = 1.0f - 2.0f * (q.x * q.x + q.z * q.z);
+			return Vector3(pitch, EU::atan2(m20, m22), EU::atan2(m01, m11));
+		}
+
+		/**
+		 * @brief Normalized linear interpolation along the shortest path.
+		 *
+		 * Cheaper than slerp() but the angular speed is not constant.
+		 *
+		 * @param a The start rotation (t = 0).
+		 * @param b The end rotation (t = 1).
+		 * @param t The interpolation factor.
+		 * @return The interpolated unit quaternion.
+		 */
+		static constexpr Quaternion nlerp(const Quaternion& a, const Quaternion& b, float t) {
+			float sign = a.dot(b) < 0.0f ? -1.0f : 1.0f;
+			return (a * (1.0f - t) + b * (t * sign)).normalize();
+		}
+
+		/**
+		 * @brief Spherical linear interpolation along the shortest path.
+		 *
+		 * Falls back to nlerp() when the rotations are nearly identical.
+		 *
+		 * @param a The start rotation (t = 0, must be normalized).
+		 * @param b The end rotation (t = 1, must be normalized).
+		 * @param t The interpolation factor.
+		 * @return The interpolated unit quaternion.
+		 */
+		static Quaternion slerp(const Quaternion& a, const Quaternion& b, float t) {
+			float cosTheta = a.dot(b);
+			float sign = 1.0f;
+			if (cosTheta < 0.0f) {
+				cosTheta = -cosTheta;
+				sign = -1.0f;
+			}
+			if (cosTheta > 0.9995f) {
+				return nlerp(a, b, t);
+			}
+			float theta = EU::acos(cosTheta);
+			float invSinTheta = 1.0f / EU::sin(theta);
+			float wa = EU::sin((1.0f - t) * theta) * invSinTheta;
+			float wb = EU::sin(t * theta) * invSinTheta * sign;
+			return a * wa + b * wb;
+		}
+
 		/**
 		 * @brief Returns a pointer to the quaternion's data.
 		 *
@@ -212,24 +342,6 @@ namespace EU {
 			return &w;
 		}
 
-		/**
-		 * @brief Converts the quaternion to a 4x4 rotation matrix.
-		 *
-		 * @return The 4x4 matrix representing the rotation.
-		 */
-		/*Matrix4x4 toMatrix() const {
-			Matrix4x4 result;
-			result[0][0] = 1 - 2 * (y * y + z * z);
-			result[0][1] = 2 * (x * y - z * w);
-			result[0][2] = 2 * (x * z + y * w);
-			result[1][0] = 2 * (x * y + z * w);
-			result[1][1] = 1 - 2 * (x * x + z * z);
-			result[1][2] = 2 * (y * z - x * w);
-			result[2][0] = 2 * (x * z - y * w);
-			result[2][1] = 2 * (y * z + x * w);
-			result[2][2] = 1 - 2 * (x * x + y * y);
-			result[3][3] = 1;
-			return result;
-		}*/
+		// Conversion to a rotation matrix: see Matrix4x4::rotation(const Quaternion&).
 	};
 }
\ No newline at end of file
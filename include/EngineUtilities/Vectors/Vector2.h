@@ -27,7 +27,7 @@
  * SOFTWARE.
 */
 #pragma once
-#include "Utilities/EngineMath.h"
+#include "EngineUtilities/Utilities/EngineMath.h"
 
 namespace EU {
   /**
@@ -48,7 +48,7 @@ namespace EU {
      *
      * Initializes the vector to (0, 0).
      */
-    Vector2() : x(0), y(0) {}
+    constexpr Vector2() : x(0), y(0) {}
 
     /**
      * @brief Parameterized constructor.
@@ -58,7 +58,7 @@ namespace EU {
      * @param x The x-coordinate.
      * @param y The y-coordinate.
      */
-    Vector2(float x, float y) : x(x), y(y) {}
+    constexpr Vector2(float x, float y) : x(x), y(y) {}
 
     /**
      * @brief Adds another vector to this vector.
@@ -66,7 +66,7 @@ namespace EU {
      * @param other The vector to add.
      * @return The result of the addition.
      */
-    Vector2 
+    constexpr Vector2 
     operator+(const Vector2& other) const {
       return Vector2(x + other.x, y + other.y);
     }
@@ -77,7 +77,7 @@ namespace EU {
      * @param other The vector to subtract.
      * @return The result of the subtraction.
      */
-    Vector2 
+    constexpr Vector2 
     operator-(const Vector2& other) const {
       return Vector2(x - other.x, y - other.y);
     }
@@ -88,7 +88,7 @@ namespace EU {
      * @param scalar The scalar to multiply by.
      * @return The result of the multiplication.
      */
-    Vector2 
+    constexpr Vector2 
     operator*(float scalar) const {
       return Vector2(x * scalar, y * scalar);
     }
@@ -98,7 +98,7 @@ namespace EU {
      *
      * @return The magnitude of the vector.
      */
-    float 
+    constexpr float 
     magnitude() const {
       return EU::sqrt(x * x + y * y);
     }
@@ -108,7 +108,7 @@ namespace EU {
      *
      * @return The normalized vector.
      */
-    Vector2 
+    constexpr Vector2 
     normalize() const {
       float mag = magnitude();
       if (mag == 0) {
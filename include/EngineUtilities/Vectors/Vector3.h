@@ -48,7 +48,7 @@ namespace EU {
 		 *
 		 * Initializes the vector to (0, 0, 0).
 		 */
-		Vector3() : x(0), y(0), z(0) {}
+		constexpr Vector3() : x(0), y(0), z(0) {}
 
 		/**
 		 * @brief Parameterized constructor.
@@ -59,7 +59,7 @@ namespace EU {
 		 * @param y The y-coordinate.
 		 * @param z The z-coordinate.
 		 */
-		Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
+		constexpr Vector3(float x, float y, float z) : x(x), y(y), z(z) {}
 
 		/**
 		 * @brief Adds another vector to this vector.
@@ -67,7 +67,7 @@ namespace EU {
 		 * @param other The vector to add.
 		 * @return The result of the addition.
 		 */
-		Vector3 operator+(const Vector3& other) const {
+		constexpr Vector3 operator+(const Vector3& other) const {
 			return Vector3(x + other.x, y + other.y, z + other.z);
 		}
 
@@ -77,7 +77,7 @@ namespace EU {
 		 * @param other The vector to subtract.
 		 * @return The result of the subtraction.
 		 */
-		Vector3 operator-(const Vector3& other) const {
+		constexpr Vector3 operator-(const Vector3& other) const {
 			return Vector3(x - other.x, y - other.y, z - other.z);
 		}
 
@@ -87,7 +87,7 @@ namespace EU {
 		 * @param scalar The scalar to multiply by.
 		 * @return The result of the multiplication.
 		 */
-		Vector3 operator*(float scalar) const {
+		constexpr Vector3 operator*(float scalar) const {
 			return Vector3(x * scalar, y * scalar, z * scalar);
 		}
 
@@ -96,7 +96,7 @@ namespace EU {
 		 *
 		 * @return The magnitude of the vector.
 		 */
-		float magnitude() const {
+		constexpr float magnitude() const {
 			return EU::sqrt(x * x + y * y + z * z);
 		}
 
@@ -105,7 +105,7 @@ namespace EU {
 		 *
 		 * @return The normalized vector.
 		 */
-		Vector3 normalize() const {
+		constexpr Vector3 normalize() const {
 			float mag = magnitude();
 			if (mag == 0) {
 				return Vector3(0, 0, 0);
@@ -113,14 +113,36 @@ namespace EU {
 			return Vector3(x / mag, y / mag, z / mag);
 		}
 
+		/**
+		 * @brief Calculates the dot product with another vector.
+		 *
+		 * @param other The other vector.
+		 * @return The dot product.
+		 */
+		constexpr float dot(const Vector3& other) const {
+			return x * other.x + y * other.y + z * other.z;
+		}
+
+		/**
+		 * @brief Calculates the cross product with another vector.
+		 *
+		 * @param other The other vector.
+		 * @return The cross product (this x other).
+		 */
+		constexpr Vector3 cross(const Vector3& other) const {
+			return Vector3(y * other.z - z * other.y,
+			               z * other.x - x * other.z,
+			               x * other.y - y * other.x);
+		}
+
 		void
     zero() {
-      Vector3(0, 0, 0);
+      *this = Vector3(0, 0, 0);
     }
     
     void
     one() {
-      Vector3(1,1,1);
+      *this = Vector3(1, 1, 1);
     }
 
 		// Método para obtener un puntero a los datos como un arreglo
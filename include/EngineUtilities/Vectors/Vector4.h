@@ -28,7 +28,8 @@
 */
 #pragma once
 
-#include "Utilities/EngineMath.h"
+#include "EngineUtilities/Utilities/EngineMath.h"
+#include "EngineUtilities/Utilities/SIMD.h"
 namespace EU {
   /**
  * @brief A 4D vector class.
@@ -36,8 +37,11 @@ namespace EU {
  * This class represents a vector in 4-dimensional space and provides
  * basic vector operations such as addition, subtraction, scalar multiplication,
  * and normalization.
+ *
+ * The storage is 16-byte aligned so the arithmetic maps onto a single
+ * SIMD::Float4 register.
  */
-  class Vector4 {
+  class EU_ALIGN16 Vector4 {
   public:
     float x; /**< The x-coordinate of the vector. */
     float y; /**< The y-coordinate of the vector. */
@@ -49,7 +53,7 @@ namespace EU {
      *
      * Initializes the vector to (0, 0, 0, 0).
      */
-    Vector4() : x(0), y(0), z(0), w(0) {}
+    constexpr Vector4() : x(0), y(0), z(0), w(0) {}
 
     /**
      * @brief Parameterized constructor.
@@ -61,7 +65,25 @@ namespace EU {
      * @param z The z-coordinate.
      * @param w The w-coordinate.
      */
-    Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+    constexpr Vector4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+    /**
+     * @brief Builds a vector from a SIMD register.
+     *
+     * @param v The packed (x, y, z, w) values.
+     */
+    explicit Vector4(SIMD::Float4 v) {
+      SIMD::storeAligned(&x, v);
+    }
+
+    /**
+     * @brief Loads the vector into a SIMD register.
+     *
+     * @return The packed (x, y, z, w) values.
+     */
+    SIMD::Float4 simd() const {
+      return SIMD::loadAligned4(&x);
+    }
 
     /**
      * @brief Adds another vector to this vector.
@@ -69,8 +91,11 @@ namespace EU {
      * @param other The vector to add.
      * @return The result of the addition.
      */
-    Vector4 operator+(const Vector4& other) const {
-      return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+    constexpr Vector4 operator+(const Vector4& other) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+      }
+      return Vector4(SIMD::add(simd(), other.simd()));
     }
 
     /**
@@ -79,8 +104,11 @@ namespace EU {
      * @param other The vector to subtract.
      * @return The result of the subtraction.
      */
-    Vector4 operator-(const Vector4& other) const {
-      return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+    constexpr Vector4 operator-(const Vector4& other) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+      }
+      return Vector4(SIMD::sub(simd(), other.simd()));
     }
 
     /**
@@ -89,8 +117,11 @@ namespace EU {
      * @param scalar The scalar to multiply by.
      * @return The result of the multiplication.
      */
-    Vector4 operator*(float scalar) const {
-      return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
+    constexpr Vector4 operator*(float scalar) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return Vector4(x * scalar, y * scalar, z * scalar, w * scalar);
+      }
+      return Vector4(SIMD::mul(simd(), SIMD::splat4(scalar)));
     }
 
     /**
@@ -98,8 +129,21 @@ namespace EU {
      *
      * @return The magnitude of the vector.
      */
-    float magnitude() const {
-      return EU::sqrt(x * x + y * y + z * z + w * w);
+    constexpr float magnitude() const {
+      return EU::sqrt(dot(*this));
+    }
+
+    /**
+     * @brief Calculates the dot product with another vector.
+     *
+     * @param other The other vector.
+     * @return The dot product.
+     */
+    constexpr float dot(const Vector4& other) const {
+      if (EU_IS_CONSTANT_EVALUATED()) {
+        return x * other.x + y * other.y + z * other.z + w * other.w;
+      }
+      return SIMD::dot4(simd(), other.simd());
     }
 
     /**
@@ -107,21 +151,20 @@ namespace EU {
      *
      * @return The normalized vector.
      */
-    Vector4 normalize() const {
+    constexpr Vector4 normalize() const {
       float mag = magnitude();
       if (mag == 0) {
         return Vector4(0, 0, 0, 0);
       }
-      return Vector4(x / mag, y / mag, z / mag, w / mag);
+      return *this * (1.0f / mag);
     }
 
     /**
-     * @brief Returns a pointer to the quaternion's data.
+     * @brief Returns a pointer to the vector's data.
      *
      * @return Pointer to the first element (x, y, z, w).
      */
-    const float* data() const {
-      return &x;
-    }
+    float* data() { return &x; }
+    const float* data() const { return &x; }
   };
 }
\ No newline at end of file
@@ -4,11 +4,27 @@
 
 class DeviceContext;
 
+/**
+ * @brief Nodo de la jerarquía de un modelo importado.
+ *
+ * El padre es un índice en el mismo arreglo de nodos (-1 si es raíz) y los
+ * padres siempre aparecen antes que sus hijos.
+ */
+struct ModelNode {
+    std::string name;
+    int parent;
+    EU::Vector3 position;
+    EU::Quaternion orientation;
+    EU::Vector3 scale;
+};
+
 class
-    MeshComponent : public Component {
+    MeshComponent final : public Component {
 public:
+    static constexpr ComponentType TYPE_ID = MESH;  ///< Id de tipo en compilación para el World.
+
     MeshComponent() :
-        m_numVertex(0), m_numIndex(0), Component(ComponentType::MESH) {
+        m_numVertex(0), m_numIndex(0), m_nodeIndex(-1), Component(ComponentType::MESH) {
     }
 
     virtual
@@ -45,4 +61,5 @@ public:
     std::vector<unsigned int> m_index;
     int m_numVertex;
     int m_numIndex;
+    int m_nodeIndex;  ///< Nodo del modelo al que pertenece la malla (-1 si ninguno).
 };
@@ -3,6 +3,18 @@
 #include "MeshComponent.h"
 #include "fbxsdk.h"
 
+/**
+ * @brief Borrador para TUniquePtr: los objetos del FBX SDK se liberan con
+ *        Destroy(), no con delete.
+ */
+struct FbxDestroyer {
+    template<typename T>
+    void
+    operator()(T* object) const {
+        object->Destroy();
+    }
+};
+
 class
     ModelLoader {
 public:
@@ -20,11 +32,16 @@ public:
     bool
     LoadFBXModel(const std::string& filePath);
 
+    /**
+     * @brief Registra el nodo (y recursivamente sus hijos) en nodes y procesa
+     *        sus mallas. parentIndex es el índice del padre en nodes (-1 si
+     *        es hijo de la raíz de la escena).
+     */
     void
-    ProcessFBXNode(FbxNode* node);
+    ProcessFBXNode(FbxNode* node, int parentIndex);
 
     void
-    ProcessFBXMesh(FbxNode* node);
+    ProcessFBXMesh(FbxNode* node, int nodeIndex);
 
     void
     ProcessFBXMaterials(FbxSurfaceMaterial* material);
@@ -33,11 +50,13 @@ public:
     GetTextureFileNames() const { return textureFileNames; }
 
 private:
-    FbxManager* lSdkManager;
-    FbxScene* lScene;
+    // Al destruir el manager se libera también la escena y los ajustes de IO.
+    EU::TUniquePtr<FbxManager, FbxDestroyer> lSdkManager;
+    FbxScene* lScene = nullptr;
     std::vector<std::string> textureFileNames;
 
 public:
     std::string modelName;
     std::vector<MeshComponent> meshes;
+    std::vector<ModelNode> nodes;  ///< Jerarquía del FBX, en orden de profundidad.
 };
@@ -19,6 +19,13 @@
 #include "EngineUtilities\Memory\TWeakPointer.h"
 #include "EngineUtilities\Memory\TStaticPtr.h"
 #include "EngineUtilities\Memory\TUniquePtr.h"
+#include "EngineUtilities\Memory\TRefPtr.h"
+#include "EngineUtilities\Memory\LinearArena.h"
+#include "EngineUtilities\Memory\TPoolAllocator.h"
+#include "EngineUtilities\Memory\MemoryTracker.h"
+#include "EngineUtilities\Matrix\Matrix4x4.h"
+#include "EngineUtilities\Structures\TMap.h"
+#include "EngineUtilities\Structures\TSlotMap.h"
 
 // MACROS
 #define SAFE_RELEASE(x) if(x != nullptr) x->Release(); x = nullptr;
@@ -42,6 +49,19 @@
     }                                                         \
 }
 
+// Conversiones entre EU::Matrix4x4 y XMMATRIX (ambas row-major, vectores fila)
+inline XMMATRIX
+toXMMATRIX(const EU::Matrix4x4& m) {
+  return XMLoadFloat4x4(reinterpret_cast<const XMFLOAT4X4*>(m.data()));
+}
+
+inline EU::Matrix4x4
+toMatrix4x4(CXMMATRIX m) {
+  EU::Matrix4x4 result;
+  XMStoreFloat4x4(reinterpret_cast<XMFLOAT4X4*>(result.data()), m);
+  return result;
+}
+
 // Structures
 struct
     SimpleVertex {
@@ -83,5 +103,6 @@ enum
     NONE = 0, ///< Tipo de componente no especificado.
     TRANSFORM = 1, ///< Componente de transformación.
     MESH = 2, ///< Componente de malla.
-    MATERIAL = 3 ///< Componente de material.
+    MATERIAL = 3, ///< Componente de material.
+    DISABLED = 4 ///< Etiqueta de entidad desactivada.
 };
@@ -11,7 +11,7 @@ public:
     ~Rasterizer() = default;
 
     HRESULT
-    init(Device device);
+    init(Device& device);
 
     void
     update();
@@ -11,12 +11,12 @@ public:
     ~Texture() = default;
 
     HRESULT
-    init(Device device,
+    init(Device& device,
          const std::string& textureName,
          ExtensionType extensionType);
 
     HRESULT
-    init(Device device,
+    init(Device& device,
          unsigned int width,
          unsigned int height,
          DXGI_FORMAT Format,
@@ -39,8 +39,9 @@ public:
 public:
     // This variable is in charge of handle a texture resource as data
     ID3D11Texture2D* m_texture = nullptr;
-    // This variable is in charge of handle a texture resource as image data
-    ID3D11ShaderResourceView* m_textureFromImg;
+    // This variable is in charge of handle a texture resource as image data.
+    // Copias de Texture comparten la vista con AddRef/Release (sin doble liberación).
+    EU::TRefPtr<ID3D11ShaderResourceView> m_textureFromImg;
 
     std::string m_textureName;
 };
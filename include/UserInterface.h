@@ -14,6 +14,9 @@ class Actor;
 class ModelComponent;
 class Transform;
 
+// Actores de la escena referenciados por handle estable (no por índice).
+using ActorMap = EU::TSlotMap<EU::TSharedPointer<Actor>>;
+
 class
     UserInterface {
 public:
@@ -29,13 +32,14 @@ public:
     void
     render();
 
-    void
+    // Devuelven true si el usuario cambió algún valor en este frame
+    bool
     vec3Control(const std::string& label,
                 float* values,
                 float resetValue = 0.0f,
                 float columnWidth = 100.0f);
 
-    void
+    bool
     floatControl(const std::string& label,
                  float* value,
                  float resetValue = 0.0f,
@@ -108,7 +112,7 @@ public:
     RenderFullScreenTransparentWindow();
 
     void
-    outliner(const std::vector<EU::TSharedPointer<Actor>>& actors);
+    outliner(const ActorMap& actors);
 
 private:
     bool checkboxValue = true;
@@ -124,7 +128,7 @@ private:
     HWND m_windowHandle = nullptr;
 
 public:
-    int selectedActorIndex = -1;
+    ActorMap::Handle selectedActor;
     // El callback ahora necesita dos rutas: una para el modelo y otra para la textura
     std::function<void(const std::string&, const std::string&)> onImportModel;
     std::function<void()> onExitApplication;
@@ -1,5 +1,29 @@
 ﻿#include "BaseApp.h"
 #include "ECS/Transform.h" // Necesario para manipular el componente Transform
+#include "EngineUtilities/Utilities/TransformBatch.h"
+
+// Vista AoS de las posiciones de una malla para los kernels de EU::Batch
+static EU::Batch::AoSPoints
+vertexPositions(MeshComponent& mesh) {
+    return EU::Batch::AoSPoints(&mesh.m_vertex[0].Pos.x, mesh.m_vertex.size(), sizeof(SimpleVertex));
+}
+
+// Caja que contiene las 8 esquinas de bounds transformadas por matrix
+static EU::Batch::Bounds
+transformBounds(const EU::Batch::Bounds& bounds, const EU::Matrix4x4& matrix) {
+    EU::Batch::Bounds result;
+    for (int corner = 0; corner < 8; ++corner) {
+        EU::Vector3 point((corner & 1) ? bounds.maxPoint.x : bounds.minPoint.x,
+                          (corner & 2) ? bounds.maxPoint.y : bounds.minPoint.y,
+                          (corner & 4) ? bounds.maxPoint.z : bounds.minPoint.z);
+        point = matrix.transformPoint(point);
+        EU::Batch::Bounds pointBounds;
+        pointBounds.minPoint = point;
+        pointBounds.maxPoint = point;
+        result.merge(pointBounds);
+    }
+    return result;
+}
 
 HRESULT BaseApp::init() {
     HRESULT hr = S_OK;
@@ -53,7 +77,7 @@ HRESULT BaseApp::init() {
     // ===================================================================================
 
     // Set Plane Actor (Esta parte se mantiene)
-    m_APlane = EU::MakeShared<Actor>(m_device);
+    m_APlane = EU::MakeShared<Actor>(m_device, m_world);
     if (!m_APlane.isNull()) {
         SimpleVertex planeVertices[] = {
             {XMFLOAT3(-20.0f, 0.0f, -20.0f), XMFLOAT2(0.0f, 0.0f)},
@@ -81,10 +105,10 @@ HRESULT BaseApp::init() {
 
         m_APlane->setMesh(m_device, PlaneMeshes);
         m_APlane->setTextures(PlaneTextures);
-        m_APlane->getComponent<Transform>()->setTransform(EU::Vector3(0.0f, -5.0f, 0.0f), EU::Vector3(0.0f, 0.0f, 0.0f),
-                                                          EU::Vector3(1.0f, 1.0f, 1.0f));
+        m_APlane->getComponent<Transform>().setTransform(EU::Vector3(0.0f, -5.0f, 0.0f), EU::Vector3(0.0f, 0.0f, 0.0f),
+                                                         EU::Vector3(1.0f, 1.0f, 1.0f));
         m_APlane->setCastShadow(false);
-        m_actors.push_back(m_APlane);
+        m_userInterface.selectedActor = m_actors.Insert(m_APlane);
     } else {
         ERROR("Main", "InitDevice", "Failed to create Plane Actor.");
         return E_FAIL;
@@ -110,6 +134,29 @@ HRESULT BaseApp::init() {
 
     m_userInterface.init(m_window.m_hWnd, m_device.m_device, m_deviceContext.m_deviceContext);
 
+    // Presupuestos de memoria: al superarlos se avisa por stderr
+    EU::MemoryTracker::Get().SetBudget(EU::EMemoryTag::Loader, 512ll * 1024 * 1024);
+    EU::MemoryTracker::Get().SetBudget(EU::EMemoryTag::Texture, 256ll * 1024 * 1024);
+
+    // Sistemas del World. Transform es final: update se llama sin despacho
+    // virtual, recorriendo los Transform contiguos de cada chunk. Solo se
+    // marcan como cambiados los que reconstruyeron su matriz, así que
+    // onChanged<Transform> y changed<Transform> ignoran los objetos quietos
+    m_scheduler.addChunkSystem("Transform", 0, componentMask<Transform>(),
+        [this](Archetype& archetype, size_t chunkIndex, float deltaTime, CommandBuffer&) {
+            const int column = archetype.findColumn(componentTypeId<Transform>());
+            Transform* transforms = archetype.getColumnData<Transform>(chunkIndex, column);
+            const uint32_t count = archetype.getChunk(chunkIndex).count;
+            const uint32_t firstRow = uint32_t(chunkIndex) * archetype.getChunkCapacity();
+            const uint32_t tick = m_world.getChangeTick();
+            for (uint32_t i = 0; i < count; ++i) {
+                if (transforms[i].isDirty()) {
+                    transforms[i].update(deltaTime);
+                    archetype.markRowChanged(firstRow + i, column, tick);
+                }
+            }
+        });
+
     // ===================================================================================
     // CÓDIGO ACTUALIZADO: Conexión del callback con normalización de escala.
     // ===================================================================================
@@ -125,74 +172,62 @@ HRESULT BaseApp::init() {
             return;
         }
 
-        // 2. Calcular la Bounding Box (AABB) del modelo completo
-        XMVECTOR minPoint = XMLoadFloat3(&fbxLoader.meshes[0].m_vertex[0].Pos);
-        XMVECTOR maxPoint = minPoint;
-
-        for (const auto& mesh : fbxLoader.meshes) {
-            for (const auto& vertex : mesh.m_vertex) {
-                XMVECTOR point = XMLoadFloat3(&vertex.Pos);
-                minPoint = XMVectorMin(minPoint, point);
-                maxPoint = XMVectorMax(maxPoint, point);
+        // 2. El actor (entidad, componentes y recursos de GPU) se crea en el
+        //    punto de sincronización de update, no en medio de la UI
+        m_commands.call([this, meshes = std::move(fbxLoader.meshes), nodes = std::move(fbxLoader.nodes),
+                         texturePath](World&) mutable {
+            // 3. Crear el Actor con la jerarquía del FBX: cada malla queda en el
+            //    espacio local de su nodo y se dibuja con la matriz del nodo
+            EU::TSharedPointer<Actor> newActor = EU::MakeShared<Actor>(m_device, m_world);
+            if (newActor.isNull()) {
+                ERROR("BaseApp", "onImportModel", "Failed to create new Actor.");
+                return;
             }
-        }
-
-        // 3. Calcular el centro, el tamaño y el factor de escala para la normalización
-        XMVECTOR center = (minPoint + maxPoint) / 2.0f;
-        XMVECTOR size = maxPoint - minPoint;
-        float largestDimension = max(XMVectorGetX(size), max(XMVectorGetY(size), XMVectorGetZ(size)));
-
-        const float TARGET_SIZE = 3.0f; // El tamaño deseado para la dimensión más grande del modelo
-        float scaleFactor = 1.0f;
-        if (largestDimension > 0.0001f) {
-            scaleFactor = TARGET_SIZE / largestDimension;
-        }
-
-        // 4. Crear nuevas mallas con los vértices centrados y re-escalados
-        std::vector<MeshComponent> normalizedMeshes;
-        for (const auto& originalMesh : fbxLoader.meshes) {
-            MeshComponent newMesh = originalMesh; // Copiar metadatos
-            newMesh.m_vertex.clear();
-
-            for (const auto& originalVertex : originalMesh.m_vertex) {
-                SimpleVertex newVertex = originalVertex;
-                XMVECTOR originalPos = XMLoadFloat3(&originalVertex.Pos);
-
-                // Aplicar la transformación: Centrar y luego escalar
-                XMVECTOR newPos = (originalPos - center) * scaleFactor;
-
-                XMStoreFloat3(&newVertex.Pos, newPos);
-                newMesh.m_vertex.push_back(newVertex);
+            newActor->setNodes(nodes);
+            newActor->setMesh(m_device, meshes);
+
+            // 4. Calcular la Bounding Box (AABB) del modelo completo, con cada
+            //    malla llevada al espacio del modelo por la matriz de su nodo
+            TransformHierarchy& hierarchy = newActor->getHierarchy();
+            hierarchy.update();
+            EU::Batch::Bounds bounds;
+            for (size_t i = 0; i < meshes.size(); ++i) {
+                MeshComponent& mesh = meshes[i];
+                if (!mesh.m_vertex.empty()) {
+                    bounds.merge(transformBounds(EU::Batch::computeBounds(vertexPositions(mesh)),
+                                                 hierarchy.getWorldMatrix(newActor->getMeshNode(i))));
+                }
             }
-            normalizedMeshes.push_back(newMesh);
-        }
-
-        // 5. Crear y configurar el Actor con la malla normalizada
-        EU::TSharedPointer<Actor> newActor = EU::MakeShared<Actor>(m_device);
-        if (newActor.isNull()) {
-            ERROR("BaseApp", "onImportModel", "Failed to create new Actor.");
-            return;
-        }
 
-        std::vector<Texture> textures;
-        if (!texturePath.empty()) {
-            Texture newTexture;
-            if (SUCCEEDED(newTexture.init(m_device, texturePath.c_str(), DDS))) {
-                textures.push_back(newTexture);
+            // 5. Normalizar con el nodo raíz (centrar y escalar) en vez de
+            //    reescribir los vértices: p' = (p - center) * scale
+            const float TARGET_SIZE = 3.0f; // El tamaño deseado para la dimensión más grande del modelo
+            EU::Vector3 center = bounds.center();
+            float scaleFactor = EU::Batch::fitScale(bounds, TARGET_SIZE);
+            hierarchy.setLocalTransform(newActor->getRootNode(),
+                                        EU::Vector3(-center.x * scaleFactor, -center.y * scaleFactor, -center.z * scaleFactor),
+                                        EU::Quaternion(),
+                                        EU::Vector3(scaleFactor, scaleFactor, scaleFactor));
+
+            std::vector<Texture> textures;
+            if (!texturePath.empty()) {
+                Texture newTexture;
+                if (SUCCEEDED(newTexture.init(m_device, texturePath.c_str(), DDS))) {
+                    textures.push_back(newTexture);
+                }
             }
-        }
 
-        newActor->setMesh(m_device, normalizedMeshes); // Usar las mallas normalizadas
-        newActor->setTextures(textures);
+            newActor->setTextures(textures);
 
-        // La escala ahora es (1, 1, 1) porque el modelo base ya está en el tamaño correcto
-        newActor->getComponent<Transform>()->setTransform(
-            EU::Vector3(0.0f, 0.0f, 0.0f), // Posición
-            EU::Vector3(0.0f, 0.0f, 0.0f), // Rotación
-            EU::Vector3(1.0f, 1.0f, 1.0f)); // Escala
+            // La escala ahora es (1, 1, 1) porque el nodo raíz ya deja el modelo en el tamaño correcto
+            newActor->getComponent<Transform>().setTransform(
+                EU::Vector3(0.0f, 0.0f, 0.0f), // Posición
+                EU::Vector3(0.0f, 0.0f, 0.0f), // Rotación
+                EU::Vector3(1.0f, 1.0f, 1.0f)); // Escala
 
-        newActor->setCastShadow(true);
-        m_actors.push_back(newActor);
+            newActor->setCastShadow(true);
+            m_actors.Insert(newActor);
+        });
     };
 
     return S_OK;
@@ -202,9 +237,9 @@ void
 BaseApp::update() {
     m_userInterface.update();
 
-    // Asegurarse de que el índice seleccionado sea válido para el vector de actores
-    if (m_userInterface.selectedActorIndex >= 0 && m_userInterface.selectedActorIndex < m_actors.size()) {
-        m_userInterface.objectControlPanel(m_actors[m_userInterface.selectedActorIndex]);
+    // Get() devuelve nullptr si el actor seleccionado ya no existe
+    if (EU::TSharedPointer<Actor>* selected = m_actors.Get(m_userInterface.selectedActor)) {
+        m_userInterface.objectControlPanel(*selected);
     }
     m_userInterface.mainMenuBar();
     m_userInterface.outliner(m_actors);
@@ -221,6 +256,21 @@ BaseApp::update() {
     cbChangesOnResize.mProjection = XMMatrixTranspose(m_Projection);
     m_changeOnResize.update(m_deviceContext, nullptr, 0, nullptr, &cbChangesOnResize, 0, 0);
 
+    // Punto de sincronización: lo que la UI pidió en este frame (p. ej. un
+    // modelo importado) entra al World antes de que corran los sistemas
+    m_commands.playback(m_world);
+
+    // Sistemas del World: los independientes (y los chunks de cada uno) se
+    // reparten entre los hilos del scheduler
+    m_scheduler.run(t);
+
+    // Un tick por frame: avisa a los observadores onChanged de lo que
+    // escribieron la importación y los sistemas; las consultas con
+    // changed<T>(tick) comparan contra él
+    m_world.advanceTick();
+
+    // Los actores suben sus constant buffers con el contexto inmediato, que
+    // no admite varios hilos: se quedan en el hilo principal
     for (auto& actor : m_actors) {
         if (!actor.isNull()) {
             actor->update(t, m_deviceContext);
@@ -246,6 +296,9 @@ BaseApp::render() {
 
     m_userInterface.render();
     m_swapChain.present();
+
+    // Fin de frame: libera de golpe toda la memoria temporal del hilo principal
+    EU::GetFrameArena().Reset();
 }
 
 void
@@ -255,13 +308,16 @@ BaseApp::destroy() {
     if (m_deviceContext.m_deviceContext)
         m_deviceContext.m_deviceContext->ClearState();
 
+    m_scheduler.shutdown();
+    m_commands.clear();
+
     // Limpiar actores y sus recursos
     for (auto& actor : m_actors) {
         if (!actor.isNull()) {
             actor->destroy();
         }
     }
-    m_actors.clear();
+    m_actors.Empty();
 
     m_neverChanges.destroy();
     m_changeOnResize.destroy();
@@ -77,7 +77,7 @@ Buffer::update(DeviceContext& deviceContext,
         ERROR("ShaderProgram", "update", "pSrcData is null.");
         return;
     }
-    deviceContext.m_deviceContext->UpdateSubresource(m_buffer,
+    deviceContext.m_deviceContext->UpdateSubresource(m_buffer.get(),
                                                      DstSubresource,
                                                      pDstBox,
                                                      pSrcData,
@@ -104,16 +104,16 @@ Buffer::render(DeviceContext& deviceContext,
 
     switch (m_bindFlag) {
     case D3D11_BIND_VERTEX_BUFFER:
-        deviceContext.m_deviceContext->IASetVertexBuffers(StartSlot, NumBuffers, &m_buffer, &m_stride, &m_offset);
+        deviceContext.m_deviceContext->IASetVertexBuffers(StartSlot, NumBuffers, m_buffer.getAddressOf(), &m_stride, &m_offset);
         break;
     case D3D11_BIND_CONSTANT_BUFFER:
-        deviceContext.m_deviceContext->VSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
+        deviceContext.m_deviceContext->VSSetConstantBuffers(StartSlot, NumBuffers, m_buffer.getAddressOf());
         if (setPixelShader) {
-            deviceContext.m_deviceContext->PSSetConstantBuffers(StartSlot, NumBuffers, &m_buffer);
+            deviceContext.m_deviceContext->PSSetConstantBuffers(StartSlot, NumBuffers, m_buffer.getAddressOf());
         }
         break;
     case D3D11_BIND_INDEX_BUFFER:
-        deviceContext.m_deviceContext->IASetIndexBuffer(m_buffer, format, m_offset);
+        deviceContext.m_deviceContext->IASetIndexBuffer(m_buffer.get(), format, m_offset);
         break;
     default:
         ERROR("Buffer", "render", "Unsupported BindFlag");
@@ -124,7 +124,7 @@ Buffer::render(DeviceContext& deviceContext,
 
 void
 Buffer::destroy() {
-    SAFE_RELEASE(m_buffer);
+    m_buffer.reset();
 }
 
 
@@ -137,7 +137,7 @@ Buffer::createBuffer(Device& device,
         return E_POINTER;
     }
 
-    HRESULT hr = device.CreateBuffer(&desc, initData, &m_buffer);
+    HRESULT hr = device.CreateBuffer(&desc, initData, m_buffer.releaseAndGetAddressOf());
     if (FAILED(hr)) {
         ERROR("Buffer", "createBuffer", "Failed to create buffer");
         return hr;
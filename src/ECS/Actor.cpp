@@ -3,20 +3,15 @@
 #include "Device.h"
 #include "DeviceContext.h"
 
-Actor::Actor(Device& device) {
-	// Setup Default Components
-	EU::TSharedPointer<Transform> transform = EU::MakeShared<Transform>();
-	addComponent(transform);
-	EU::TSharedPointer<MeshComponent> meshComponent = EU::MakeShared<MeshComponent>();
-	addComponent(meshComponent);
+Actor::Actor(Device& device, World& world) : Entity(world) {
+	EU::MemoryTagScope memoryTag(EU::EMemoryTag::ECS);
+
+	// Setup Default Components (se guardan por valor en el arquetipo del mundo)
+	emplaceComponent<Transform>();
+	emplaceComponent<MeshComponent>();
 
 	HRESULT hr;
 	std::string classNameType = "Actor -> " + m_name;
-	hr = m_modelBuffer.init(device, sizeof(CBChangesEveryFrame));
-	if (FAILED(hr)) {
-		ERROR("Actor", classNameType.c_str(), "Failed to create new CBChangesEveryFrame");
-	}
-
 	hr = m_sampler.init(device);
 	if (FAILED(hr)) {
 		ERROR("Actor", classNameType.c_str(), "Failed to create new SamplerState");
@@ -39,13 +34,6 @@ Actor::Actor(Device& device) {
 			("Failed to initialize Shadow Shader. HRESULT: " + std::to_string(hr)).c_str());
 	}
 
-	hr = m_shaderBuffer.init(device, sizeof(CBChangesEveryFrame));
-	if (FAILED(hr)) {
-		ERROR("Main", "InitDevice",
-			("Failed to initialize Shadow Buffer. HRESULT: " + std::to_string(hr)).c_str());
-
-	}
-
 	hr = m_shadowBlendState.init(device);
 	if (FAILED(hr)) {
 		ERROR("Main", "InitDevice",
@@ -66,19 +54,28 @@ Actor::Actor(Device& device) {
 
 void
 Actor::update(float deltaTime, DeviceContext& deviceContext) {
-	// Update all components
-	for (auto& component : m_components) {
-		if (component) {
-			component->update(deltaTime);
+	// Los componentes los actualizan los sistemas del World (BaseApp::update);
+	// la jerarquía solo recalcula los subárboles que cambiaron
+	m_hierarchy.update();
+
+	// Si ni el nodo de la malla ni el Transform cambiaron desde la última
+	// subida, su constant buffer ya tiene los datos correctos (objetos
+	// estáticos: no se sube nada)
+	const Transform& transform = getComponent<Transform>();
+	for (size_t i = 0; i < m_modelBuffers.Num(); ++i) {
+		const uint64_t version = getMeshVersion(i, transform);
+		if (version == m_modelVersions[i]) {
+			continue;
 		}
-	}
+		m_modelVersions[i] = version;
 
-	// Update the model buffer
-	m_model.mWorld = XMMatrixTranspose(getComponent<Transform>()->matrix);
-	m_model.vMeshColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
+		// Update the model buffer: nodo (espacio del actor) * Transform del actor
+		m_model.mWorld = XMMatrixTranspose(XMMatrixMultiply(toXMMATRIX(getMeshMatrix(i)), transform.getMatrix()));
+		m_model.vMeshColor = XMFLOAT4(1.0f, 1.0f, 1.0f, 1.0f);
 
-	// Update the constant buffer
-	m_modelBuffer.update(deviceContext, nullptr, 0, nullptr, &m_model, 0, 0);
+		// Update the constant buffer
+		m_modelBuffers[i].update(deviceContext, nullptr, 0, nullptr, &m_model, 0, 0);
+	}
 }
 
 void
@@ -95,15 +92,15 @@ Actor::render(DeviceContext& deviceContext) {
 
 	deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 	// Update buffer and render all components
-	for (unsigned int i = 0; i < m_meshes.size(); i++) {
+	for (unsigned int i = 0; i < m_meshes.Num(); i++) {
 		m_vertexBuffers[i].render(deviceContext, 0, 1);
 		m_indexBuffers[i].render(deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
 		// Bind del CB “normal” (world + color)
-		m_modelBuffer.render(deviceContext, 2, 1, true);
+		m_modelBuffers[i].render(deviceContext, 2, 1, true);
 
 		// Render mesh texture
-		if (m_textures.size() > 0) {
-			if (i < m_textures.size()) {
+		if (m_textures.Num() > 0) {
+			if (i < m_textures.Num()) {
 				m_textures[i].render(deviceContext, 0, 1);
 			}
 		}
@@ -125,7 +122,13 @@ Actor::destroy() {
 	for (auto& tex : m_textures) {
 		tex.destroy();
 	}
-	m_modelBuffer.destroy();
+	for (auto& modelBuffer : m_modelBuffers) {
+		modelBuffer.destroy();
+	}
+
+	for (auto& shadowBuffer : m_shadowBuffers) {
+		shadowBuffer.destroy();
+	}
 
 	m_rasterizer.destroy();
 	m_blendstate.destroy();
@@ -134,7 +137,12 @@ Actor::destroy() {
 
 void
 Actor::setMesh(Device& device, std::vector<MeshComponent> meshes) {
-	m_meshes = meshes;
+	EU::MemoryTagScope memoryTag(EU::EMemoryTag::Mesh);
+	m_meshes.Empty();
+	m_meshes.Reserve(meshes.size());
+	for (auto& mesh : meshes) {
+		m_meshes.Add(std::move(mesh));
+	}
 	HRESULT hr;
 	for (auto& mesh : m_meshes) {
 		// Crear vertex buffer
@@ -144,7 +152,7 @@ Actor::setMesh(Device& device, std::vector<MeshComponent> meshes) {
 			ERROR("Actor", "setMesh", "Failed to create new vertexBuffer");
 		}
 		else {
-			m_vertexBuffers.push_back(vertexBuffer);
+			m_vertexBuffers.Add(std::move(vertexBuffer));
 		}
 
 		// Crear index buffer
@@ -154,23 +162,111 @@ Actor::setMesh(Device& device, std::vector<MeshComponent> meshes) {
 			ERROR("Actor", "setMesh", "Failed to create new indexBuffer");
 		}
 		else {
-			m_indexBuffers.push_back(indexBuffer);
+			m_indexBuffers.Add(std::move(indexBuffer));
+		}
+
+		// Constant buffers propios: cada malla puede tener su propio nodo
+		Buffer modelBuffer;
+		hr = modelBuffer.init(device, sizeof(CBChangesEveryFrame));
+		if (FAILED(hr)) {
+			ERROR("Actor", "setMesh", "Failed to create new CBChangesEveryFrame");
+		}
+		m_modelBuffers.Add(std::move(modelBuffer));
+		m_modelVersions.Add(~uint64_t(0));
+
+		Buffer shadowBuffer;
+		hr = shadowBuffer.init(device, sizeof(CBChangesEveryFrame));
+		if (FAILED(hr)) {
+			ERROR("Actor", "setMesh", "Failed to create new Shadow Buffer");
+		}
+		m_shadowBuffers.Add(std::move(shadowBuffer));
+		m_shadowVersions.Add(~uint64_t(0));
+
+		// Nodo de la malla: el suyo, o la raíz si no tiene
+		if (mesh.m_nodeIndex >= 0 && size_t(mesh.m_nodeIndex) < m_nodes.size()) {
+			m_meshNodes.Add(m_nodes[mesh.m_nodeIndex]);
+		}
+		else {
+			m_meshNodes.Add(m_rootNode);
 		}
 	}
 }
 
+void
+Actor::setNodes(const std::vector<ModelNode>& nodes) {
+	EU::MemoryTagScope memoryTag(EU::EMemoryTag::ECS);
+	m_hierarchy.clear();
+	m_nodes.clear();
+	m_nodes.reserve(nodes.size());
+
+	// Los padres van antes que los hijos: los nodos se crean en el orden de
+	// profundidad de la jerarquía y no hace falta reordenarla
+	m_rootNode = m_hierarchy.createNode();
+	for (const ModelNode& node : nodes) {
+		TransformNodeId parent = node.parent >= 0 ? m_nodes[node.parent] : m_rootNode;
+		m_nodes.push_back(m_hierarchy.createNode(parent, node.position, node.orientation, node.scale));
+	}
+}
+
+const EU::Matrix4x4&
+Actor::getMeshMatrix(size_t meshIndex) const {
+	static const EU::Matrix4x4 IDENTITY = EU::Matrix4x4::identity();
+	const TransformNodeId node = m_meshNodes[meshIndex];
+	return node.IsSet() ? m_hierarchy.getWorldMatrix(node) : IDENTITY;
+}
+
+uint64_t
+Actor::getMeshVersion(size_t meshIndex, const Transform& transform) const {
+	const TransformNodeId node = m_meshNodes[meshIndex];
+	const uint32_t nodeVersion = node.IsSet() ? m_hierarchy.getWorldVersion(node) : 0;
+	return (uint64_t(nodeVersion) << 32) | transform.getVersion();
+}
+
 void
 Actor::renderShadow(DeviceContext& deviceContext) {
-// --- 1) Descompón world en traslación + yaw + escala ---
-	auto t = getComponent<Transform>();
-	auto pos = t->getPosition();   // Vector3
-	auto yaw = t->getRotation().y; // sólo yaw
-	auto scl = t->getScale();      // Vector3
+	const Transform& t = getComponent<Transform>();
+
+	// 1) Bind de shader y estados
+	float blendFactor[4] = { 0.f, 0.f, 0.f, 0.f };
+	m_shaderShadow.render(deviceContext, PIXEL_SHADER);
+	m_shadowBlendState.render(deviceContext, blendFactor, 0xffffffff);
+	m_shadowDepthStencilState.render(deviceContext, 0);
+
+	deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	// 2) Dibujar cada malla del actor. Su sombra solo depende de su nodo y del
+	//    transform (la luz es fija): se recalcula y se sube cuando cambia
+	//    alguna de sus versiones
+	EU::Matrix4x4 worldShadow;
+	bool worldShadowReady = false;
+	for (size_t i = 0; i < m_meshes.Num(); ++i) {
+		const uint64_t version = getMeshVersion(i, t);
+		if (version != m_shadowVersions[i]) {
+			m_shadowVersions[i] = version;
+			if (!worldShadowReady) {
+				worldShadow = computeShadowMatrix(t);
+				worldShadowReady = true;
+			}
+
+			// Nodo (espacio del actor) * sombra del actor
+			m_cbShadow.mWorld = XMMatrixTranspose(toXMMATRIX(getMeshMatrix(i) * worldShadow));
+			m_cbShadow.vMeshColor = XMFLOAT4(0, 0, 0, 0.5f);
+			m_shadowBuffers[i].update(deviceContext, nullptr, 0, nullptr, &m_cbShadow, 0, 0);
+		}
+		m_shadowBuffers[i].render(deviceContext, 2, 1, true);
+
+		m_vertexBuffers[i].render(deviceContext, 0, 1);
+		m_indexBuffers[i].render(deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
+		deviceContext.DrawIndexed(m_meshes[i].m_numIndex, 0, 0);
+	}
+}
 
-	XMMATRIX Mscale = XMMatrixScaling(scl.x, scl.y, scl.z);
-	XMMATRIX Myaw = XMMatrixRotationY(yaw);
-	XMMATRIX Mtrans = XMMatrixTranslation(pos.x, pos.y, pos.z);
-	XMMATRIX worldYaw = Mscale * Myaw * Mtrans;
+EU::Matrix4x4
+Actor::computeShadowMatrix(const Transform& t) const {
+	// --- 1) Descompón world en traslación + yaw + escala ---
+	// Sólo el ángulo de Euler Y del Transform, igual que XMMatrixRotationY(rot.y):
+	// el pitch y el roll no giran la sombra
+	EU::Quaternion yaw = EU::Quaternion::fromEuler(0.0f, t.getRotation().y, 0.0f);
+	EU::Matrix4x4 worldYaw = EU::Matrix4x4::compose(t.getPosition(), yaw, t.getScale());
 
 	// --- 2) Construye la matriz de proyección de sombra ---
 	//   para proyectar v' = v - (v.y / Ly) * L
@@ -179,32 +275,13 @@ Actor::renderShadow(DeviceContext& deviceContext) {
 	float Lz = m_LightPos.z;
 	float invLy = 1.0f / Ly;
 
-	XMMATRIX S = XMMATRIX(
+	EU::Matrix4x4 S(
 		1.0f, -Lx * invLy, 0.0f, 0.0f,
 		0.0f, 0.0f, 0.0f, 0.0f,
 		0.0f, -Lz * invLy, 1.0f, 0.0f,
 		0.0f, 0.0f, 0.0f, 1.0f
 	);
 
-	// --- 3) Aplica worldYaw * S para obtener la sombra en el suelo ---
-	XMMATRIX worldShadow = worldYaw * S;
-	// 2) Preparar y actualizar constant buffer
-	m_cbShadow.mWorld = XMMatrixTranspose(worldShadow);
-	m_cbShadow.vMeshColor = XMFLOAT4(0, 0, 0, 0.5f);
-	m_shaderBuffer.update(deviceContext, nullptr, 0, nullptr, &m_cbShadow, 0, 0);
-	m_shaderBuffer.render(deviceContext, 2, 1, true);
-
-	// 3) Bind de shader y estados
-	float blendFactor[4] = { 0.f, 0.f, 0.f, 0.f };
-	m_shaderShadow.render(deviceContext, PIXEL_SHADER);
-	m_shadowBlendState.render(deviceContext, blendFactor, 0xffffffff);
-	m_shadowDepthStencilState.render(deviceContext, 0);
-
-	deviceContext.IASetPrimitiveTopology(D3D11_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-	// 4) Dibujar cada malla del actor
-	for (size_t i = 0; i < m_meshes.size(); ++i) {
-		m_vertexBuffers[i].render(deviceContext, 0, 1);
-		m_indexBuffers[i].render(deviceContext, 0, 1, false, DXGI_FORMAT_R32_UINT);
-		deviceContext.DrawIndexed(m_meshes[i].m_numIndex, 0, 0);
-	}
-}
\ No newline at end of file
+	// --- 3) worldYaw * S proyecta la sombra en el suelo ---
+	return worldYaw * S;
+}
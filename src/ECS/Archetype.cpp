@@ -0,0 +1,131 @@
+﻿#include "ECS\Archetype.h"
+#include <algorithm>
+
+namespace {
+  size_t
+  alignUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+  }
+
+  /**
+   * Bytes que ocupa un chunk con capacity entidades: los EntityId y después
+   * cada columna alineada a su tipo. Rellena los offsets de las columnas.
+   */
+  size_t
+  layoutChunk(EU::TArray<Archetype::Column>& columns, uint32_t capacity) {
+    size_t offset = sizeof(EntityId) * size_t(capacity);
+    for (Archetype::Column& column : columns) {
+      offset = alignUp(offset, column.info->alignment);
+      column.offset = offset;
+      offset += size_t(column.info->size) * capacity;
+    }
+    return offset;
+  }
+
+  /**
+   * SetNum con crecimiento geométrico: SetNum solo reserva lo justo, y al
+   * añadir chunks de uno en uno copiaría todos los ticks en cada alta.
+   */
+  void
+  setNumGrowing(EU::TArray<uint32_t>& ticks, size_t count) {
+    if (count > ticks.GetCapacity()) {
+      ticks.Reserve(std::max(ticks.GetCapacity() * 2, count));
+    }
+    ticks.SetNum(count);
+  }
+}
+
+Archetype::Archetype(const EU::TArray<const ComponentTypeInfo*>& types) {
+  for (uint32_t id = 0; id < MAX_COMPONENT_TYPES; ++id) {
+    m_columnOf[id] = -1;
+  }
+
+  size_t bytesPerEntity = sizeof(EntityId);
+  for (const ComponentTypeInfo* info : types) {
+    Column column = { info, 0 };
+    m_columnOf[info->id] = int8_t(m_columns.Add(column));
+    m_mask |= ComponentMask(1) << info->id;
+    bytesPerEntity += info->size;
+  }
+
+  // Tantas entidades como quepan en CHUNK_SIZE contando el relleno de
+  // alineación; si un solo componente no cabe, el chunk crece a lo necesario.
+  uint32_t capacity = uint32_t(CHUNK_SIZE / bytesPerEntity);
+  while (capacity > 1 && layoutChunk(m_columns, capacity) > CHUNK_SIZE) {
+    --capacity;
+  }
+  m_chunkCapacity = capacity > 0 ? capacity : 1;
+  const size_t needed = layoutChunk(m_columns, m_chunkCapacity);
+  m_chunkBytes = needed > CHUNK_SIZE ? needed : CHUNK_SIZE;
+}
+
+Archetype::~Archetype() {
+  for (Chunk& chunk : m_chunks) {
+    for (const Column& column : m_columns) {
+      for (uint32_t i = 0; i < chunk.count; ++i) {
+        column.info->destroy(chunk.data + column.offset + size_t(i) * column.info->size);
+      }
+    }
+    EU::TrackedFree(chunk.data);
+  }
+}
+
+uint32_t
+Archetype::allocateRow(EntityId entity) {
+  if (m_numEntities == m_chunks.Num() * size_t(m_chunkCapacity)) {
+    EU::MemoryTagScope memoryTag(EU::EMemoryTag::ECS);
+    Chunk chunk = { static_cast<unsigned char*>(EU::TrackedAllocate(m_chunkBytes, 64)), 0 };
+    m_chunks.Add(chunk);
+    resizeTicks();
+  }
+
+  const uint32_t row = m_numEntities++;
+  Chunk& chunk = m_chunks[row / m_chunkCapacity];
+  reinterpret_cast<EntityId*>(chunk.data)[chunk.count++] = entity;
+  return row;
+}
+
+EntityId
+Archetype::removeRow(uint32_t row) {
+  const uint32_t last = --m_numEntities;
+  EntityId moved;
+  if (row != last) {
+    // La última fila pasa al hueco: se mueve cada componente y se destruye el origen
+    for (int c = 0; c < int(m_columns.Num()); ++c) {
+      void* src = getComponentData(last, c);
+      m_columns[c].info->moveConstruct(getComponentData(row, c), src);
+      m_columns[c].info->destroy(src);
+      copyRowTicks(row, c, *this, last, c);
+    }
+    moved = getEntity(last);
+    Chunk& chunk = m_chunks[row / m_chunkCapacity];
+    reinterpret_cast<EntityId*>(chunk.data)[row % m_chunkCapacity] = moved;
+  }
+
+  Chunk& lastChunk = m_chunks[last / m_chunkCapacity];
+  --lastChunk.count;
+  if (lastChunk.count == 0 && m_chunks.Num() > 1) {
+    // Se conserva un chunk vacío para no reservar y liberar en cada alta/baja
+    EU::TrackedFree(lastChunk.data);
+    m_chunks.Pop();
+    resizeTicks();
+  }
+  return moved;
+}
+
+void
+Archetype::markChanged(size_t chunkIndex, int column, uint32_t tick) {
+  uint32_t* ticks = &m_rowChangeTicks[getTickOffset(chunkIndex, column)];
+  for (uint32_t i = 0; i < m_chunks[chunkIndex].count; ++i) {
+    ticks[i] = tick;
+  }
+  m_changeTicks[chunkIndex * m_columns.Num() + column] = tick;
+}
+
+void
+Archetype::resizeTicks() {
+  const size_t numTicks = m_chunks.Num() * m_columns.Num();
+  setNumGrowing(m_changeTicks, numTicks);
+  setNumGrowing(m_rowChangeTicks, numTicks * m_chunkCapacity);
+  setNumGrowing(m_rowAddedTicks, numTicks * m_chunkCapacity);
+}
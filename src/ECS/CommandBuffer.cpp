@@ -0,0 +1,107 @@
+﻿#include "ECS\CommandBuffer.h"
+#include "ECS\World.h"
+
+CommandBuffer::CommandBuffer(size_t initialBytes) : m_arena(initialBytes) {}
+
+CommandBuffer::~CommandBuffer() {
+  clear();
+}
+
+PendingEntity
+CommandBuffer::spawn() {
+  PendingEntity entity = { m_numPending++ };
+  record(Op::Spawn, EntityId(), entity.index, nullptr, nullptr);
+  return entity;
+}
+
+void
+CommandBuffer::destroy(EntityId entity) {
+  record(Op::Destroy, entity, NONE, nullptr, nullptr);
+}
+
+void
+CommandBuffer::destroy(PendingEntity entity) {
+  record(Op::Destroy, EntityId(), entity.index, nullptr, nullptr);
+}
+
+CommandBuffer::Command&
+CommandBuffer::record(Op op, EntityId entity, uint32_t pending, void* payload, const ComponentTypeInfo* info) {
+  assert(!m_playing && "CommandBuffer: cannot record while playing back");
+  assert((pending == NONE || pending < m_numPending) && "CommandBuffer: PendingEntity was not spawned by this buffer");
+  Command& command = m_commands.Emplace();
+  command.op = op;
+  command.pending = pending;
+  command.entity = entity;
+  command.type = 0;
+  command.info = info;
+  command.payload = payload;
+  command.invoke = nullptr;
+  command.destroyPayload = nullptr;
+  return command;
+}
+
+void
+CommandBuffer::playback(World& world) {
+  m_playing = true;
+  m_spawned.Empty();
+  m_spawned.SetNum(m_numPending);
+  try {
+    for (Command& command : m_commands) {
+      const EntityId entity = command.pending == NONE ? command.entity : m_spawned[command.pending];
+      switch (command.op) {
+      case Op::Spawn:
+        m_spawned[command.pending] = world.createEntity();
+        break;
+      case Op::Destroy:
+        world.destroyEntity(entity);
+        break;
+      case Op::Add:
+        world.addComponentMoved(entity, *command.info, command.payload);
+        break;
+      case Op::Remove:
+        world.removeComponent(entity, command.type);
+        break;
+      case Op::Call:
+        command.invoke(world, command.payload);
+        break;
+      }
+      releasePayload(command);
+    }
+  }
+  catch (...) {
+    // Se descartan el comando que falló y los que faltaban; los ya
+    // aplicados tienen su valor liberado y clear() los salta
+    m_playing = false;
+    clear();
+    throw;
+  }
+  m_playing = false;
+
+  m_commands.Empty();
+  m_arena.Reset();
+  m_numPending = 0;
+}
+
+void
+CommandBuffer::clear() {
+  for (Command& command : m_commands) {
+    releasePayload(command);
+  }
+  m_commands.Empty();
+  m_arena.Reset();
+  m_numPending = 0;
+}
+
+void
+CommandBuffer::releasePayload(Command& command) {
+  if (!command.payload) {
+    return;
+  }
+  if (command.op == Op::Add) {
+    command.info->destroy(command.payload);
+  }
+  else if (command.op == Op::Call) {
+    command.destroyPayload(command.payload);
+  }
+  command.payload = nullptr;
+}
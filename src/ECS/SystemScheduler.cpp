@@ -0,0 +1,243 @@
+﻿#include "ECS\SystemScheduler.h"
+
+SystemScheduler::SystemScheduler(World& world, uint32_t numWorkers) : m_world(world) {
+  if (numWorkers == ~0u) {
+    const uint32_t cores = std::thread::hardware_concurrency();
+    numWorkers = cores > 1 ? cores - 1 : 0;
+  }
+  m_numWorkers = numWorkers;
+}
+
+SystemScheduler::~SystemScheduler() {
+  shutdown();
+}
+
+uint32_t
+SystemScheduler::addSystem(const std::string& name, ComponentMask reads, ComponentMask writes, SystemFn fn) {
+  System system;
+  system.name = name;
+  system.reads = reads;
+  system.writes = writes;
+  system.fn = std::move(fn);
+  return registerSystem(std::move(system));
+}
+
+uint32_t
+SystemScheduler::addChunkSystem(const std::string& name, ComponentMask reads, ComponentMask writes, ChunkFn fn) {
+  System system;
+  system.name = name;
+  system.reads = reads;
+  system.writes = writes;
+  system.chunkFn = std::move(fn);
+  return registerSystem(std::move(system));
+}
+
+uint32_t
+SystemScheduler::registerSystem(System system) {
+  system.dependenciesLeft = 0;
+  system.tasksLeft = 0;
+  system.numTasks = 0;
+  m_systems.push_back(std::move(system));
+  m_graphDirty = true;
+  return uint32_t(m_systems.size() - 1);
+}
+
+const std::vector<uint32_t>&
+SystemScheduler::getDependencies(uint32_t system) {
+  if (m_graphDirty) {
+    buildGraph();
+  }
+  return m_systems[system].dependencies;
+}
+
+void
+SystemScheduler::buildGraph() {
+  for (System& system : m_systems) {
+    system.dependencies.clear();
+    system.dependents.clear();
+  }
+
+  // Un sistema espera a todos los anteriores con los que choca: el orden de
+  // registro decide quién va primero entre dos que tocan los mismos datos
+  for (uint32_t j = 0; j < m_systems.size(); ++j) {
+    System& later = m_systems[j];
+    for (uint32_t i = 0; i < j; ++i) {
+      System& earlier = m_systems[i];
+      const bool conflict = (earlier.writes & (later.reads | later.writes)) ||
+                            (later.writes & earlier.reads);
+      if (conflict) {
+        later.dependencies.push_back(i);
+        earlier.dependents.push_back(j);
+      }
+    }
+  }
+  m_graphDirty = false;
+}
+
+void
+SystemScheduler::run(float deltaTime) {
+  if (m_systems.empty()) {
+    return;
+  }
+  if (m_graphDirty) {
+    buildGraph();
+  }
+  if (m_workers.size() < m_numWorkers) {
+    startWorkers();
+  }
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_deltaTime = deltaTime;
+  m_systemsLeft = uint32_t(m_systems.size());
+  for (System& system : m_systems) {
+    system.dependenciesLeft = uint32_t(system.dependencies.size());
+  }
+  for (uint32_t i = 0; i < m_systems.size(); ++i) {
+    if (m_systems[i].dependencies.empty()) {
+      dispatchLocked(i);
+    }
+  }
+  m_signal.notify_all();
+
+  // Este hilo también trabaja hasta que terminen todos los sistemas
+  while (m_systemsLeft > 0) {
+    if (m_tasks.empty()) {
+      m_signal.wait(lock);
+      continue;
+    }
+    Task task = m_tasks.front();
+    m_tasks.pop_front();
+    lock.unlock();
+    execute(task);
+    lock.lock();
+  }
+  lock.unlock();
+
+  // Punto de sincronización: ya no corre ningún sistema y los cambios
+  // estructurales se aplican en un orden fijo
+  for (System& system : m_systems) {
+    for (uint32_t i = 0; i < system.numTasks; ++i) {
+      system.commands[i]->playback(m_world);
+    }
+  }
+}
+
+void
+SystemScheduler::shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_signal.notify_all();
+  for (std::thread& worker : m_workers) {
+    worker.join();
+  }
+  m_workers.clear();
+  m_stopping = false;
+}
+
+void
+SystemScheduler::startWorkers() {
+  while (m_workers.size() < m_numWorkers) {
+    m_workers.push_back(std::thread(&SystemScheduler::workerLoop, this));
+  }
+}
+
+void
+SystemScheduler::workerLoop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  for (;;) {
+    m_signal.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+    if (m_tasks.empty()) {
+      return;
+    }
+    Task task = m_tasks.front();
+    m_tasks.pop_front();
+    lock.unlock();
+    execute(task);
+    lock.lock();
+  }
+}
+
+void
+SystemScheduler::execute(const Task& task) {
+  System& system = m_systems[task.system];
+  CommandBuffer& commands = *system.commands[task.index];
+  if (system.chunkFn) {
+    for (uint32_t i = task.begin; i < task.end; ++i) {
+      const ChunkRef& chunk = system.chunks[i];
+      system.chunkFn(*chunk.archetype, chunk.chunkIndex, m_deltaTime, commands);
+    }
+  }
+  else {
+    system.fn(m_deltaTime, commands);
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (--system.tasksLeft == 0) {
+    completeLocked(task.system);
+  }
+}
+
+void
+SystemScheduler::dispatchLocked(uint32_t system) {
+  System& target = m_systems[system];
+  target.numTasks = 0;
+  if (!target.chunkFn) {
+    target.tasksLeft = 1;
+    pushTaskLocked(system, 0, 1);
+    return;
+  }
+
+  // Chunks con datos de los arquetipos que tienen todos los tipos del sistema,
+  // sin las entidades desactivadas (nadie cambia la estructura del World
+  // durante run())
+  const ComponentMask required = target.reads | target.writes;
+  target.chunks.clear();
+  for (Archetype* archetype : m_world.getArchetypes()) {
+    if ((archetype->getMask() & required) != required ||
+        (archetype->getMask() & componentMask<Disabled>())) {
+      continue;
+    }
+    for (size_t c = 0; c < archetype->getNumChunks(); ++c) {
+      if (archetype->getChunk(c).count > 0) {
+        target.chunks.push_back(ChunkRef{ archetype, c });
+      }
+    }
+  }
+  if (target.chunks.empty()) {
+    completeLocked(system);
+    return;
+  }
+
+  // Unas dos tareas por hilo: suficiente para repartir la carga sin pagar
+  // una tarea por chunk
+  const uint32_t numChunks = uint32_t(target.chunks.size());
+  const uint32_t numThreads = uint32_t(m_workers.size()) + 1;
+  const uint32_t perTask = numChunks > numThreads * 2 ? numChunks / (numThreads * 2) : 1;
+  target.tasksLeft = (numChunks + perTask - 1) / perTask;
+  for (uint32_t begin = 0; begin < numChunks; begin += perTask) {
+    pushTaskLocked(system, begin, begin + perTask < numChunks ? begin + perTask : numChunks);
+  }
+}
+
+void
+SystemScheduler::pushTaskLocked(uint32_t system, uint32_t begin, uint32_t end) {
+  System& target = m_systems[system];
+  const uint32_t index = target.numTasks++;
+  if (target.commands.size() <= index) {
+    target.commands.push_back(EU::MakeUnique<CommandBuffer>());
+  }
+  m_tasks.push_back(Task{ system, index, begin, end });
+}
+
+void
+SystemScheduler::completeLocked(uint32_t system) {
+  --m_systemsLeft;
+  for (uint32_t dependent : m_systems[system].dependents) {
+    if (--m_systems[dependent].dependenciesLeft == 0) {
+      dispatchLocked(dependent);
+    }
+  }
+  m_signal.notify_all();
+}
@@ -6,19 +6,21 @@ Transform::init() {
     scale.one();
 
     matrix = XMMatrixIdentity();
+    dirty = true;
 }
 
 void
 Transform::update(float deltaTime) {
-    // Aplicar escala
-    XMMATRIX scaleMatrix = XMMatrixScaling(scale.x, scale.y, scale.z);
-    // Aplicar rotacion
-    XMMATRIX rotationMatrix = XMMatrixRotationRollPitchYaw(rotation.x, rotation.y, rotation.z);
-    // Aplicar traslacion
-    XMMATRIX translationMatrix = XMMatrixTranslation(position.x, position.y, position.z);
+    // Objetos estáticos: nada que recomponer
+    if (!dirty) {
+        return;
+    }
 
     // Componer la matriz final en el orden: scale -> rotation -> translation
-    matrix = scaleMatrix * rotationMatrix * translationMatrix;
+    // La rotación viene del cuaternión, así que no se evalúa trigonometría por frame.
+    matrix = toXMMATRIX(EU::Matrix4x4::compose(position, orientation, scale));
+    dirty = false;
+    ++version;
 }
 
 void 
@@ -26,6 +28,6 @@ Transform::setTransform(const EU::Vector3& newPos,
                                                 const EU::Vector3& newRot, 
                                                 const EU::Vector3& newSca) { 
     position = newPos;
-    rotation = newRot;
     scale = newSca;
+    setRotation(newRot);  // Marca la matriz como sucia
 }
\ No newline at end of file
@@ -0,0 +1,316 @@
+﻿#include "ECS\TransformHierarchy.h"
+#include <algorithm>
+
+namespace {
+  // Quita count elementos a partir de first conservando el orden del resto
+  template<typename T>
+  void
+  eraseRange(EU::TArray<T>& values, uint32_t first, uint32_t count) {
+    std::move(values.begin() + first + count, values.end(), values.begin() + first);
+    values.SetNum(values.Num() - count);
+  }
+
+  // values[k] = values[order[k]]
+  template<typename T>
+  void
+  permute(EU::TArray<T>& values, const EU::TArray<uint32_t>& order) {
+    EU::TArray<T> sorted;
+    sorted.Reserve(order.Num());
+    for (uint32_t oldIndex : order) {
+      sorted.Add(std::move(values[oldIndex]));
+    }
+    values = std::move(sorted);
+  }
+}
+
+TransformNodeId
+TransformHierarchy::createNode(TransformNodeId parent,
+                               const EU::Vector3& position,
+                               const EU::Quaternion& orientation,
+                               const EU::Vector3& scale) {
+  assert((!parent.IsSet() || isValid(parent)) && "TransformHierarchy::createNode: invalid parent");
+
+  const uint32_t index = uint32_t(m_id.Num());
+  const uint32_t parentIndex = parent.IsSet() ? indexOf(parent) : NONE;
+
+  TransformNodeId node = m_indexOf.Insert(TransformNodeSlot{ index });
+  m_id.Add(node);
+  m_parent.Add(parentIndex);
+  m_subtreeSize.Add(1);
+  m_position.Add(position);
+  m_orientation.Add(orientation);
+  m_scale.Add(scale);
+  m_local.Emplace();
+  m_world.Emplace();
+  m_worldVersion.Add(0);
+  m_localDirty.Add(1);
+  m_worldChanged.Add(0);
+
+  if (parentIndex != NONE) {
+    // Si el subárbol del padre acaba al final de los arreglos, añadir al
+    // final conserva el orden de profundidad (el caso de un cargador que
+    // recorre la escena en profundidad); si no, se reordena en el update
+    if (!m_orderDirty && parentIndex + m_subtreeSize[parentIndex] == index) {
+      for (uint32_t a = parentIndex; a != NONE; a = m_parent[a]) {
+        ++m_subtreeSize[a];
+      }
+    }
+    else {
+      m_orderDirty = true;
+    }
+  }
+
+  markDirty(index);
+  return node;
+}
+
+void
+TransformHierarchy::destroyNode(TransformNodeId node) {
+  if (!isValid(node)) {
+    return;
+  }
+  ensureOrder();
+
+  const uint32_t first = indexOf(node);
+  const uint32_t count = m_subtreeSize[first];
+  const uint32_t end = first + count;
+
+  for (uint32_t a = m_parent[first]; a != NONE; a = m_parent[a]) {
+    m_subtreeSize[a] -= count;
+  }
+  for (uint32_t i = first; i < end; ++i) {
+    m_indexOf.Remove(m_id[i]);
+  }
+
+  eraseRange(m_id, first, count);
+  eraseRange(m_parent, first, count);
+  eraseRange(m_subtreeSize, first, count);
+  eraseRange(m_position, first, count);
+  eraseRange(m_orientation, first, count);
+  eraseRange(m_scale, first, count);
+  eraseRange(m_local, first, count);
+  eraseRange(m_world, first, count);
+  eraseRange(m_worldVersion, first, count);
+  eraseRange(m_localDirty, first, count);
+  eraseRange(m_worldChanged, first, count);
+
+  // Los nodos posteriores bajan count posiciones; ninguno tenía como padre
+  // a un nodo del subárbol borrado
+  for (uint32_t i = first; i < uint32_t(m_id.Num()); ++i) {
+    if (m_parent[i] != NONE && m_parent[i] >= end) {
+      m_parent[i] -= count;
+    }
+    m_indexOf.GetUnchecked(m_id[i]).index = i;
+  }
+
+  if (m_firstDirty != NONE && m_firstDirty >= first) {
+    m_firstDirty = m_firstDirty >= end ? m_firstDirty - count : first;
+  }
+}
+
+void
+TransformHierarchy::setParent(TransformNodeId node, TransformNodeId parent) {
+  assert(isValid(node) && "TransformHierarchy::setParent: invalid node");
+  assert((!parent.IsSet() || isValid(parent)) && "TransformHierarchy::setParent: invalid parent");
+  ensureOrder();
+
+  const uint32_t index = indexOf(node);
+  const uint32_t parentIndex = parent.IsSet() ? indexOf(parent) : NONE;
+  assert((parentIndex == NONE || parentIndex < index || parentIndex >= index + m_subtreeSize[index]) &&
+         "TransformHierarchy::setParent: a node cannot be parented to its own subtree");
+
+  if (m_parent[index] == parentIndex) {
+    return;
+  }
+  m_parent[index] = parentIndex;
+  m_orderDirty = true;
+  markDirty(index);
+}
+
+TransformNodeId
+TransformHierarchy::getParent(TransformNodeId node) const {
+  const uint32_t parentIndex = m_parent[indexOf(node)];
+  return parentIndex == NONE ? TransformNodeId() : m_id[parentIndex];
+}
+
+void
+TransformHierarchy::clear() {
+  m_indexOf.Empty();
+  m_id.Empty();
+  m_parent.Empty();
+  m_subtreeSize.Empty();
+  m_position.Empty();
+  m_orientation.Empty();
+  m_scale.Empty();
+  m_local.Empty();
+  m_world.Empty();
+  m_worldVersion.Empty();
+  m_localDirty.Empty();
+  m_worldChanged.Empty();
+  m_firstDirty = NONE;
+  m_orderDirty = false;
+}
+
+void
+TransformHierarchy::setLocalTransform(TransformNodeId node,
+                                      const EU::Vector3& position,
+                                      const EU::Quaternion& orientation,
+                                      const EU::Vector3& scale) {
+  const uint32_t index = indexOf(node);
+  m_position[index] = position;
+  m_orientation[index] = orientation;
+  m_scale[index] = scale;
+  markDirty(index);
+}
+
+void
+TransformHierarchy::setLocalPosition(TransformNodeId node, const EU::Vector3& position) {
+  const uint32_t index = indexOf(node);
+  m_position[index] = position;
+  markDirty(index);
+}
+
+void
+TransformHierarchy::setLocalOrientation(TransformNodeId node, const EU::Quaternion& orientation) {
+  const uint32_t index = indexOf(node);
+  m_orientation[index] = orientation;
+  markDirty(index);
+}
+
+void
+TransformHierarchy::setLocalScale(TransformNodeId node, const EU::Vector3& scale) {
+  const uint32_t index = indexOf(node);
+  m_scale[index] = scale;
+  markDirty(index);
+}
+
+void
+TransformHierarchy::update() {
+  ensureOrder();
+  if (m_firstDirty == NONE) {
+    return;
+  }
+
+  // Los padres siempre van antes que sus hijos: al llegar a un nodo su padre
+  // ya está resuelto. Los nodos anteriores a m_firstDirty no cambian.
+  const uint32_t first = m_firstDirty;
+  const uint32_t numNodes = uint32_t(m_id.Num());
+  for (uint32_t i = first; i < numNodes; ++i) {
+    const uint32_t parentIndex = m_parent[i];
+    const bool parentChanged = parentIndex != NONE && m_worldChanged[parentIndex];
+    if (!m_localDirty[i] && !parentChanged) {
+      continue;
+    }
+
+    if (m_localDirty[i]) {
+      m_local[i] = EU::Matrix4x4::compose(m_position[i], m_orientation[i], m_scale[i]);
+      m_localDirty[i] = 0;
+    }
+    // Vectores fila: primero lo local, luego el padre
+    m_world[i] = parentIndex == NONE ? m_local[i] : m_local[i] * m_world[parentIndex];
+    m_worldChanged[i] = 1;
+    ++m_worldVersion[i];
+  }
+
+  std::fill(m_worldChanged.begin() + first, m_worldChanged.end(), uint8_t(0));
+  m_firstDirty = NONE;
+}
+
+void
+TransformHierarchy::markDirty(uint32_t index) {
+  m_localDirty[index] = 1;
+  if (index < m_firstDirty) {
+    m_firstDirty = index;
+  }
+}
+
+void
+TransformHierarchy::ensureOrder() {
+  if (!m_orderDirty) {
+    return;
+  }
+  m_orderDirty = false;
+
+  // Hijos de cada nodo (primer hijo / siguiente hermano), en el orden actual
+  const uint32_t numNodes = uint32_t(m_id.Num());
+  EU::TArray<uint32_t> firstChild;
+  EU::TArray<uint32_t> lastChild;
+  EU::TArray<uint32_t> nextSibling;
+  firstChild.SetNum(numNodes);
+  lastChild.SetNum(numNodes);
+  nextSibling.SetNum(numNodes);
+  std::fill(firstChild.begin(), firstChild.end(), NONE);
+  std::fill(nextSibling.begin(), nextSibling.end(), NONE);
+  for (uint32_t i = 0; i < numNodes; ++i) {
+    const uint32_t parentIndex = m_parent[i];
+    if (parentIndex == NONE) {
+      continue;
+    }
+    if (firstChild[parentIndex] == NONE) {
+      firstChild[parentIndex] = i;
+    }
+    else {
+      nextSibling[lastChild[parentIndex]] = i;
+    }
+    lastChild[parentIndex] = i;
+  }
+
+  // Recorrido en profundidad desde cada raíz: order[k] = índice viejo del nodo k
+  EU::TArray<uint32_t> order;
+  order.Reserve(numNodes);
+  for (uint32_t root = 0; root < numNodes; ++root) {
+    if (m_parent[root] != NONE) {
+      continue;
+    }
+    uint32_t current = root;
+    for (;;) {
+      order.Add(current);
+      if (firstChild[current] != NONE) {
+        current = firstChild[current];
+        continue;
+      }
+      while (current != root && nextSibling[current] == NONE) {
+        current = m_parent[current];
+      }
+      if (current == root) {
+        break;
+      }
+      current = nextSibling[current];
+    }
+  }
+  assert(order.Num() == numNodes && "TransformHierarchy: cycle in the hierarchy");
+
+  EU::TArray<uint32_t> newIndex;
+  newIndex.SetNum(numNodes);
+  for (uint32_t k = 0; k < numNodes; ++k) {
+    newIndex[order[k]] = k;
+  }
+
+  permute(m_id, order);
+  permute(m_parent, order);
+  permute(m_position, order);
+  permute(m_orientation, order);
+  permute(m_scale, order);
+  permute(m_local, order);
+  permute(m_world, order);
+  permute(m_worldVersion, order);
+  permute(m_localDirty, order);
+
+  // Padres, tamaños de subárbol (de atrás hacia delante) e índices de los handles
+  m_firstDirty = NONE;
+  std::fill(m_subtreeSize.begin(), m_subtreeSize.end(), 1u);
+  for (uint32_t k = 0; k < numNodes; ++k) {
+    if (m_parent[k] != NONE) {
+      m_parent[k] = newIndex[m_parent[k]];
+    }
+    m_indexOf.GetUnchecked(m_id[k]).index = k;
+    if (m_localDirty[k] && m_firstDirty == NONE) {
+      m_firstDirty = k;
+    }
+  }
+  for (uint32_t k = numNodes; k-- > 0;) {
+    if (m_parent[k] != NONE) {
+      m_subtreeSize[m_parent[k]] += m_subtreeSize[k];
+    }
+  }
+}
@@ -0,0 +1,272 @@
+﻿#include "ECS\World.h"
+
+World::World() {
+  // Arquetipo vacío: toda entidad nace en él
+  findOrCreateArchetype(EU::TArray<const ComponentTypeInfo*>());
+}
+
+World::~World() {
+  for (Archetype* archetype : m_archetypes) {
+    delete archetype;
+  }
+}
+
+EntityId
+World::createEntity() {
+  EntityRecord record = { m_archetypes[0], 0, 0 };
+  EntityId entity = m_entities.Insert(record);
+  m_entities.Get(entity)->row = m_archetypes[0]->allocateRow(entity);
+  return entity;
+}
+
+void
+World::destroyEntity(EntityId entity) {
+  EntityRecord* record = m_entities.Get(entity);
+  if (!record) {
+    return;
+  }
+
+  Archetype* archetype = record->archetype;
+  const EU::TArray<Archetype::Column>& columns = archetype->getColumns();
+  if (record->mask & m_observedTypes[int(ComponentEvent::Removed)]) {
+    for (int c = 0; c < int(columns.Num()); ++c) {
+      notify(ComponentEvent::Removed, columns[c].info->id, entity, archetype->getComponentData(record->row, c));
+    }
+  }
+  for (int c = 0; c < int(columns.Num()); ++c) {
+    columns[c].info->destroy(archetype->getComponentData(record->row, c));
+  }
+
+  EntityId moved = archetype->removeRow(record->row);
+  if (moved.IsSet()) {
+    m_entities.Get(moved)->row = record->row;
+  }
+  m_entities.Remove(entity);
+}
+
+bool
+World::addComponentMoved(EntityId entity, const ComponentTypeInfo& info, void* value) {
+  EntityRecord* record = m_entities.Get(entity);
+  if (!record) {
+    return false;
+  }
+
+  Archetype* archetype = record->archetype;
+  if (record->mask & (ComponentMask(1) << info.id)) {
+    // Reemplazo: el valor anterior se destruye y el nuevo ocupa su lugar
+    const int column = archetype->findColumn(info.id);
+    void* component = archetype->getComponentData(record->row, column);
+    info.destroy(component);
+    info.moveConstruct(component, value);
+    archetype->markRowChanged(record->row, column, m_changeTick);
+    return true;
+  }
+
+  Archetype* target = getArchetypeWith(archetype, info);
+  moveEntity(*record, target);
+  const int column = target->findColumn(info.id);
+  void* component = target->getComponentData(record->row, column);
+  info.moveConstruct(component, value);
+  target->markRowAdded(record->row, column, m_changeTick);
+  notify(ComponentEvent::Added, info.id, entity, component);
+  return true;
+}
+
+bool
+World::removeComponent(EntityId entity, ComponentTypeId type) {
+  EntityRecord* record = m_entities.Get(entity);
+  if (!record || !(record->mask & (ComponentMask(1) << type))) {
+    return false;
+  }
+  notify(ComponentEvent::Removed, type, entity,
+         record->archetype->getComponentData(record->row, record->archetype->findColumn(type)));
+  moveEntity(*record, getArchetypeWithout(record->archetype, type));
+  return true;
+}
+
+World::ObserverId
+World::addObserver(ComponentEvent event, ComponentTypeId type, ObserverFn fn) {
+  Observer observer = { m_nextObserverId++, event, type, std::move(fn) };
+  m_observers.Add(std::move(observer));
+  m_observedTypes[int(event)] |= ComponentMask(1) << type;
+  return m_observers.Last().id;
+}
+
+void
+World::removeObserver(ObserverId id) {
+  for (size_t i = 0; i < m_observers.Num(); ++i) {
+    if (m_observers[i].id == id) {
+      m_observers.RemoveAt(i);
+      break;
+    }
+  }
+
+  for (ComponentMask& mask : m_observedTypes) {
+    mask = 0;
+  }
+  for (const Observer& observer : m_observers) {
+    m_observedTypes[int(observer.event)] |= ComponentMask(1) << observer.type;
+  }
+}
+
+void
+World::advanceTick() {
+  if (m_observedTypes[int(ComponentEvent::Changed)]) {
+    notifyChanged();
+  }
+  m_notifiedTick = m_changeTick;
+  ++m_changeTick;
+}
+
+void
+World::notifyObservers(ComponentEvent event, ComponentTypeId type, EntityId entity, void* component) {
+  for (Observer& observer : m_observers) {
+    if (observer.event == event && observer.type == type) {
+      observer.fn(entity, component);
+    }
+  }
+}
+
+void
+World::notifyChanged() {
+  for (Observer& observer : m_observers) {
+    if (observer.event != ComponentEvent::Changed) {
+      continue;
+    }
+    for (Archetype* archetype : m_archetypes) {
+      const int column = archetype->findColumn(observer.type);
+      if (column < 0) {
+        continue;
+      }
+      const uint32_t size = archetype->getColumns()[column].info->size;
+      for (size_t c = 0; c < archetype->getNumChunks(); ++c) {
+        // Chunks sin escrituras desde el último aviso: ni se miran sus filas
+        if (archetype->getChangeTick(c, column) <= m_notifiedTick) {
+          continue;
+        }
+        const EntityId* entities = archetype->getEntities(c);
+        const uint32_t* ticks = archetype->getRowChangeTicks(c, column);
+        unsigned char* data = archetype->getColumnData<unsigned char>(c, column);
+        for (uint32_t i = 0; i < archetype->getChunk(c).count; ++i) {
+          if (ticks[i] > m_notifiedTick) {
+            observer.fn(entities[i], data + size_t(i) * size);
+          }
+        }
+      }
+    }
+  }
+}
+
+uint32_t
+World::findOrCreateQueryCache(ComponentMask required, ComponentMask excluded) {
+  for (uint32_t i = 0; i < m_queryCaches.Num(); ++i) {
+    if (m_queryCaches[i].required == required && m_queryCaches[i].excluded == excluded) {
+      return i;
+    }
+  }
+  QueryCache cache;
+  cache.required = required;
+  cache.excluded = excluded;
+  cache.numChecked = 0;
+  return uint32_t(m_queryCaches.Add(std::move(cache)));
+}
+
+const EU::TArray<Archetype*>&
+World::getMatchingArchetypes(uint32_t cacheIndex) {
+  QueryCache& cache = m_queryCaches[cacheIndex];
+  for (; cache.numChecked < m_archetypes.Num(); ++cache.numChecked) {
+    Archetype* archetype = m_archetypes[cache.numChecked];
+    const ComponentMask mask = archetype->getMask();
+    if ((mask & cache.required) == cache.required && !(mask & cache.excluded)) {
+      cache.archetypes.Add(archetype);
+    }
+  }
+  return cache.archetypes;
+}
+
+Archetype*
+World::getArchetypeWith(Archetype* from, const ComponentTypeInfo& info) {
+  if (Archetype* edge = from->addEdges[info.id]) {
+    return edge;
+  }
+
+  EU::TArray<const ComponentTypeInfo*> types;
+  bool inserted = false;
+  for (const Archetype::Column& column : from->getColumns()) {
+    if (!inserted && info.id < column.info->id) {
+      types.Add(&info);
+      inserted = true;
+    }
+    types.Add(column.info);
+  }
+  if (!inserted) {
+    types.Add(&info);
+  }
+
+  Archetype* target = findOrCreateArchetype(types);
+  from->addEdges[info.id] = target;
+  target->removeEdges[info.id] = from;
+  return target;
+}
+
+Archetype*
+World::getArchetypeWithout(Archetype* from, ComponentTypeId id) {
+  if (Archetype* edge = from->removeEdges[id]) {
+    return edge;
+  }
+
+  EU::TArray<const ComponentTypeInfo*> types;
+  for (const Archetype::Column& column : from->getColumns()) {
+    if (column.info->id != id) {
+      types.Add(column.info);
+    }
+  }
+
+  Archetype* target = findOrCreateArchetype(types);
+  from->removeEdges[id] = target;
+  target->addEdges[id] = from;
+  return target;
+}
+
+Archetype*
+World::findOrCreateArchetype(const EU::TArray<const ComponentTypeInfo*>& types) {
+  ComponentMask mask = 0;
+  for (const ComponentTypeInfo* info : types) {
+    mask |= ComponentMask(1) << info->id;
+  }
+  if (Archetype** existing = m_archetypeByMask.Find(mask)) {
+    return *existing;
+  }
+
+  Archetype* archetype = new Archetype(types);
+  m_archetypes.Add(archetype);
+  m_archetypeByMask.Add(mask, archetype);
+  return archetype;
+}
+
+void
+World::moveEntity(EntityRecord& record, Archetype* target) {
+  Archetype* source = record.archetype;
+  const uint32_t sourceRow = record.row;
+  const EntityId entity = source->getEntity(sourceRow);
+  const uint32_t targetRow = target->allocateRow(entity);
+
+  const EU::TArray<Archetype::Column>& columns = source->getColumns();
+  for (int c = 0; c < int(columns.Num()); ++c) {
+    void* src = source->getComponentData(sourceRow, c);
+    const int targetColumn = target->findColumn(columns[c].info->id);
+    if (targetColumn >= 0) {
+      columns[c].info->moveConstruct(target->getComponentData(targetRow, targetColumn), src);
+      target->copyRowTicks(targetRow, targetColumn, *source, sourceRow, c);
+    }
+    columns[c].info->destroy(src);
+  }
+
+  EntityId moved = source->removeRow(sourceRow);
+  if (moved.IsSet()) {
+    m_entities.Get(moved)->row = sourceRow;
+  }
+  record.archetype = target;
+  record.row = targetRow;
+  record.mask = target->getMask();
+}
@@ -3,6 +3,7 @@
 
 MeshComponent
 ModelLoader::LoadOBJModel(const std::string& filePath) {
+    EU::MemoryTagScope memoryTag(EU::EMemoryTag::Loader);
     MeshComponent mesh;
     objl::Loader loader;
 
@@ -39,7 +40,7 @@ ModelLoader::LoadOBJModel(const std::string& filePath) {
 bool
 ModelLoader::InitializeFBXManager() {
     // Initialize the FBX SDK manager
-    lSdkManager = FbxManager::Create();
+    lSdkManager.reset(FbxManager::Create());
     if (!lSdkManager) {
         ERROR("ModelLoader", "FbxManager::Create()", "Unable to create FBX Manager!");
         return false;
@@ -48,11 +49,11 @@ ModelLoader::InitializeFBXManager() {
     }
 
     // Create an IOSettings object
-    FbxIOSettings* ios = FbxIOSettings::Create(lSdkManager, IOSROOT);
+    FbxIOSettings* ios = FbxIOSettings::Create(lSdkManager.get(), IOSROOT);
     lSdkManager->SetIOSettings(ios);
 
     // Create an FBX Scene
-    lScene = FbxScene::Create(lSdkManager, "MyScene");
+    lScene = FbxScene::Create(lSdkManager.get(), "MyScene");
     if (!lScene) {
         ERROR("ModelLoader", "FbxScene::Create()", "Unable to create FBX Scene!");
         return false;
@@ -64,10 +65,13 @@ ModelLoader::InitializeFBXManager() {
 
 bool
 ModelLoader::LoadFBXModel(const std::string& filePath) {
+    // Todo lo que reserve la carga (SDK incluido) cuenta como Loader
+    EU::MemoryTagScope memoryTag(EU::EMemoryTag::Loader);
+
     // 01. Initialize the SDK from FBX Manager
     if (InitializeFBXManager()) {
         // 02. Create an importer using the SDK manager
-        FbxImporter* lImporter = FbxImporter::Create(lSdkManager, "");
+        EU::TUniquePtr<FbxImporter, FbxDestroyer> lImporter(FbxImporter::Create(lSdkManager.get(), ""));
         if (!lImporter) {
             ERROR("ModelLoader", "FbxImporter::Create()", "Unable to create FBX Importer!");
             return false;
@@ -79,7 +83,6 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
         if (!lImporter->Initialize(filePath.c_str(), -1, lSdkManager->GetIOSettings())) {
             ERROR("ModelLoader", "FbxImporter::Initialize()",
                   "Unable to initialize FBX Importer! Error: " << lImporter->GetStatus().GetErrorString());
-            lImporter->Destroy();
             return false;
         } else {
             MESSAGE("ModelLoader", "ModelLoader", "FBX Importer initialized successfully.");
@@ -89,7 +92,6 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
         if (!lImporter->Import(lScene)) {
             ERROR("ModelLoader", "FbxImporter::Import()",
                   "Unable to import FBX Scene! Error: " << lImporter->GetStatus().GetErrorString());
-            lImporter->Destroy();
             return false;
         } else {
             MESSAGE("ModelLoader", "ModelLoader", "FBX Scene imported successfully.");
@@ -97,7 +99,7 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
         }
 
         // 05. Destroy the importer
-        lImporter->Destroy();
+        lImporter.reset();
         MESSAGE("ModelLoader", "ModelLoader", "FBX Importer destroyed successfully.");
 
         // 06. Process the model from the scene
@@ -106,7 +108,7 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
         if (lRootNode) {
             MESSAGE("ModelLoader", "ModelLoader", "Processing model from the scene root node.");
             for (int i = 0; i < lRootNode->GetChildCount(); i++) {
-                ProcessFBXNode(lRootNode->GetChild(i));
+                ProcessFBXNode(lRootNode->GetChild(i), -1);
             }
             return true;
         } else {
@@ -119,22 +121,39 @@ ModelLoader::LoadFBXModel(const std::string& filePath) {
 }
 
 void
-ModelLoader::ProcessFBXNode(FbxNode* node) {
-    // 01. Process all the node's meshes
+ModelLoader::ProcessFBXNode(FbxNode* node, int parentIndex) {
+    // 01. Record the node with its local transform (relative to its parent)
+    FbxAMatrix localTransform = node->EvaluateLocalTransform();
+    FbxVector4 translation = localTransform.GetT();
+    FbxQuaternion rotation = localTransform.GetQ();
+    FbxVector4 scaling = localTransform.GetS();
+
+    ModelNode modelNode;
+    modelNode.name = node->GetName();
+    modelNode.parent = parentIndex;
+    modelNode.position = EU::Vector3(float(translation[0]), float(translation[1]), float(translation[2]));
+    modelNode.orientation = EU::Quaternion(float(rotation[3]), float(rotation[0]),
+                                           float(rotation[1]), float(rotation[2]));
+    modelNode.scale = EU::Vector3(float(scaling[0]), float(scaling[1]), float(scaling[2]));
+
+    const int nodeIndex = int(nodes.size());
+    nodes.push_back(modelNode);
+
+    // 02. Process all the node's meshes
     if (node->GetNodeAttribute()) {
         if (node->GetNodeAttribute()->GetAttributeType() == FbxNodeAttribute::eMesh) {
-            ProcessFBXMesh(node);
+            ProcessFBXMesh(node, nodeIndex);
         }
     }
 
-    // 02. Recursively process each child node
+    // 03. Recursively process each child node
     for (int i = 0; i < node->GetChildCount(); i++) {
-        ProcessFBXNode(node->GetChild(i));
+        ProcessFBXNode(node->GetChild(i), nodeIndex);
     }
 }
 
 void
-ModelLoader::ProcessFBXMesh(FbxNode* node) {
+ModelLoader::ProcessFBXMesh(FbxNode* node, int nodeIndex) {
     // 01. Get the mesh from the node. If there is no mesh, exit early.
     FbxMesh* mesh = node->GetMesh();
     if (!mesh)
@@ -205,6 +224,7 @@ ModelLoader::ProcessFBXMesh(FbxNode* node) {
     // 05. Create a MeshComponent and populate it with the processed data.
     MeshComponent meshData;
     meshData.m_name = node->GetName();
+    meshData.m_nodeIndex = nodeIndex;  // Los vértices quedan en el espacio local del nodo
     meshData.m_vertex = vertices;
     meshData.m_index = indices;
     meshData.m_numVertex = vertices.size();
@@ -3,7 +3,7 @@
 #include "DeviceContext.h"
 
 HRESULT
-Rasterizer::init(Device device) {
+Rasterizer::init(Device& device) {
     D3D11_RASTERIZER_DESC rasterizerDesc = {};
     rasterizerDesc.FillMode = D3D11_FILL_SOLID;
     rasterizerDesc.CullMode = D3D11_CULL_BACK;
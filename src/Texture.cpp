@@ -5,7 +5,8 @@
 #include "DeviceContext.h"
 
 HRESULT
-Texture::init(Device device, const std::string& textureName, ExtensionType extensionType) {
+Texture::init(Device& device, const std::string& textureName, ExtensionType extensionType) {
+    EU::MemoryTagScope memoryTag(EU::EMemoryTag::Texture);
     if (!device.m_device) {
         ERROR("Texture", "init", "Device is null.");
         return E_POINTER;
@@ -27,7 +28,7 @@ Texture::init(Device device, const std::string& textureName, ExtensionType exten
             m_textureName.c_str(),
             nullptr,
             nullptr,
-            &m_textureFromImg,
+            m_textureFromImg.releaseAndGetAddressOf(),
             nullptr
             );
 
@@ -80,7 +81,7 @@ Texture::init(Device device, const std::string& textureName, ExtensionType exten
         srvDesc.ViewDimension = D3D11_SRV_DIMENSION_TEXTURE2D;
         srvDesc.Texture2D.MipLevels = 1;
 
-        hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, &m_textureFromImg);
+        hr = device.m_device->CreateShaderResourceView(m_texture, &srvDesc, m_textureFromImg.releaseAndGetAddressOf());
         SAFE_RELEASE(m_texture); // Liberar textura intermedia
 
         if (FAILED(hr)) {
@@ -99,13 +100,14 @@ Texture::init(Device device, const std::string& textureName, ExtensionType exten
 }
 
 HRESULT
-Texture::init(Device device,
+Texture::init(Device& device,
               unsigned int width,
               unsigned int height,
               DXGI_FORMAT Format,
               unsigned int BindFlags,
               unsigned int sampleCount,
               unsigned int qualityLevels) {
+    EU::MemoryTagScope memoryTag(EU::EMemoryTag::Texture);
     if (!device.m_device) {
         ERROR("Texture", "init", "Device is null.");
         return E_POINTER;
@@ -143,6 +145,7 @@ Texture::init(Device device,
 
 HRESULT
 Texture::init(Device& device, Texture& textureRef, DXGI_FORMAT format) {
+    EU::MemoryTagScope memoryTag(EU::EMemoryTag::Texture);
     if (!device.m_device) {
         ERROR("Texture", "init", "Device is null.");
         return E_POINTER;
@@ -161,7 +164,7 @@ Texture::init(Device& device, Texture& textureRef, DXGI_FORMAT format) {
 
     HRESULT hr = device.m_device->CreateShaderResourceView(textureRef.m_texture,
                                                            &srvDesc,
-                                                           &m_textureFromImg);
+                                                           m_textureFromImg.releaseAndGetAddressOf());
 
     if (FAILED(hr)) {
         ERROR("Texture", "init",
@@ -188,14 +191,14 @@ Texture::render(DeviceContext& deviceContext,
     if (m_textureFromImg) {
         ID3D11ShaderResourceView* nullSRV[] = {nullptr};
         deviceContext.m_deviceContext->PSSetShaderResources(StartSlot, NumViews, nullSRV);
-        deviceContext.m_deviceContext->PSSetShaderResources(StartSlot, NumViews, &m_textureFromImg);
+        deviceContext.m_deviceContext->PSSetShaderResources(StartSlot, NumViews, m_textureFromImg.getAddressOf());
     }
 }
 
 void Texture::destroy() {
     if (m_texture != nullptr) {
         SAFE_RELEASE(m_texture);
-    } else if (m_textureFromImg != nullptr) {
-        SAFE_RELEASE(m_textureFromImg);
     }
+    // Suelta solo la referencia de esta copia; las demás siguen siendo válidas.
+    m_textureFromImg.reset();
 }
@@ -6,7 +6,6 @@
 class Transform;
 
 UserInterface::UserInterface() {
-    selectedActorIndex = 0;
 }
 
 UserInterface::~UserInterface() {
@@ -19,6 +18,13 @@ void UserInterface::init(void* window, ID3D11Device* device, ID3D11DeviceContext
     m_windowHandle = (HWND)window;
 
     IMGUI_CHECKVERSION();
+    // ImGui reserva con malloc; lo pasamos por operator new para contarlo como UI
+    ImGui::SetAllocatorFunctions(
+        [](size_t size, void*) -> void* {
+            EU::MemoryTagScope memoryTag(EU::EMemoryTag::UI);
+            return ::operator new(size, std::nothrow);
+        },
+        [](void* ptr, void*) { ::operator delete(ptr); });
     ImGui::CreateContext();
     ImGuiIO& io = ImGui::GetIO();
     (void)io;
@@ -40,7 +46,8 @@ void UserInterface::render() {
     ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
 }
 
-void UserInterface::vec3Control(const std::string& label, float* values, float resetValue, float columnWidth) {
+bool UserInterface::vec3Control(const std::string& label, float* values, float resetValue, float columnWidth) {
+    bool changed = false;
     ImGui::PushID(label.c_str());
 
     ImGui::Columns(2);
@@ -57,44 +64,51 @@ void UserInterface::vec3Control(const std::string& label, float* values, float r
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4{0.8f, 0.1f, 0.15f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.9f, 0.2f, 0.2f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.8f, 0.1f, 0.15f, 1.0f});
-    if (ImGui::Button("X", buttonSize))
+    if (ImGui::Button("X", buttonSize)) {
         values[0] = resetValue;
+        changed = true;
+    }
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##X", &values[0], 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##X", &values[0], 0.1f, 0.0f, 0.0f, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4{0.2f, 0.7f, 0.2f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.3f, 0.8f, 0.3f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.2f, 0.7f, 0.2f, 1.0f});
-    if (ImGui::Button("Y", buttonSize))
+    if (ImGui::Button("Y", buttonSize)) {
         values[1] = resetValue;
+        changed = true;
+    }
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##Y", &values[1], 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##Y", &values[1], 0.1f, 0.0f, 0.0f, "%.2f");
     ImGui::PopItemWidth();
     ImGui::SameLine();
 
     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4{0.1f, 0.25f, 0.8f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4{0.2f, 0.35f, 0.9f, 1.0f});
     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4{0.1f, 0.25f, 0.8f, 1.0f});
-    if (ImGui::Button("Z", buttonSize))
+    if (ImGui::Button("Z", buttonSize)) {
         values[2] = resetValue;
+        changed = true;
+    }
     ImGui::PopStyleColor(3);
 
     ImGui::SameLine();
-    ImGui::DragFloat("##Z", &values[2], 0.1f, 0.0f, 0.0f, "%.2f");
+    changed |= ImGui::DragFloat("##Z", &values[2], 0.1f, 0.0f, 0.0f, "%.2f");
     ImGui::PopItemWidth();
 
     ImGui::PopStyleVar();
     ImGui::Columns(1);
     ImGui::PopID();
+    return changed;
 }
 
-void UserInterface::floatControl(const std::string& label, float* value, float resetValue, float columnWidth) {
+bool UserInterface::floatControl(const std::string& label, float* value, float resetValue, float columnWidth) {
     ImGui::PushID(label.c_str());
 
     ImGui::Columns(2);
@@ -103,11 +117,12 @@ void UserInterface::floatControl(const std::string& label, float* value, float r
     ImGui::NextColumn();
 
     ImGui::PushItemWidth(-1.0f);
-    ImGui::DragFloat("##value", value, 0.001f, 0.0f, 0.0f, "%.3f");
+    const bool changed = ImGui::DragFloat("##value", value, 0.001f, 0.0f, 0.0f, "%.3f");
     ImGui::PopItemWidth();
 
     ImGui::Columns(1);
     ImGui::PopID();
+    return changed;
 }
 
 void UserInterface::mainMenuBar() {
@@ -174,7 +189,7 @@ void UserInterface::objectControlPanel(EU::TSharedPointer<Actor> actor) {
     ImGui::SetNextWindowSize(ImVec2(330, 500), ImGuiCond_FirstUseEver);
 
     if (ImGui::Begin("Object Controls", &showObjectControls)) {
-        ImGui::Text("Selected Object: Actor %d", selectedActorIndex);
+        ImGui::Text("Selected Object: Actor %u", selectedActor.GetIndex());
         ImGui::Separator();
 
         if (ImGui::CollapsingHeader("Transform", ImGuiTreeNodeFlags_DefaultOpen)) {
@@ -192,7 +207,7 @@ void UserInterface::objectControlPanel(EU::TSharedPointer<Actor> actor) {
         ImGui::Separator();
 
         if (ImGui::Button("Reset Transform", ImVec2(-1, 0))) {
-            auto transform = actor->getComponent<Transform>();
+            Transform* transform = actor->tryGetComponent<Transform>();
             if (transform) {
                 transform->setTransform(EU::Vector3(0.0f, 0.0f, 0.0f),
                                         EU::Vector3(0.0f, 0.0f, 0.0f),
@@ -205,17 +220,16 @@ void UserInterface::objectControlPanel(EU::TSharedPointer<Actor> actor) {
 }
 
 void UserInterface::transformControls(EU::TSharedPointer<Actor> actor) {
-    auto transform = actor->getComponent<Transform>();
+    Transform* transform = actor->tryGetComponent<Transform>();
     if (!transform)
         return;
 
     EU::Vector3 position = transform->getPosition();
     float positionArray[3] = {position.x, position.y, position.z};
 
-    vec3Control("Position", positionArray, 0.0f, 80.0f);
-
-    // Actualizar la posición si cambió
-    if (positionArray[0] != position.x || positionArray[1] != position.y || positionArray[2] != position.z) {
+    // Solo se escribe el Transform si el usuario editó algo: si no, la matriz
+    // no se reconstruye ni el actor vuelve a subir su constant buffer
+    if (vec3Control("Position", positionArray, 0.0f, 80.0f)) {
         transform->setPosition(EU::Vector3(positionArray[0], positionArray[1], positionArray[2]));
     }
 
@@ -225,17 +239,15 @@ void UserInterface::transformControls(EU::TSharedPointer<Actor> actor) {
 }
 
 void UserInterface::scaleControls(EU::TSharedPointer<Actor> actor) {
-    auto transform = actor->getComponent<Transform>();
+    Transform* transform = actor->tryGetComponent<Transform>();
     if (!transform)
         return;
 
     EU::Vector3 scale = transform->getScale();
     float scaleArray[3] = {scale.x, scale.y, scale.z};
 
-    vec3Control("Scale", scaleArray, 1.0f, 80.0f);
-
-    // Actualizar la escala si cambió
-    if (scaleArray[0] != scale.x || scaleArray[1] != scale.y || scaleArray[2] != scale.z) {
+    // Actualizar la escala solo si el usuario la editó
+    if (vec3Control("Scale", scaleArray, 1.0f, 80.0f)) {
         transform->setScale(EU::Vector3(scaleArray[0], scaleArray[1], scaleArray[2]));
     }
 
@@ -255,17 +267,15 @@ void UserInterface::scaleControls(EU::TSharedPointer<Actor> actor) {
 }
 
 void UserInterface::rotationControls(EU::TSharedPointer<Actor> actor) {
-    auto transform = actor->getComponent<Transform>();
+    Transform* transform = actor->tryGetComponent<Transform>();
     if (!transform)
         return;
 
     EU::Vector3 rotation = transform->getRotation();
     float rotationArray[3] = {rotation.x, rotation.y, rotation.z};
 
-    vec3Control("Rotation", rotationArray, 0.0f, 80.0f);
-
-    // Actualizar la rotación si cambió
-    if (rotationArray[0] != rotation.x || rotationArray[1] != rotation.y || rotationArray[2] != rotation.z) {
+    // Actualizar la rotación solo si el usuario la editó
+    if (vec3Control("Rotation", rotationArray, 0.0f, 80.0f)) {
         transform->setRotation(EU::Vector3(rotationArray[0], rotationArray[1], rotationArray[2]));
     }
 
@@ -485,25 +495,28 @@ void UserInterface::visualStudioStyle() {
     style.Colors[ImGuiCol_HeaderActive] = ImVec4(0.67f, 0.67f, 0.67f, 0.39f);
 }
 
-void UserInterface::outliner(const std::vector<EU::TSharedPointer<Actor>>& actors) {
+void UserInterface::outliner(const ActorMap& actors) {
     ImGui::SetNextWindowPos(ImVec2(10, 25), ImGuiCond_FirstUseEver);
     ImGui::SetNextWindowSize(ImVec2(250, 400), ImGuiCond_FirstUseEver);
 
     if (ImGui::Begin("Scene Outliner")) {
-        ImGui::Text("Scene Objects (%zu)", actors.size());
+        ImGui::Text("Scene Objects (%zu)", actors.Num());
         ImGui::Separator();
 
-        for (size_t i = 0; i < actors.size(); ++i) {
-            if (actors[i].isNull())
+        for (size_t i = 0; i < actors.Num(); ++i) {
+            if (actors.GetAt(i).isNull())
                 continue;
 
-            std::string actorName = "Actor " + std::to_string(i);
+            // El handle sigue identificando al actor aunque se eliminen otros
+            ActorMap::Handle handle = actors.GetHandleAt(i);
+            // Etiqueta temporal en la arena de frame: sin reservas del heap por fila
+            const char* actorName = EU::FrameFormat("Actor %u", handle.GetIndex());
 
             // Verificar si este actor está seleccionado
-            bool isSelected = (selectedActorIndex == static_cast<int>(i));
+            bool isSelected = (selectedActor == handle);
 
-            if (ImGui::Selectable(actorName.c_str(), isSelected)) {
-                selectedActorIndex = static_cast<int>(i);
+            if (ImGui::Selectable(actorName, isSelected)) {
+                selectedActor = handle;
             }
 
             if (ImGui::IsItemHovered()) {
@@ -513,7 +526,7 @@ void UserInterface::outliner(const std::vector<EU::TSharedPointer<Actor>>& actor
             // Mostrar información adicional del actor
             if (isSelected) {
                 ImGui::Indent();
-                auto transform = actors[i]->getComponent<Transform>();
+                Transform* transform = actors.GetAt(i)->tryGetComponent<Transform>();
                 if (transform) {
                     EU::Vector3 pos = transform->getPosition();
                     ImGui::Text("Position: (%.2f, %.2f, %.2f)", pos.x, pos.y, pos.z);
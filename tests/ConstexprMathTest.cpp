@@ -0,0 +1,98 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file ConstexprMathTest.cpp
+ * @brief Compile-time checks of the constexpr math in EngineUtilities.
+ *
+ * The checks are static_asserts, so building this file is the test; main()
+ * only reports it. Checks that go through the SIMD paths need
+ * EU_IS_CONSTANT_EVALUATED() and are skipped without EU_HAS_CONSTEXPR_SIMD.
+ */
+#include "EngineUtilities/Utilities/EngineMath.h"
+#include "EngineUtilities/Vectors/Vector3.h"
+#include "EngineUtilities/Vectors/Quaternion.h"
+#include "EngineUtilities/Matrix/Matrix3x3.h"
+#include "EngineUtilities/Matrix/Matrix4x4.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+  using namespace EU;
+
+  // EngineMath.h
+  static_assert(power(2.0f, 10) == 1024.0f && power(2.0f, -2) == 0.25f, "power");
+  static_assert(factorial(5) == 120, "factorial");
+  static_assert(lerp(2.0f, 4.0f, 0.5f) == 3.0f, "lerp");
+  static_assert(approxEqual(radians(180.0f), PI, 1.0e-6f), "radians");
+  static_assert(approxEqual(degrees(HALF_PI), 90.0f, 1.0e-4f), "degrees");
+  static_assert(floor(-1.5f) == -2.0f && ceil(1.25f) == 2.0f && round(-2.6f) == -3.0f, "rounding");
+#if EU_HAS_CONSTEXPR_SIMD
+  static_assert(EU::sqrt(16.0f) == 4.0f && approxEqual(EU::sqrt(2.0f), 1.41421356f, 1.0e-6f), "sqrt");
+#endif
+
+  // Vector3.h
+  static_assert(Vector3(1, 0, 0).cross(Vector3(0, 1, 0)).z == 1.0f, "Vector3::cross");
+  static_assert(Vector3(1, 2, 3).dot(Vector3(4, 5, 6)) == 32.0f, "Vector3::dot");
+  static_assert((Vector3(1, 2, 3) - Vector3(1, 1, 1) * 2.0f).z == 1.0f, "Vector3 operators");
+#if EU_HAS_CONSTEXPR_SIMD
+  static_assert(Vector3(0, 3, 4).magnitude() == 5.0f, "Vector3::magnitude");
+#endif
+
+  // Quaternion.h
+  static_assert((Quaternion(0, 1, 0, 0) * Quaternion(0, 0, 1, 0)) == Quaternion(0, 0, 0, 1), "i * j = k");
+  static_assert(Quaternion(1, 2, 3, 4).dot(Quaternion(1, 2, 3, 4).conjugate()) == -28.0f, "Quaternion::dot");
+#if EU_HAS_CONSTEXPR_SIMD
+  static_assert(Quaternion(0, 0, 1, 0).rotate(Vector3(1, 0, 0)).x == -1.0f, "Quaternion::rotate");
+#endif
+
+  // Matrix3x3.h
+  static_assert(Matrix3x3(2, 0, 0, 0, 4, 0, 0, 0, 8).inverse().m[2][2] == 0.125f, "Matrix3x3::inverse");
+  static_assert((Matrix3x3() * Matrix3x3(1, 2, 3, 4, 5, 6, 7, 8, 9)).m[1][2] == 6.0f, "Matrix3x3::operator*");
+
+  // Matrix4x4.h
+  static_assert(Matrix4x4::scaling(Vector3(2, 3, 4)).determinant() == 24.0f, "Matrix4x4::determinant");
+#if EU_HAS_CONSTEXPR_SIMD
+  static_assert((Matrix4x4::scaling(Vector3(2, 2, 2)) * Matrix4x4::translation(Vector3(1, 0, 0)))
+                  .transformPoint(Vector3(1, 0, 0)).x == 3.0f, "Matrix4x4::operator*");
+  static_assert(Matrix4x4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16).transpose().m[0][1] == 5.0f,
+                "Matrix4x4::transpose");
+  static_assert(Matrix4x4::rotation(Quaternion(0, 0, 1, 0)).transformVector(Vector3(1, 0, 0)).x == -1.0f,
+                "Matrix4x4::rotation");
+  static_assert(Matrix4x4::compose(Vector3(1, 2, 3), Quaternion(), Vector3(2, 2, 2))
+                  .transform(Vector4(1, 1, 1, 1)).y == 4.0f, "Matrix4x4::compose");
+#endif
+}
+
+int
+main() {
+  std::printf("constexpr math (%s): ok%s\n", SIMD::backendName(),
+              EU_HAS_CONSTEXPR_SIMD ? "" : ", SIMD-path checks skipped");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,259 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file EngineMathTest.cpp
+ * @brief Accuracy and throughput of the EngineMath.h / EngineMathSIMD.h
+ *        kernels against <cmath>.
+ *
+ * For every function it measures the largest absolute error and the largest
+ * error in ulps over a dense sweep of its range, fails if either exceeds the
+ * documented bound, and prints a timing table (ns per value) next to libm.
+ * Built once per SIMD backend by tests/Makefile.
+ */
+#include "EngineUtilities/Utilities/EngineMathSIMD.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+  const int NUM_SAMPLES = 1 << 20;
+  const double ULP_FLOOR = 1e-3;
+
+  using ScalarFn = float (*)(float);
+  using Float8Fn = EU::SIMD::Float8 (*)(EU::SIMD::Float8);
+  using ReferenceFn = double (*)(double);
+
+  /**
+   * @brief Distance in ulps between value and the float nearest to reference.
+   */
+  double
+  ulpError(float value, double reference) {
+    const float nearest = static_cast<float>(reference);
+    if (!std::isfinite(nearest)) {
+      return value == nearest ? 0.0 : 1e30;
+    }
+    const float next = std::nextafter(std::fabs(nearest), INFINITY);
+    const double ulp = static_cast<double>(next) - std::fabs(static_cast<double>(nearest));
+    return std::fabs(static_cast<double>(value) - reference) / ulp;
+  }
+
+  struct Errors {
+    double maxAbs = 0.0;
+    double maxUlp = 0.0;
+    float worstInput = 0.0f;
+  };
+
+  void
+  accumulate(Errors& errors, float input, float value, double reference) {
+    const double absError = std::fabs(static_cast<double>(value) - reference);
+    errors.maxAbs = absError > errors.maxAbs ? absError : errors.maxAbs;
+    if (std::fabs(reference) < ULP_FLOOR) {
+      return;
+    }
+    const double ulp = ulpError(value, reference);
+    if (ulp > errors.maxUlp) {
+      errors.maxUlp = ulp;
+      errors.worstInput = input;
+    }
+  }
+
+  template<typename Fn>
+  double
+  nanosecondsPerValue(const std::vector<float>& inputs, std::vector<float>& outputs, Fn&& fn) {
+    const auto start = std::chrono::steady_clock::now();
+    fn(inputs.data(), outputs.data(), inputs.size());
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / inputs.size();
+  }
+
+  /**
+   * @brief One row of the report: the function, its reference and input
+   *        range, and the largest errors allowed. Ulps are only counted where
+   *        |reference| >= ULP_FLOOR, since next to a root any absolute error
+   *        is a huge number of ulps. A bound of 0 skips that check.
+   */
+  struct Case {
+    const char* name;
+    ScalarFn scalar;
+    Float8Fn simd;        ///< nullptr if there is no vector version.
+    ReferenceFn reference;
+    float low;
+    float high;
+    double maxAbs;
+    double maxUlp;
+  };
+
+  double stdSin(double x) { return std::sin(x); }
+  double stdCos(double x) { return std::cos(x); }
+  double stdTan(double x) { return std::tan(x); }
+  double stdAsin(double x) { return std::asin(x); }
+  double stdAcos(double x) { return std::acos(x); }
+  double stdAtan(double x) { return std::atan(x); }
+  double stdExp(double x) { return std::exp(x); }
+  double stdLog(double x) { return std::log(x); }
+  double stdSqrt(double x) { return std::sqrt(x); }
+  double stdRsqrt(double x) { return 1.0 / std::sqrt(x); }
+
+  float euSin(float x) { return EU::sin(x); }
+  float euCos(float x) { return EU::cos(x); }
+  float euTan(float x) { return EU::tan(x); }
+  float euAsin(float x) { return EU::asin(x); }
+  float euAcos(float x) { return EU::acos(x); }
+  float euAtan(float x) { return EU::atan(x); }
+  float euExp(float x) { return EU::exp(x); }
+  float euLog(float x) { return EU::log(x); }
+  float euSqrt(float x) { return EU::sqrt(x); }
+  float euRsqrt(float x) { return EU::rsqrt(x); }
+  float euFastSin(float x) { return EU::fastSin(x); }
+  float euFastCos(float x) { return EU::fastCos(x); }
+  float euFastExp(float x) { return EU::fastExp(x); }
+  float euFastLog(float x) { return EU::fastLog(x); }
+  float euFastSqrt(float x) { return EU::fastSqrt(x); }
+
+  EU::SIMD::Float8 simdSin(EU::SIMD::Float8 x) { return EU::SIMD::sin(x); }
+  EU::SIMD::Float8 simdCos(EU::SIMD::Float8 x) { return EU::SIMD::cos(x); }
+  EU::SIMD::Float8 simdExp(EU::SIMD::Float8 x) { return EU::SIMD::exp(x); }
+  EU::SIMD::Float8 simdLog(EU::SIMD::Float8 x) { return EU::SIMD::log(x); }
+  EU::SIMD::Float8 simdFastSin(EU::SIMD::Float8 x) { return EU::SIMD::fastSin(x); }
+  EU::SIMD::Float8 simdFastCos(EU::SIMD::Float8 x) { return EU::SIMD::fastCos(x); }
+  EU::SIMD::Float8 simdFastExp(EU::SIMD::Float8 x) { return EU::SIMD::fastExp(x); }
+  EU::SIMD::Float8 simdFastLog(EU::SIMD::Float8 x) { return EU::SIMD::fastLog(x); }
+
+  // Bounds are the documented ones from EngineMath.h where it gives one
+  // (a relative error r is r / 2^-24 ulps at worst), otherwise the measured
+  // error of the slowest backend plus a small margin.
+  const Case CASES[] = {
+    { "sin",      euSin,      simdSin,     stdSin,   -100.0f,  100.0f, 1.0e-7, 2.0  },
+    { "cos",      euCos,      simdCos,     stdCos,   -100.0f,  100.0f, 1.0e-7, 2.0  },
+    { "tan",      euTan,      nullptr,     stdTan,   -1.5f,    1.5f,   0.0,    4.0  },
+    { "asin",     euAsin,     nullptr,     stdAsin,  -1.0f,    1.0f,   2.5e-7, 3.0  },
+    { "acos",     euAcos,     nullptr,     stdAcos,  -1.0f,    1.0f,   5.0e-7, 0.0  },
+    { "atan",     euAtan,     nullptr,     stdAtan,  -100.0f,  100.0f, 2.0e-7, 2.5  },
+    { "exp",      euExp,      simdExp,     stdExp,   -87.0f,   88.0f,  0.0,    1.5  },
+    { "log",      euLog,      simdLog,     stdLog,   0.01f,    100.0f, 3.0e-7, 1.0  },
+    { "sqrt",     euSqrt,     nullptr,     stdSqrt,  0.0f,     1000.0f, 0.0,   1.0  },
+    { "rsqrt",    euRsqrt,    nullptr,     stdRsqrt, 0.001f,   1000.0f, 0.0,   84.0 },
+    { "fastSin",  euFastSin,  simdFastSin, stdSin,   -100.0f,  100.0f, 2.0e-5, 0.0  },
+    { "fastCos",  euFastCos,  simdFastCos, stdCos,   -100.0f,  100.0f, 2.0e-5, 0.0  },
+    { "fastExp",  euFastExp,  simdFastExp, stdExp,   -87.0f,   88.0f,  0.0,    1678.0 },
+    { "fastLog",  euFastLog,  simdFastLog, stdLog,   0.01f,    100.0f, 1.0e-4, 0.0  },
+    { "fastSqrt", euFastSqrt, nullptr,     stdSqrt,  0.0f,     1000.0f, 0.0,   84.0 },
+  };
+
+  bool
+  checkErrors(const Case& c, const char* variant, const Errors& errors) {
+    bool ok = true;
+    if (c.maxAbs > 0.0 && errors.maxAbs > c.maxAbs) {
+      std::printf("FAIL %s %s: max abs error %.3g > %.3g\n",
+                  c.name, variant, errors.maxAbs, c.maxAbs);
+      ok = false;
+    }
+    if (c.maxUlp > 0.0 && errors.maxUlp > c.maxUlp) {
+      std::printf("FAIL %s %s: max error %.3g ulp > %.3g ulp (at x = %.9g)\n",
+                  c.name, variant, errors.maxUlp, c.maxUlp, errors.worstInput);
+      ok = false;
+    }
+    return ok;
+  }
+}
+
+int
+main() {
+  std::vector<float> inputs(NUM_SAMPLES);
+  std::vector<float> outputs(NUM_SAMPLES);
+  int failures = 0;
+
+  std::printf("EngineMath vs <cmath> (%s backend, %d samples per function)\n",
+              EU::SIMD::backendName(), NUM_SAMPLES);
+  std::printf("%-9s %11s %9s %11s %9s %10s %10s %10s\n",
+              "function", "abs", "ulp", "abs x8", "ulp x8",
+              "ns scalar", "ns x8", "ns libm");
+
+  for (const Case& c : CASES) {
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+      inputs[i] = c.low + (c.high - c.low) * (static_cast<double>(i) / (NUM_SAMPLES - 1));
+    }
+
+    const double nsScalar = nanosecondsPerValue(inputs, outputs,
+      [&](const float* in, float* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          out[i] = c.scalar(in[i]);
+        }
+      });
+    Errors scalarErrors;
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+      accumulate(scalarErrors, inputs[i], outputs[i], c.reference(inputs[i]));
+    }
+    failures += checkErrors(c, "scalar", scalarErrors) ? 0 : 1;
+
+    double nsSimd = 0.0;
+    Errors simdErrors;
+    if (c.simd) {
+      nsSimd = nanosecondsPerValue(inputs, outputs,
+        [&](const float* in, float* out, size_t count) {
+          for (size_t i = 0; i < count; i += 8) {
+            EU::SIMD::store(out + i, c.simd(EU::SIMD::load8(in + i)));
+          }
+        });
+      for (int i = 0; i < NUM_SAMPLES; ++i) {
+        accumulate(simdErrors, inputs[i], outputs[i], c.reference(inputs[i]));
+      }
+      failures += checkErrors(c, "x8", simdErrors) ? 0 : 1;
+    }
+
+    const double nsLibm = nanosecondsPerValue(inputs, outputs,
+      [&](const float* in, float* out, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+          out[i] = static_cast<float>(c.reference(in[i]));
+        }
+      });
+
+    if (c.simd) {
+      std::printf("%-9s %11.3g %9.3g %11.3g %9.3g %10.2f %10.2f %10.2f\n",
+                  c.name, scalarErrors.maxAbs, scalarErrors.maxUlp,
+                  simdErrors.maxAbs, simdErrors.maxUlp, nsScalar, nsSimd, nsLibm);
+    }
+    else {
+      std::printf("%-9s %11.3g %9.3g %11s %9s %10.2f %10s %10.2f\n",
+                  c.name, scalarErrors.maxAbs, scalarErrors.maxUlp,
+                  "-", "-", nsScalar, "-", nsLibm);
+    }
+  }
+
+  if (failures) {
+    std::printf("%d check(s) failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("all EngineMath checks passed\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file MemoryTrackerTest.cpp
+ * @brief Checks that the engine allocators report to MemoryTracker without
+ *        the global operator new hook (the non-Debug configuration): TArray's
+ *        default allocator, TPoolAllocator chunks and LinearArena blocks, plus
+ *        the TTaggedAllocator/TTrackedAllocator adapters.
+ *
+ * Exits with a non-zero status on failure.
+ */
+#include "EngineUtilities/Memory/LinearArena.h"
+#include "EngineUtilities/Memory/MemoryTracker.h"
+#include "EngineUtilities/Memory/TPoolAllocator.h"
+#include "EngineUtilities/Structures/TArray.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#if defined(EU_TRACK_GLOBAL_NEW)
+#error "MemoryTrackerTest checks the build without the global new hook"
+#endif
+
+namespace {
+  int g_failures = 0;
+
+  void
+  check(bool condition, const char* what, long long index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%lld]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  EU::MemoryTagStats
+  stats(EU::EMemoryTag tag) {
+    return EU::MemoryTracker::Get().GetStats(tag);
+  }
+
+  struct Particle {
+    float position[3];
+    float velocity[3];
+  };
+
+  void
+  testArray() {
+    const EU::MemoryTagStats before = stats(EU::EMemoryTag::Mesh);
+    {
+      EU::TArray<int> indices;
+      {
+        EU::MemoryTagScope tag(EU::EMemoryTag::Mesh);
+        indices.Reserve(1000);
+      }
+      const EU::MemoryTagStats during = stats(EU::EMemoryTag::Mesh);
+      check(during.LiveBytes - before.LiveBytes == 1000 * sizeof(int), "TArray bytes in the active tag");
+      check(during.LiveAllocations - before.LiveAllocations == 1, "TArray block count");
+
+      // Freed under another tag: still taken off the tag it was recorded in.
+      EU::MemoryTagScope tag(EU::EMemoryTag::UI);
+      indices.Empty();
+      indices.Shrink();
+    }
+    check(stats(EU::EMemoryTag::Mesh).LiveBytes == before.LiveBytes, "TArray free goes back to its tag");
+    check(stats(EU::EMemoryTag::UI).LiveBytes == 0, "TArray free does not touch the current tag");
+
+    EU::TInlineArray<int, 8> small;
+    {
+      EU::MemoryTagScope tag(EU::EMemoryTag::Mesh);
+      small.Add(1);
+    }
+    check(stats(EU::EMemoryTag::Mesh).LiveAllocations == before.LiveAllocations, "inline storage is not recorded");
+  }
+
+  void
+  testTaggedAllocator() {
+    EU::MemoryTagScope tag(EU::EMemoryTag::ECS);
+    const EU::MemoryTagStats ecsBefore = stats(EU::EMemoryTag::ECS);
+    {
+      EU::TArray<Particle, EU::TTaggedAllocator<Particle, EU::EMemoryTag::UI>> particles;
+      particles.Reserve(64);
+      check(stats(EU::EMemoryTag::UI).LiveBytes == 64 * sizeof(Particle), "TTaggedAllocator records its tag");
+      check(stats(EU::EMemoryTag::ECS).LiveBytes == ecsBefore.LiveBytes, "TTaggedAllocator is not counted twice");
+    }
+    check(stats(EU::EMemoryTag::UI).LiveBytes == 0, "TTaggedAllocator free");
+  }
+
+  void
+  testPool() {
+    const EU::MemoryTagStats before = stats(EU::EMemoryTag::Texture);
+    {
+      EU::TPoolAllocator<Particle, EU::ESPMode::NotThreadSafe> pool(32);
+      Particle* first;
+      {
+        EU::MemoryTagScope tag(EU::EMemoryTag::Texture);
+        first = pool.New();
+      }
+      const EU::MemoryTagStats grown = stats(EU::EMemoryTag::Texture);
+      check(grown.LiveBytes - before.LiveBytes >= int64_t(32 * sizeof(Particle)), "pool chunk recorded");
+      check(grown.LiveAllocations - before.LiveAllocations == 1, "one record per chunk");
+
+      // Objects out of an existing chunk cost nothing more.
+      Particle* second = pool.New();
+      check(stats(EU::EMemoryTag::Texture).TotalAllocations == grown.TotalAllocations, "pool reuse is not recorded");
+      pool.Delete(second);
+      pool.Delete(first);
+
+      // Wrapped in TTrackedAllocator: the objects are recorded, the chunk is not.
+      EU::TTrackedAllocator<EU::TPoolAllocator<Particle, EU::ESPMode::NotThreadSafe>> tracked(pool, EU::EMemoryTag::Loader);
+      void* objects[40];
+      for (int i = 0; i < 40; ++i) {
+        objects[i] = tracked.Allocate(sizeof(Particle), alignof(Particle));
+      }
+      check(stats(EU::EMemoryTag::Loader).LiveBytes == 40 * sizeof(Particle), "TTrackedAllocator objects");
+      check(stats(EU::EMemoryTag::Texture).LiveAllocations == grown.LiveAllocations, "wrapped chunk is not counted twice");
+      for (int i = 0; i < 40; ++i) {
+        tracked.Deallocate(objects[i], sizeof(Particle));
+      }
+      check(stats(EU::EMemoryTag::Loader).LiveBytes == 0, "TTrackedAllocator free");
+    }
+    check(stats(EU::EMemoryTag::Texture).LiveBytes == before.LiveBytes, "pool chunks freed");
+  }
+
+  void
+  testArena() {
+    EU::MemoryTagScope tag(EU::EMemoryTag::Loader);
+    const EU::MemoryTagStats before = stats(EU::EMemoryTag::Loader);
+    {
+      EU::LinearArena arena(1024);
+      check(stats(EU::EMemoryTag::Loader).LiveBytes - before.LiveBytes >= 1024, "arena first block");
+      arena.Allocate(4096);
+      check(stats(EU::EMemoryTag::Loader).LiveAllocations - before.LiveAllocations == 2, "arena grows by blocks");
+      arena.Reset();
+      check(stats(EU::EMemoryTag::Loader).LiveAllocations - before.LiveAllocations == 1, "arena Reset merges blocks");
+    }
+    check(stats(EU::EMemoryTag::Loader).LiveBytes == before.LiveBytes, "arena blocks freed");
+  }
+
+  void
+  testThreads() {
+    // Each thread records into the tag it has active.
+    std::thread worker([] {
+      EU::MemoryTagScope tag(EU::EMemoryTag::Texture);
+      EU::TArray<int> pixels;
+      pixels.Reserve(256);
+      check(stats(EU::EMemoryTag::Texture).LiveBytes >= int64_t(256 * sizeof(int)), "worker thread tag");
+    });
+    worker.join();
+    check(stats(EU::EMemoryTag::Texture).LiveBytes == 0, "worker thread free");
+  }
+
+  void
+  testReport() {
+    EU::MemoryTagScope tag(EU::EMemoryTag::Mesh);
+    EU::TArray<float> vertices;
+    vertices.Reserve(512);
+
+    FILE* out = std::tmpfile();
+    check(out != nullptr, "tmpfile");
+    if (!out) {
+      return;
+    }
+    EU::MemoryTracker::Get().WriteReport(out);
+    std::rewind(out);
+    char line[256];
+    bool meshRow = false;
+    while (std::fgets(line, sizeof(line), out)) {
+      char name[32];
+      long long live = 0;
+      if (std::sscanf(line, "%31s %lld", name, &live) == 2 && std::string(name) == "Mesh") {
+        meshRow = live >= static_cast<long long>(512 * sizeof(float));
+      }
+    }
+    std::fclose(out);
+    check(meshRow, "report shows non-zero Mesh bytes");
+  }
+}
+
+int
+main() {
+  testArray();
+  testTaggedAllocator();
+  testPool();
+  testArena();
+  testThreads();
+  testReport();
+
+  if (g_failures) {
+    std::printf("%d check(s) failed\n", g_failures);
+    return EXIT_FAILURE;
+  }
+  std::printf("MemoryTracker: ok\n");
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,246 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file PoolAllocatorTest.cpp
+ * @brief Checks TPoolAllocator (local pools, the global pool with its
+ *        per-thread caches, and frees during static destruction) and prints
+ *        the old new/delete vs pool timing.
+ *
+ * Exits with a non-zero status on failure. Timings are only reported, never
+ * checked.
+ */
+#include "EngineUtilities/Memory/TPoolAllocator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+  int g_failures = 0;
+  int g_alive = 0;
+
+  void
+  check(bool condition, const char* what, long long index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%lld]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  struct FakeComponent {
+    float position[3];
+    float rotation[4];
+    float scale[3];
+    int flags;
+  };
+
+  struct Counted {
+    int value;
+    explicit Counted(int inValue) : value(inValue) {
+      if (inValue < 0) {
+        throw std::runtime_error("negative");
+      }
+      ++g_alive;
+    }
+    ~Counted() { --g_alive; }
+  };
+
+  struct alignas(64) Aligned {
+    char bytes[80];
+  };
+
+  using Pool = EU::TPoolAllocator<FakeComponent>;
+
+  // Blocks a global releases from its destructor, after the main thread's
+  // thread_local cache is gone. Every block must still reach the pool.
+  struct LateOwner {
+    std::vector<void*> blocks;
+
+    ~LateOwner() {
+      for (void* block : blocks) {
+        Pool::Get().Deallocate(block);
+      }
+      if (Pool::Get().GetNumInUse() != 0) {
+        std::printf("FAILED: frees after the thread cache was destroyed [%zu]\n",
+                    Pool::Get().GetNumInUse());
+        std::fflush(stdout);
+        std::_Exit(EXIT_FAILURE);
+      }
+    }
+  } g_lateOwner;
+
+  template<typename PoolType>
+  void
+  testLocalPool(const char* what) {
+    PoolType pool(4);
+    std::vector<void*> blocks;
+    std::set<void*> unique;
+    for (int i = 0; i < 1000; ++i) {
+      void* block = pool.Allocate();
+      check(reinterpret_cast<uintptr_t>(block) % PoolType::SLOT_ALIGNMENT == 0, what, i);
+      blocks.push_back(block);
+      unique.insert(block);
+    }
+    check(unique.size() == blocks.size(), what);
+    check(pool.GetNumInUse() == 1000 && pool.GetCapacity() >= 1000, what);
+    const size_t capacity = pool.GetCapacity();
+    const size_t chunks = pool.GetNumChunks();
+
+    void* last = blocks.back();
+    pool.Deallocate(last);
+    check(pool.Allocate() == last, "freed blocks are reused LIFO");
+
+    for (void* block : blocks) {
+      pool.Deallocate(block);
+    }
+    check(pool.GetNumInUse() == 0, what);
+    for (int i = 0; i < 1000; ++i) {
+      blocks[i] = pool.Allocate();
+    }
+    check(pool.GetCapacity() == capacity && pool.GetNumChunks() == chunks, "no growth on reuse");
+    for (void* block : blocks) {
+      pool.Deallocate(block);
+    }
+  }
+
+  void
+  testNewDelete() {
+    EU::TPoolAllocator<Counted> pool;
+    Counted* object = pool.New(5);
+    check(object->value == 5 && g_alive == 1 && pool.GetNumInUse() == 1, "New constructs");
+    pool.Delete(object);
+    check(g_alive == 0 && pool.GetNumInUse() == 0, "Delete destroys and frees");
+
+    bool threw = false;
+    try {
+      pool.New(-1);
+    }
+    catch (const std::runtime_error&) {
+      threw = true;
+    }
+    check(threw && pool.GetNumInUse() == 0, "New returns the block when the constructor throws");
+
+    EU::TPoolAllocator<Aligned> alignedPool;
+    std::vector<void*> aligned;
+    for (int i = 0; i < 100; ++i) {
+      aligned.push_back(alignedPool.Allocate());
+      check(reinterpret_cast<uintptr_t>(aligned.back()) % 64 == 0, "over-aligned slots", i);
+    }
+    for (void* block : aligned) {
+      alignedPool.Deallocate(block);
+    }
+  }
+
+  // Each thread writes its id into its blocks, checks nobody else touched
+  // them and frees them; when the threads exit their caches go back too.
+  void
+  testGlobalPoolThreads() {
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.push_back(std::thread([t] {
+        std::vector<FakeComponent*> mine;
+        for (int round = 0; round < 50; ++round) {
+          for (int i = 0; i < 500; ++i) {
+            FakeComponent* component = static_cast<FakeComponent*>(Pool::Get().Allocate());
+            component->flags = t * 1000000 + i;
+            mine.push_back(component);
+          }
+          for (int i = 0; i < 500; ++i) {
+            check(mine[i]->flags == t * 1000000 + i, "block shared between threads", i);
+            Pool::Get().Deallocate(mine[i]);
+          }
+          mine.clear();
+        }
+      }));
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    check(Pool::Get().GetNumInUse() == 0, "thread caches return their blocks on exit",
+          static_cast<long long>(Pool::Get().GetNumInUse()));
+  }
+
+  void
+  benchmark() {
+    typedef std::chrono::steady_clock Clock;
+    const int COUNT = 50000;
+    std::vector<FakeComponent*> objects(COUNT);
+
+    Clock::time_point start = Clock::now();
+    for (int frame = 0; frame < 100; ++frame) {
+      for (int i = 0; i < COUNT; ++i) objects[i] = new FakeComponent();
+      for (int i = 0; i < COUNT; ++i) delete objects[i];
+    }
+    const double heapMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    EU::TPoolAllocator<FakeComponent, EU::ESPMode::NotThreadSafe> pool;
+    start = Clock::now();
+    for (int frame = 0; frame < 100; ++frame) {
+      for (int i = 0; i < COUNT; ++i) objects[i] = pool.New();
+      for (int i = 0; i < COUNT; ++i) pool.Delete(objects[i]);
+    }
+    const double poolMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int frame = 0; frame < 100; ++frame) {
+      for (int i = 0; i < COUNT; ++i) objects[i] = Pool::Get().New();
+      for (int i = 0; i < COUNT; ++i) Pool::Get().Delete(objects[i]);
+    }
+    const double globalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    check(pool.GetNumInUse() == 0 && pool.GetCapacity() >= static_cast<size_t>(COUNT), "benchmark pool");
+
+    std::printf("%d objects x 100 frames\n", COUNT);
+    std::printf("new/delete          %8.1f ms\n", heapMs);
+    std::printf("pool (one thread)   %8.1f ms  (%zu chunks)\n", poolMs, pool.GetNumChunks());
+    std::printf("global pool         %8.1f ms\n", globalMs);
+  }
+}
+
+int
+main() {
+  testLocalPool<EU::TPoolAllocator<FakeComponent>>("ThreadSafe local pool");
+  testLocalPool<EU::TPoolAllocator<FakeComponent, EU::ESPMode::NotThreadSafe>>("NotThreadSafe pool");
+  testNewDelete();
+  testGlobalPoolThreads();
+  benchmark();
+
+  // Taken by this thread's cache; g_lateOwner frees them at exit.
+  for (int i = 0; i < 100; ++i) {
+    g_lateOwner.blocks.push_back(Pool::Get().Allocate());
+  }
+
+  std::printf("TPoolAllocator: %s\n", g_failures == 0 ? "ok" : "FAILED");
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,271 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file SIMDTest.cpp
+ * @brief Checks the SIMD.h backends and the Matrix4x4 operators against plain
+ *        scalar reference math.
+ *
+ * Built once per backend by tests/Makefile (EU_SIMD_SCALAR, -msse2 and, if
+ * the CPU has it, -mavx2 -mfma). Exits with a non-zero status on failure.
+ */
+#include "EngineUtilities/Matrix/Matrix4x4.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace EU;
+
+namespace {
+  int g_failures = 0;
+
+  bool
+  nearlyEqual(float a, float b, float tolerance = 1e-5f) {
+    const float scale = std::fabs(a) > std::fabs(b) ? std::fabs(a) : std::fabs(b);
+    return std::fabs(a - b) <= tolerance * (scale > 1.0f ? scale : 1.0f);
+  }
+
+  void
+  check(bool condition, const char* what, int index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%d]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  void
+  checkLanes(const float* actual, const float* expected, int count, const char* what) {
+    for (int i = 0; i < count; ++i) {
+      check(nearlyEqual(actual[i], expected[i]), what, i);
+    }
+  }
+
+  // Deterministic values in [-range, range), never exactly zero.
+  float
+  nextValue(unsigned& state, float range = 10.0f) {
+    state = state * 1664525u + 1013904223u;
+    const float unit = float(state >> 8) / float(1u << 24);
+    const float value = (unit * 2.0f - 1.0f) * range;
+    return value == 0.0f ? 0.5f : value;
+  }
+
+  void
+  testFloat4(unsigned& state) {
+    EU_ALIGN16 float a[4], b[4], c[4], out[4], ref[4];
+    for (int i = 0; i < 4; ++i) {
+      a[i] = nextValue(state);
+      b[i] = nextValue(state);
+      c[i] = nextValue(state);
+    }
+    const SIMD::Float4 va = SIMD::load4(a), vb = SIMD::loadAligned4(b), vc = SIMD::load4(c);
+
+#define EU_CHECK_OP4(call, expr, name)                    \
+    SIMD::store(out, call);                               \
+    for (int i = 0; i < 4; ++i) { ref[i] = (expr); }      \
+    checkLanes(out, ref, 4, name);
+
+    EU_CHECK_OP4(SIMD::add(va, vb), a[i] + b[i], "Float4 add")
+    EU_CHECK_OP4(SIMD::sub(va, vb), a[i] - b[i], "Float4 sub")
+    EU_CHECK_OP4(SIMD::mul(va, vb), a[i] * b[i], "Float4 mul")
+    EU_CHECK_OP4(SIMD::div(va, vb), a[i] / b[i], "Float4 div")
+    EU_CHECK_OP4(SIMD::EMin(va, vb), a[i] < b[i] ? a[i] : b[i], "Float4 EMin")
+    EU_CHECK_OP4(SIMD::EMax(va, vb), a[i] > b[i] ? a[i] : b[i], "Float4 EMax")
+    EU_CHECK_OP4(SIMD::sqrt(SIMD::mul(va, va)), std::fabs(a[i]), "Float4 sqrt")
+    EU_CHECK_OP4(SIMD::madd(va, vb, vc), a[i] * b[i] + c[i], "Float4 madd")
+    EU_CHECK_OP4(SIMD::nmadd(va, vb, vc), c[i] - a[i] * b[i], "Float4 nmadd")
+    EU_CHECK_OP4(SIMD::splat4(a[2]), a[2], "Float4 splat4")
+    EU_CHECK_OP4(SIMD::splatLane<3>(va), a[3], "Float4 splatLane")
+    EU_CHECK_OP4(SIMD::zero4(), 0.0f, "Float4 zero4")
+#undef EU_CHECK_OP4
+
+    SIMD::storeAligned(out, SIMD::shuffle<1, 3, 0, 2>(va, vb));
+    const float shuffled[4] = { a[1], a[3], b[0], b[2] };
+    checkLanes(out, shuffled, 4, "Float4 shuffle");
+
+    SIMD::store(out, SIMD::set4(a[0], b[1], c[2], a[3]));
+    const float set[4] = { a[0], b[1], c[2], a[3] };
+    checkLanes(out, set, 4, "Float4 set4");
+
+    check(nearlyEqual(SIMD::getX(va), a[0]), "Float4 getX");
+    check(nearlyEqual(SIMD::hsum(va), (a[0] + a[1]) + (a[2] + a[3])), "Float4 hsum");
+    check(nearlyEqual(SIMD::dot4(va, vb), a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3]),
+          "Float4 dot4");
+
+    EU_ALIGN16 float rows[4][4];
+    for (int r = 0; r < 4; ++r) {
+      for (int i = 0; i < 4; ++i) {
+        rows[r][i] = nextValue(state);
+      }
+    }
+    SIMD::Float4 r0 = SIMD::load4(rows[0]), r1 = SIMD::load4(rows[1]);
+    SIMD::Float4 r2 = SIMD::load4(rows[2]), r3 = SIMD::load4(rows[3]);
+    SIMD::transpose4(r0, r1, r2, r3);
+    const SIMD::Float4 transposed[4] = { r0, r1, r2, r3 };
+    for (int r = 0; r < 4; ++r) {
+      SIMD::store(out, transposed[r]);
+      const float column[4] = { rows[0][r], rows[1][r], rows[2][r], rows[3][r] };
+      checkLanes(out, column, 4, "Float4 transpose4");
+    }
+  }
+
+  void
+  testFloat8(unsigned& state) {
+    EU_ALIGN32 float a[8], b[8], c[8], out[8], ref[8];
+    for (int i = 0; i < 8; ++i) {
+      a[i] = nextValue(state);
+      b[i] = nextValue(state);
+      c[i] = nextValue(state);
+    }
+    const SIMD::Float8 va = SIMD::load8(a), vb = SIMD::loadAligned8(b), vc = SIMD::load8(c);
+
+#define EU_CHECK_OP8(call, expr, name)                    \
+    SIMD::storeAligned(out, call);                        \
+    for (int i = 0; i < 8; ++i) { ref[i] = (expr); }      \
+    checkLanes(out, ref, 8, name);
+
+    EU_CHECK_OP8(SIMD::add(va, vb), a[i] + b[i], "Float8 add")
+    EU_CHECK_OP8(SIMD::sub(va, vb), a[i] - b[i], "Float8 sub")
+    EU_CHECK_OP8(SIMD::mul(va, vb), a[i] * b[i], "Float8 mul")
+    EU_CHECK_OP8(SIMD::div(va, vb), a[i] / b[i], "Float8 div")
+    EU_CHECK_OP8(SIMD::EMin(va, vb), a[i] < b[i] ? a[i] : b[i], "Float8 EMin")
+    EU_CHECK_OP8(SIMD::EMax(va, vb), a[i] > b[i] ? a[i] : b[i], "Float8 EMax")
+    EU_CHECK_OP8(SIMD::sqrt(SIMD::mul(va, va)), std::fabs(a[i]), "Float8 sqrt")
+    EU_CHECK_OP8(SIMD::madd(va, vb, vc), a[i] * b[i] + c[i], "Float8 madd")
+    EU_CHECK_OP8(SIMD::nmadd(va, vb, vc), c[i] - a[i] * b[i], "Float8 nmadd")
+    EU_CHECK_OP8(SIMD::splat8(c[5]), c[5], "Float8 splat8")
+    EU_CHECK_OP8(SIMD::zero8(), 0.0f, "Float8 zero8")
+    EU_CHECK_OP8(SIMD::select(SIMD::cmpLt(va, vb), va, vb), a[i] < b[i] ? a[i] : b[i],
+                 "Float8 cmpLt/select")
+#undef EU_CHECK_OP8
+
+    SIMD::store(out, SIMD::toFloat(SIMD::toIntRound(va)));
+    for (int i = 0; i < 8; ++i) {
+      ref[i] = std::nearbyint(a[i]);
+    }
+    // Halfway cases round differently (to even vs. away from zero); the
+    // inputs are random, so only check that the result is within one.
+    for (int i = 0; i < 8; ++i) {
+      check(std::fabs(out[i] - ref[i]) <= 1.0f, "Float8 toIntRound", i);
+    }
+  }
+
+  Matrix4x4
+  randomMatrix(unsigned& state) {
+    Matrix4x4 result;
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        result.m[r][c] = nextValue(state, 2.0f);
+      }
+    }
+    return result;
+  }
+
+  void
+  testMatrix(unsigned& state) {
+    const Matrix4x4 a = randomMatrix(state);
+    const Matrix4x4 b = randomMatrix(state);
+
+    const Matrix4x4 product = a * b;
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        float ref = 0.0f;
+        for (int k = 0; k < 4; ++k) {
+          ref += a.m[r][k] * b.m[k][c];
+        }
+        check(nearlyEqual(product.m[r][c], ref), "Matrix4x4 operator*", r * 4 + c);
+      }
+    }
+
+    const Matrix4x4 scaled = a * 3.0f;
+    const Matrix4x4 transposed = a.transpose();
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        check(nearlyEqual(scaled.m[r][c], a.m[r][c] * 3.0f), "Matrix4x4 operator*(float)", r * 4 + c);
+        check(transposed.m[r][c] == a.m[c][r], "Matrix4x4 transpose", r * 4 + c);
+      }
+    }
+
+    const Vector4 v(nextValue(state), nextValue(state), nextValue(state), nextValue(state));
+    const Vector4 tv = a.transform(v);
+    const float vIn[4] = { v.x, v.y, v.z, v.w };
+    const float vOut[4] = { tv.x, tv.y, tv.z, tv.w };
+    for (int c = 0; c < 4; ++c) {
+      const float ref = vIn[0] * a.m[0][c] + vIn[1] * a.m[1][c] + vIn[2] * a.m[2][c] + vIn[3] * a.m[3][c];
+      check(nearlyEqual(vOut[c], ref), "Matrix4x4 transform", c);
+    }
+
+    const Vector3 p(nextValue(state), nextValue(state), nextValue(state));
+    const Vector3 tp = a.transformPoint(p);
+    const Vector3 td = a.transformVector(p);
+    const float pOut[3] = { tp.x, tp.y, tp.z };
+    const float dOut[3] = { td.x, td.y, td.z };
+    for (int c = 0; c < 3; ++c) {
+      const float dir = p.x * a.m[0][c] + p.y * a.m[1][c] + p.z * a.m[2][c];
+      check(nearlyEqual(pOut[c], dir + a.m[3][c]), "Matrix4x4 transformPoint", c);
+      check(nearlyEqual(dOut[c], dir), "Matrix4x4 transformVector", c);
+    }
+
+    // The inverse is only as precise as the matrix is well conditioned: use
+    // a diagonally dominant one and a looser tolerance.
+    Matrix4x4 invertible = randomMatrix(state);
+    for (int i = 0; i < 4; ++i) {
+      invertible.m[i][i] += 10.0f;
+    }
+    const Matrix4x4 roundTrip = invertible * invertible.inverse();
+    for (int r = 0; r < 4; ++r) {
+      for (int c = 0; c < 4; ++c) {
+        check(nearlyEqual(roundTrip.m[r][c], r == c ? 1.0f : 0.0f, 1e-4f), "Matrix4x4 inverse", r * 4 + c);
+      }
+    }
+  }
+
+  // The constant-evaluated path must agree with the run-time one.
+  constexpr Matrix4x4 CONSTANT_PRODUCT =
+    Matrix4x4(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16) *
+    Matrix4x4(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 1, 1, 1, 1);
+}
+
+int
+main() {
+  unsigned state = 12345u;
+  for (int iteration = 0; iteration < 1000; ++iteration) {
+    testFloat4(state);
+    testFloat8(state);
+    testMatrix(state);
+  }
+
+  const Matrix4x4 a(1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16);
+  const Matrix4x4 runtimeProduct = a * Matrix4x4(2, 0, 0, 0, 0, 3, 0, 0, 0, 0, 4, 0, 1, 1, 1, 1);
+  for (int i = 0; i < 16; ++i) {
+    check(nearlyEqual(runtimeProduct.data()[i], CONSTANT_PRODUCT.data()[i]), "Matrix4x4 constexpr operator*", i);
+  }
+
+  std::printf("SIMD backend %s: %s\n", SIMD::backendName(), g_failures == 0 ? "ok" : "FAILED");
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,242 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file SharedPointerTest.cpp
+ * @brief Checks TSharedPointer / TWeakPointer lifetimes and the number of
+ *        heap allocations of each way of creating them, and prints the
+ *        spawn/walk timings of 100k actors.
+ *
+ * Built with EU_SHARED_POINTER_STATS so SharedPointerStats is live. Exits
+ * with a non-zero status on failure. Timings are only reported, never checked.
+ */
+#define EU_SHARED_POINTER_STATS
+#include "EngineUtilities/Memory/TWeakPointer.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+  int g_failures = 0;
+  int g_alive = 0;
+  bool g_failNextAllocation = false;
+
+  void
+  check(bool condition, const char* what, long long index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%lld]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  struct FakeActor {
+    float transform[16] = {};
+    float bounds[6] = {};
+    int id = 0;
+    explicit FakeActor(int inId) : id(inId) { ++g_alive; }
+    ~FakeActor() { --g_alive; }
+  };
+
+  struct PooledActor : FakeActor {
+    explicit PooledActor(int inId) : FakeActor(inId) {}
+  };
+
+  /**
+   * @brief Allocator for AllocateShared that counts its live blocks.
+   */
+  struct CountingAllocator {
+    int live = 0;
+
+    void* Allocate(size_t size, size_t) { ++live; return ::operator new(size); }
+    void Deallocate(void* ptr, size_t) { --live; ::operator delete(ptr); }
+  };
+}
+
+EU_POOL_ALLOCATED(PooledActor)
+
+// Lets a test make the next operator new throw.
+void*
+operator new(size_t size) {
+  if (g_failNextAllocation) {
+    g_failNextAllocation = false;
+    throw std::bad_alloc();
+  }
+  if (void* memory = std::malloc(size ? size : 1)) {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void
+operator delete(void* memory) noexcept {
+  std::free(memory);
+}
+
+void
+operator delete(void* memory, size_t) noexcept {
+  std::free(memory);
+}
+
+namespace {
+  // The object dies with the last strong reference; weak references keep
+  // only the control block alive and can no longer be locked.
+  template<typename MakeFn>
+  void
+  testLifetime(const char* what, MakeFn&& make) {
+    g_alive = 0;
+    {
+      EU::TWeakPointer<FakeActor> weak;
+      {
+        EU::TSharedPointer<FakeActor> first = make(7);
+        EU::TSharedPointer<FakeActor> second = first;
+        weak = second;
+        check(g_alive == 1 && first.useCount() == 2, what, 0);
+        check(weak.lock().get() == first.get() && weak.lock()->id == 7, what, 1);
+        first.reset();
+        check(g_alive == 1 && second.useCount() == 1 && !weak.expired(), what, 2);
+      }
+      check(g_alive == 0 && weak.expired() && weak.lock().isNull(), what, 3);
+    }
+    check(g_alive == 0, what, 4);
+  }
+
+  // If the control block cannot be allocated the object is deleted, not leaked.
+  void
+  testControlBlockFailure() {
+    FakeActor* raw = new FakeActor(2);
+    bool threw = false;
+    g_failNextAllocation = true;
+    try {
+      EU::TSharedPointer<FakeActor> actor(raw);
+    }
+    catch (const std::bad_alloc&) {
+      threw = true;
+    }
+    check(threw && g_alive == 0, "TSharedPointer(T*) deletes the object when the control block throws");
+  }
+
+  void
+  testAllocatorBlocks() {
+    CountingAllocator allocator;
+    {
+      EU::TSharedPointer<FakeActor> actor = EU::AllocateShared<FakeActor>(allocator, 3);
+      EU::TWeakPointer<FakeActor> weak = actor;
+      actor.reset();
+      check(g_alive == 0 && allocator.live == 1, "AllocateShared keeps the block for weak references");
+    }
+    check(allocator.live == 0, "AllocateShared returns the block");
+
+    const PooledActor* first = nullptr;
+    {
+      EU::TSharedPointer<PooledActor> actor = EU::MakeShared<PooledActor>(4);
+      check(actor->id == 4 && g_alive == 1, "pooled MakeShared");
+      first = actor.get();
+    }
+    check(g_alive == 0, "pooled MakeShared destroys the object");
+    EU::TSharedPointer<PooledActor> again = EU::MakeShared<PooledActor>(5);
+    check(again.get() == first, "pooled MakeShared reuses the returned block");
+  }
+
+  // Strong and weak copies from several threads must leave the counts exact.
+  void
+  testThreadedCounts() {
+    EU::TSharedPointer<FakeActor> shared = EU::MakeShared<FakeActor>(1);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.push_back(std::thread([&shared] {
+        for (int i = 0; i < 100000; ++i) {
+          EU::TSharedPointer<FakeActor> copy = shared;
+          EU::TWeakPointer<FakeActor> weak = copy;
+          EU::TSharedPointer<FakeActor> locked = weak.lock();
+          (void)locked;
+        }
+      }));
+    }
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+    check(shared.useCount() == 1 && g_alive == 1, "thread-safe reference counts");
+    shared.reset();
+    check(g_alive == 0, "thread-safe release");
+  }
+
+  // Heap blocks per actor: two with new T, one with MakeShared, none from the pool.
+  template<typename T, typename CreateFn>
+  void
+  spawn(const char* label, uint64_t expectedHeapAllocations, CreateFn&& create) {
+    const int COUNT = 100000;
+    std::vector<EU::TSharedPointer<T>> actors;
+    actors.reserve(COUNT);
+    EU::SharedPointerStats::reset();
+
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < COUNT; ++i) {
+      actors.push_back(create(i));
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+    long long sum = 0;
+    for (const EU::TSharedPointer<T>& actor : actors) {
+      sum += static_cast<long long>(actor->transform[0]) + actor->id;
+    }
+    const auto t2 = std::chrono::steady_clock::now();
+
+    const uint64_t heapAllocations = EU::SharedPointerStats::heapAllocations.load();
+    check(heapAllocations == expectedHeapAllocations * COUNT, label, static_cast<long long>(heapAllocations));
+    check(EU::SharedPointerStats::controlBlocks.load() == static_cast<uint64_t>(COUNT), label);
+    check(sum == static_cast<long long>(COUNT) * (COUNT - 1) / 2, label);
+
+    std::printf("%-31s heap allocations %7llu  spawn %6.2f ms  walk %5.2f ms\n", label,
+                static_cast<unsigned long long>(heapAllocations),
+                std::chrono::duration<double, std::milli>(t1 - t0).count(),
+                std::chrono::duration<double, std::milli>(t2 - t1).count());
+  }
+}
+
+int
+main() {
+  testLifetime("TSharedPointer(new T)",
+               [](int id) { return EU::TSharedPointer<FakeActor>(new FakeActor(id)); });
+  testLifetime("MakeShared", [](int id) { return EU::MakeShared<FakeActor>(id); });
+  testControlBlockFailure();
+  testAllocatorBlocks();
+  testThreadedCounts();
+
+  spawn<FakeActor>("TSharedPointer(new T)", 2,
+                   [](int i) { return EU::TSharedPointer<FakeActor>(new FakeActor(i)); });
+  spawn<FakeActor>("MakeShared", 1, [](int i) { return EU::MakeShared<FakeActor>(i); });
+  spawn<PooledActor>("MakeShared (EU_POOL_ALLOCATED)", 0,
+                     [](int i) { return EU::MakeShared<PooledActor>(i); });
+  check(g_alive == 0, "every actor destroyed");
+
+  std::printf("TSharedPointer: %s\n", g_failures == 0 ? "ok" : "FAILED");
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
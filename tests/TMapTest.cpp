@@ -0,0 +1,223 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file TMapTest.cpp
+ * @brief Checks TMap (and the THashTable under it) against
+ *        std::unordered_map and prints a timing table next to it.
+ *
+ * Exits with a non-zero status on failure. Timings are only reported, never
+ * checked.
+ */
+#include "EngineUtilities/Structures/TMap.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+  int g_failures = 0;
+
+  void
+  check(bool condition, const char* what, long long index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%lld]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  template<typename Fn>
+  double
+  millis(Fn&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  /**
+   * @brief Same contents: same size, and every pair of one is in the other.
+   */
+  template<typename K, typename V>
+  bool
+  sameContents(const EU::TMap<K, V>& map, const std::unordered_map<K, V>& reference) {
+    if (map.Num() != reference.size()) {
+      return false;
+    }
+    size_t visited = 0;
+    for (const auto& pair : map) {
+      auto it = reference.find(pair.Key);
+      if (it == reference.end() || it->second != pair.Value) {
+        return false;
+      }
+      ++visited;
+    }
+    return visited == reference.size();
+  }
+
+  // Random Add / Remove / FindOrAdd / Find mirrored on std::unordered_map.
+  void
+  testRandomOperations() {
+    EU::TMap<int, int> map;
+    std::unordered_map<int, int> reference;
+    std::mt19937 rng(1234);
+
+    for (int op = 0; op < 200000; ++op) {
+      const int key = static_cast<int>(rng() % 4096);
+      switch (rng() % 4) {
+      case 0:
+        map.Add(key, op);
+        reference[key] = op;
+        break;
+      case 1:
+        check(map.Remove(key) == (reference.erase(key) == 1), "Remove result", op);
+        break;
+      case 2:
+        ++map.FindOrAdd(key);
+        ++reference[key];
+        break;
+      default: {
+        const int* found = map.Find(key);
+        auto it = reference.find(key);
+        check((found != nullptr) == (it != reference.end()), "Find presence", op);
+        check(!found || *found == it->second, "Find value", op);
+        break;
+      }
+      }
+      if (op % 10000 == 0) {
+        check(sameContents(map, reference), "contents after random operations", op);
+      }
+    }
+    check(sameContents(map, reference), "final contents");
+
+    map.Empty();
+    check(map.IsEmpty() && map.begin() == map.end(), "Empty");
+  }
+
+  // String keys, lookups through const char* without a temporary std::string.
+  void
+  testStringKeys() {
+    EU::TMap<std::string, int> map;
+    map.Add("One", 1);
+    map.Add("Two", 2);
+    map["Three"] = 3;
+    check(map.Num() == 3, "string Num");
+    check(map.Find("One") && *map.Find("One") == 1, "Find(const char*)");
+    check(map.Contains(std::string("Three")), "Contains(std::string)");
+    check(map.Remove("Two") && !map.Contains("Two"), "Remove(const char*)");
+    check(!map.Remove("Two"), "Remove missing");
+    map.Add("One", 10);
+    check(map.Num() == 2 && map["One"] == 10, "Add overwrites");
+  }
+
+  // Emplace and FindOrAdd build the value from the key alone.
+  void
+  testEmplace() {
+    EU::TMap<int, std::vector<int>> map;
+    map.Emplace(5).push_back(1);
+    map.Emplace(5, 3, 7);  // Already present: left as is.
+    check(map.Find(5) && map.Find(5)->size() == 1, "Emplace keeps the existing value");
+    map.Emplace(6, 3, 7);
+    check(map.Find(6) && map.Find(6)->size() == 3 && (*map.Find(6))[2] == 7, "Emplace with arguments");
+    check(map.FindOrAdd(8).empty() && map.Num() == 3, "FindOrAdd default value");
+  }
+
+  // Erasing leaves tombstones; a steady insert/erase churn has to reuse them
+  // instead of growing the table forever.
+  void
+  testChurnKeepsCapacity() {
+    EU::TMap<int, int> map;
+    const int LIVE = 1000;
+    for (int i = 0; i < LIVE; ++i) {
+      map.Add(i, i);
+    }
+    const size_t capacity = map.GetCapacity();
+    for (int i = LIVE; i < 1000000; ++i) {
+      map.Remove(i - LIVE);
+      map.Add(i, i);
+    }
+    check(map.Num() == LIVE, "churn Num");
+    check(map.GetCapacity() <= 2 * capacity, "churn capacity", static_cast<long long>(map.GetCapacity()));
+    for (int i = 1000000 - LIVE; i < 1000000; ++i) {
+      check(map.Find(i) && *map.Find(i) == i, "churn Find", i);
+    }
+  }
+
+  void
+  benchmark() {
+    const int N = 50000;
+    std::vector<std::string> names(N);
+    for (int i = 0; i < N; ++i) {
+      names[i] = "Asset_" + std::to_string(i * 7919);
+    }
+
+    EU::TMap<std::string, int> map;
+    std::unordered_map<std::string, int> reference;
+    long long sumEU = 0, sumStd = 0;
+    size_t missEU = 0, missStd = 0;
+
+    const double insertEU = millis([&] { for (int i = 0; i < N; ++i) map.Add(names[i], i); });
+    const double insertStd = millis([&] { for (int i = 0; i < N; ++i) reference[names[i]] = i; });
+    const double findEU = millis([&] {
+      for (int r = 0; r < 20; ++r) for (int i = 0; i < N; ++i) sumEU += *map.Find(names[i]);
+    });
+    const double findStd = millis([&] {
+      for (int r = 0; r < 20; ++r) for (int i = 0; i < N; ++i) sumStd += reference.find(names[i])->second;
+    });
+    const double absentEU = millis([&] {
+      for (int i = 0; i < N; ++i) missEU += map.Contains("missing_" + std::to_string(i));
+    });
+    const double absentStd = millis([&] {
+      for (int i = 0; i < N; ++i) missStd += reference.count("missing_" + std::to_string(i));
+    });
+
+    check(map.Num() == static_cast<size_t>(N), "benchmark Num");
+    check(sumEU == sumStd, "benchmark lookups");
+    check(missEU == 0 && missStd == 0, "benchmark misses");
+
+    std::printf("%d keys       TMap     unordered_map\n", N);
+    std::printf("insert      %7.2f ms  %7.2f ms\n", insertEU, insertStd);
+    std::printf("find x20    %7.2f ms  %7.2f ms\n", findEU, findStd);
+    std::printf("miss        %7.2f ms  %7.2f ms\n", absentEU, absentStd);
+  }
+}
+
+int
+main() {
+  testRandomOperations();
+  testStringKeys();
+  testEmplace();
+  testChurnKeepsCapacity();
+  benchmark();
+
+  std::printf("TMap: %s\n", g_failures == 0 ? "ok" : "FAILED");
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,195 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file TSetTest.cpp
+ * @brief Checks TSet and its set algebra against std::unordered_set and
+ *        prints a timing table next to it.
+ *
+ * Exits with a non-zero status on failure. Timings are only reported, never
+ * checked.
+ */
+#include "EngineUtilities/Structures/TSet.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace {
+  int g_failures = 0;
+
+  void
+  check(bool condition, const char* what, long long index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%lld]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  template<typename Fn>
+  double
+  millis(Fn&& body) {
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  template<typename T>
+  bool
+  sameContents(const EU::TSet<T>& set, const std::unordered_set<T>& reference) {
+    if (set.Num() != reference.size()) {
+      return false;
+    }
+    size_t visited = 0;
+    for (const T& element : set) {
+      if (!reference.count(element)) {
+        return false;
+      }
+      ++visited;
+    }
+    return visited == reference.size();
+  }
+
+  // Random Add / Remove / Contains mirrored on std::unordered_set.
+  void
+  testRandomOperations() {
+    EU::TSet<unsigned> set;
+    std::unordered_set<unsigned> reference;
+    std::mt19937 rng(99);
+
+    for (int op = 0; op < 200000; ++op) {
+      const unsigned key = rng() % 4096;
+      switch (rng() % 3) {
+      case 0:
+        check(set.Add(key) == reference.insert(key).second, "Add result", op);
+        break;
+      case 1:
+        check(set.Remove(key) == (reference.erase(key) == 1), "Remove result", op);
+        break;
+      default:
+        check(set.Contains(key) == (reference.count(key) == 1), "Contains", op);
+        break;
+      }
+      if (op % 10000 == 0) {
+        check(sameContents(set, reference), "contents after random operations", op);
+      }
+    }
+    check(sameContents(set, reference), "final contents");
+  }
+
+  void
+  testSetAlgebra() {
+    std::mt19937 rng(7);
+    EU::TSet<unsigned> a, b;
+    std::unordered_set<unsigned> refA, refB;
+    for (int i = 0; i < 20000; ++i) {
+      const unsigned x = rng() % 30000;
+      const unsigned y = rng() % 30000;
+      a.Add(x);
+      refA.insert(x);
+      b.Add(y);
+      refB.insert(y);
+    }
+
+    std::unordered_set<unsigned> refUnion = refA, refIntersect, refDifference;
+    refUnion.insert(refB.begin(), refB.end());
+    for (unsigned x : refA) {
+      (refB.count(x) ? refIntersect : refDifference).insert(x);
+    }
+
+    check(sameContents(a.Union(b), refUnion), "Union");
+    check(sameContents(b.Union(a), refUnion), "Union (other order)");
+    check(sameContents(a.Intersect(b), refIntersect), "Intersect");
+    check(sameContents(b.Intersect(a), refIntersect), "Intersect (other order)");
+    check(sameContents(a.Difference(b), refDifference), "Difference");
+    check(a.Includes(a.Intersect(b)) && !a.Intersect(b).Includes(a), "Includes");
+
+    EU::TSet<unsigned> appended = a;
+    appended.Append(b);
+    check(sameContents(appended, refUnion), "Append(TSet)");
+
+    EU::TSet<std::string> names = { "Mesh", "Texture", "Shader" };
+    check(names.Contains("Mesh") && !names.Contains("Sound"), "Contains(const char*)");
+    check(names.Find("Texture") && *names.Find("Texture") == "Texture", "Find(const char*)");
+    check(names.Remove("Shader") && names.Num() == 2, "Remove(const char*)");
+  }
+
+  void
+  benchmark() {
+    const size_t N = 1000000;
+    std::vector<unsigned> keys(N), probe(N);
+    std::mt19937 rng(42);
+    for (size_t i = 0; i < N; ++i) {
+      keys[i] = rng();
+      probe[i] = (i & 1) ? keys[i] : rng();  // Half of the lookups miss.
+    }
+    std::shuffle(probe.begin(), probe.end(), rng);
+
+    EU::TSet<unsigned> a, b;
+    std::unordered_set<unsigned> reference;
+    size_t hitsEU = 0, hitsStd = 0;
+    size_t unionNum = 0, intersectNum = 0, differenceNum = 0;
+
+    const double addEU = millis([&] { for (unsigned k : keys) a.Add(k); });
+    const double addStd = millis([&] { for (unsigned k : keys) reference.insert(k); });
+    const double appendEU = millis([&] { b.Append(probe.data(), N); });
+    const double findEU = millis([&] { for (unsigned k : probe) hitsEU += a.Contains(k); });
+    const double findStd = millis([&] { for (unsigned k : probe) hitsStd += reference.count(k); });
+    const double unionEU = millis([&] { unionNum = a.Union(b).Num(); });
+    const double intersectEU = millis([&] { intersectNum = a.Intersect(b).Num(); });
+    const double differenceEU = millis([&] { differenceNum = a.Difference(b).Num(); });
+
+    check(a.Num() == reference.size(), "benchmark Num");
+    check(hitsEU == hitsStd, "benchmark Contains");
+    check(unionNum + intersectNum == a.Num() + b.Num(), "benchmark |A u B| + |A n B| = |A| + |B|");
+    check(differenceNum + intersectNum == a.Num(), "benchmark |A - B| + |A n B| = |A|");
+
+    std::printf("%zu elements     TSet     unordered_set\n", N);
+    std::printf("add          %7.2f ms  %7.2f ms\n", addEU, addStd);
+    std::printf("contains     %7.2f ms  %7.2f ms\n", findEU, findStd);
+    std::printf("append       %7.2f ms\n", appendEU);
+    std::printf("union        %7.2f ms\n", unionEU);
+    std::printf("intersect    %7.2f ms\n", intersectEU);
+    std::printf("difference   %7.2f ms\n", differenceEU);
+  }
+}
+
+int
+main() {
+  testRandomOperations();
+  testSetAlgebra();
+  benchmark();
+
+  std::printf("TSet: %s\n", g_failures == 0 ? "ok" : "FAILED");
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
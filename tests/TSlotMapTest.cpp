@@ -0,0 +1,140 @@
+﻿/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Roberto Charreton
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * In addition, any project or software that uses this library or class must include
+ * the following acknowledgment in the credits:
+ *
+ * "This project uses software developed by Roberto Charreton and Attribute Overload."
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+*/
+/**
+ * @file TSlotMapTest.cpp
+ * @brief Checks TSlotMap handles: stale-handle detection, dense storage,
+ *        slot retirement when a generation would wrap and the out-of-slots
+ *        failure.
+ *
+ * Exits with a non-zero status on failure.
+ */
+#include "EngineUtilities/Structures/TSlotMap.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+  int g_failures = 0;
+
+  void
+  check(bool condition, const char* what, long long index = -1) {
+    if (!condition) {
+      std::printf("FAILED: %s [%lld]\n", what, index);
+      ++g_failures;
+    }
+  }
+
+  void
+  testHandles() {
+    EU::TSlotMap<std::string> names;
+    auto plane = names.Insert("Plane");
+    auto gun = names.Emplace("Gun");
+    auto tree = names.Insert(std::string("Tree"));
+    check(names.Num() == 3 && names[gun] == "Gun", "Insert/Emplace");
+
+    check(names.Remove(plane) && !names.Remove(plane), "Remove once");
+    check(!names.Contains(plane) && names.Get(plane) == nullptr, "stale handle");
+    check(names[tree] == "Tree" && names[gun] == "Gun", "handles survive other removals");
+
+    auto rock = names.Insert("Rock");
+    check(rock != plane && !names.Contains(plane), "reused slot gets a new generation");
+
+    std::string joined;
+    for (const std::string& name : names) {
+      joined += name;
+    }
+    check(joined.size() == std::string("GunTreeRock").size(), "dense iteration");
+
+    names.Empty();
+    check(names.IsEmpty() && !names.Contains(gun) && !names.Contains(rock), "Empty invalidates handles");
+  }
+
+  // With 32-bit handles a slot has 4095 generations. Once they are used up
+  // the slot is retired instead of handing out a generation seen before.
+  void
+  testGenerationRetirement() {
+    typedef EU::TSlotMap<int> Map;
+    Map map;
+    const uint32_t generations = static_cast<uint32_t>(Map::Handle::GENERATION_MASK);
+    std::vector<Map::Handle> seen;
+    for (uint32_t i = 0; i < generations; ++i) {
+      Map::Handle handle = map.Insert(static_cast<int>(i));
+      check(handle.GetIndex() == 0, "single slot reused", i);
+      seen.push_back(handle);
+      map.Remove(handle);
+    }
+    check(map.GetNumRetired() == 1, "slot retired after its last generation");
+
+    Map::Handle next = map.Insert(7);
+    check(next.GetIndex() == 1, "retired slot is not reused", next.GetIndex());
+    for (size_t i = 0; i < seen.size(); ++i) {
+      check(!map.Contains(seen[i]), "old handle never valid again", static_cast<long long>(i));
+    }
+    check(!map.Contains(Map::Handle(0, 0)), "retired slot matches no handle");
+  }
+
+  // 20-bit indices: the 2^20 - 1 slots can be filled, the next insert fails
+  // in every build and leaves the map untouched.
+  void
+  testOutOfSlots() {
+    typedef EU::TSlotMap<int> Map;
+    Map map;
+    const size_t slots = static_cast<size_t>(Map::Handle::INDEX_MASK);
+    map.Reserve(slots);
+    for (size_t i = 0; i < slots; ++i) {
+      map.Insert(static_cast<int>(i));
+    }
+
+    bool threw = false;
+    try {
+      map.Insert(-1);
+    }
+    catch (const std::length_error&) {
+      threw = true;
+    }
+    check(threw, "Insert past the last index throws");
+    check(map.Num() == slots, "failed Insert leaves the map unchanged");
+
+    map.Remove(map.GetHandleAt(0));
+    check(map.Insert(-2).IsSet() && map.Num() == slots, "a freed slot can be used again");
+  }
+}
+
+int
+main() {
+  testHandles();
+  testGenerationRetirement();
+  testOutOfSlots();
+
+  std::printf("TSlotMap: %s\n", g_failures == 0 ? "ok" : "FAILED");
+  return g_failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}